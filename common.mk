@@ -90,23 +90,38 @@ EV_SRC :=                           \
 									./src/ev/hub/keep_alive_handler.cc                                            \
 									./src/ev/hub/one_shot_handler.cc                                              \
 									./src/ev/object.cc                                                            \
+									./src/ev/postgresql/cache.cc                                                  \
+									./src/ev/postgresql/copy_request.cc                                           \
+									./src/ev/postgresql/cursor_request.cc                                         \
 									./src/ev/postgresql/device.cc                                                 \
 									./src/ev/postgresql/error.cc                                                  \
 									./src/ev/postgresql/json_api.cc                                               \
+									./src/ev/postgresql/notification.cc                                           \
 									./src/ev/postgresql/object.cc                                                 \
+									./src/ev/postgresql/replicas.cc                                               \
 									./src/ev/postgresql/reply.cc                                                  \
 									./src/ev/postgresql/request.cc                                                \
+									./src/ev/postgresql/stream_request.cc                                         \
+									./src/ev/postgresql/subscriptions/manager.cc                                  \
+									./src/ev/postgresql/subscriptions/request.cc                                  \
+									./src/ev/postgresql/transaction_request.cc                                    \
 									./src/ev/postgresql/value.cc                                                  \
+									./src/ev/redis/cluster.cc                                                     \
 									./src/ev/redis/device.cc                                                      \
 									./src/ev/redis/error.cc                                                       \
 									./src/ev/redis/object.cc                                                      \
 									./src/ev/redis/reply.cc                                                       \
+									./src/ev/redis/reply_handle.cc                                                \
 									./src/ev/redis/request.cc                                                     \
+									./src/ev/redis/script.cc                                                      \
+									./src/ev/redis/sentinel.cc                                                    \
 									./src/ev/redis/subscriptions/manager.cc                                       \
 									./src/ev/redis/subscriptions/reply.cc                                         \
 									./src/ev/redis/subscriptions/request.cc                                       \
 									./src/ev/redis/value.cc                                                       \
 									./src/ev/redis/session.cc                                                     \
+									./src/ev/redis/session_cache.cc                                               \
+									./src/ev/redis/tracking_cache.cc                                              \
 									./src/ev/curl/device.cc                                                       \
 									./src/ev/curl/error.cc                                                        \
 									./src/ev/curl/http.cc                                                         \
@@ -39,6 +39,11 @@ ev::Device::Device (const ::ev::Loggable::Data& a_loggable_data)
     max_reuse_count_   = -1;
     tracked_           = true;
     invalidate_reuse_  = false;
+    created_tp_        = std::chrono::steady_clock::now();
+    last_used_tp_      = created_tp_;
+    probed_tp_         = created_tp_;
+    max_age_ms_        = -1;
+    max_idle_ms_       = -1;
 }
 
 /**
@@ -62,3 +67,35 @@ void ev::Device::Setup (struct event_base* a_event, ev::Device::ExceptionCallbac
     event_base_ptr_     = a_event;
     exception_callback_ = a_exception_callback;
 }
+
+/**
+ * @brief Probe this device connection.
+ *
+ * @param a_callback Function to call when the probe reply is received.
+ *
+ * @return One of \link ev::Device::Status \link, by default probes are not supported and \link ev::Device::Status::Nop \link is returned.
+ */
+ev::Device::Status ev::Device::Ping (ev::Device::ExecuteCallback /* a_callback */)
+{
+    return ev::Device::Status::Nop;
+}
+
+/**
+ * @brief Check how well suited this device is to execute a request.
+ *
+ * @param a_request
+ *
+ * @return One of \link ev::Device::Affinity \link, by default any device can execute any request of it's target.
+ */
+ev::Device::Affinity ev::Device::AffinityFor (const ev::Request* /* a_request */) const
+{
+    return ev::Device::Affinity::Preferred;
+}
+
+/**
+ * @return Maximum number of requests this device can execute at the same time, right now, by default only one.
+ */
+size_t ev::Device::PipelineDepth () const
+{
+    return 1;
+}
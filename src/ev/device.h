@@ -34,6 +34,8 @@
 #include <string>     // std::string
 #include <vector>     // std::vector
 #include <limits>     // std::numeric_limits
+#include <chrono>     // std::chrono::steady_clock
+#include <algorithm>  // std::max
 
 #include <event.h> // libevent
 
@@ -69,6 +71,14 @@ namespace ev
             Error
         };
         
+        enum class Affinity : uint8_t
+        {
+            None,      //!< Device can't execute request.
+            Fallback,  //!< Device can execute request, but a new device would be better suited.
+            Preferred, //!< Device is suited to execute request.
+            Matched    //!< Device is suited to execute request and it's session is already configured for it.
+        };
+        
         class Listener
         {
             
@@ -120,6 +130,21 @@ namespace ev
              * @return True when the object ownership is accepted, otherwise it will be relased the this function caller.
              */
             virtual bool OnUnhandledDataObjectReceived (const ev::Device* a_device, const ev::Request* a_request, ev::Result* a_result) = 0;
+            
+        public: // Virtual Method(s) / Function(s)
+            
+            /**
+             * @brief Flow control for devices that deliver partial results.
+             *
+             * @param a_device
+             * @param a_request
+             *
+             * @return Number of data objects accepted by \link OnUnhandledDataObjectReceived \link that were not yet consumed.
+             */
+            virtual size_t PendingDataObjectsCount (const ev::Device* /* a_device */, const ev::Request* /* a_request */)
+            {
+                return 0;
+            }
 
         };
         
@@ -150,6 +175,14 @@ namespace ev
         bool                   tracked_;
         bool                   invalidate_reuse_;
 
+    protected: // Lifetime Related
+
+        std::chrono::steady_clock::time_point created_tp_;   //!< When this device was created.
+        std::chrono::steady_clock::time_point last_used_tp_; //!< When this device was last used.
+        std::chrono::steady_clock::time_point probed_tp_;    //!< When this device was last probed, a probe is not a usage.
+        int64_t                               max_age_ms_;   //!< Maximum lifetime in milliseconds, -1 if no limit is set.
+        int64_t                               max_idle_ms_;  //!< Maximum idle time in milliseconds, -1 if no limit is set.
+
     public: // Constructor(s) / Destructor
         
         Device (const Loggable::Data& a_loggable_data);
@@ -157,7 +190,10 @@ namespace ev
         
     public: // Virtual Method(s) / Function(s)
         
-        virtual void Setup (struct event_base* a_event, ExceptionCallback a_exception_callback);
+        virtual void     Setup         (struct event_base* a_event, ExceptionCallback a_exception_callback);
+        virtual Status   Ping          (ExecuteCallback a_callback);
+        virtual Affinity AffinityFor   (const ev::Request* a_request) const;
+        virtual size_t   PipelineDepth () const;
 
     public: // Pure Virtual Method(s) / Function(s)
         
@@ -178,6 +214,18 @@ namespace ev
         bool    Tracked            () const;
         void    SetUntracked       ();
         
+        const Loggable::Data& LoggableData () const;
+
+    public: // Lifetime Related
+
+        void    SetLifetime (const int64_t a_max_age_ms, const int64_t a_max_idle_ms);
+        void    Touch       ();
+        void    Probed      ();
+        bool    Aged        (const std::chrono::steady_clock::time_point& a_tp) const;
+        bool    Idled       (const std::chrono::steady_clock::time_point& a_tp) const;
+        int64_t IdleTime    (const std::chrono::steady_clock::time_point& a_tp) const;
+        int64_t SinceProbe  (const std::chrono::steady_clock::time_point& a_tp) const;
+
     }; // end of class 'Device'
     
     /**
@@ -258,6 +306,86 @@ namespace ev
         tracked_ = false;
     }
     
+    /**
+     * @return R/O access to this device loggable data.
+     */
+    inline const Loggable::Data& Device::LoggableData () const
+    {
+        return loggable_data_;
+    }
+    
+    /**
+     * @brief Set this device lifetime limits.
+     *
+     * @param a_max_age_ms  Maximum lifetime in milliseconds, -1 if no limit is set.
+     * @param a_max_idle_ms Maximum idle time in milliseconds, -1 if no limit is set.
+     */
+    inline void Device::SetLifetime (const int64_t a_max_age_ms, const int64_t a_max_idle_ms)
+    {
+        max_age_ms_  = a_max_age_ms;
+        max_idle_ms_ = a_max_idle_ms;
+    }
+    
+    /**
+     * @brief Update last usage time point.
+     */
+    inline void Device::Touch ()
+    {
+        last_used_tp_ = std::chrono::steady_clock::now();
+    }
+    
+    /**
+     * @brief Update last probe time point, idle time is not affected.
+     */
+    inline void Device::Probed ()
+    {
+        probed_tp_ = std::chrono::steady_clock::now();
+    }
+    
+    /**
+     * @brief Check if this device exceeded it's maximum lifetime.
+     *
+     * @param a_tp Reference time point.
+     *
+     * @return True if so, false otherwise.
+     */
+    inline bool Device::Aged (const std::chrono::steady_clock::time_point& a_tp) const
+    {
+        return ( max_age_ms_ > 0 && std::chrono::duration_cast<std::chrono::milliseconds>(a_tp - created_tp_).count() >= max_age_ms_ );
+    }
+    
+    /**
+     * @brief Check if this device exceeded it's maximum idle time.
+     *
+     * @param a_tp Reference time point.
+     *
+     * @return True if so, false otherwise.
+     */
+    inline bool Device::Idled (const std::chrono::steady_clock::time_point& a_tp) const
+    {
+        return ( max_idle_ms_ > 0 && IdleTime(a_tp) >= max_idle_ms_ );
+    }
+    
+    /**
+     * @return For how long, in milliseconds, this device wasn't used.
+     *
+     * @param a_tp Reference time point.
+     */
+    inline int64_t Device::IdleTime (const std::chrono::steady_clock::time_point& a_tp) const
+    {
+        return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(a_tp - last_used_tp_).count());
+    }
+    
+    /**
+     * @return For how long, in milliseconds, this device wasn't used or probed.
+     *
+     * @param a_tp Reference time point.
+     */
+    inline int64_t Device::SinceProbe (const std::chrono::steady_clock::time_point& a_tp) const
+    {
+        return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(a_tp - std::max(last_used_tp_, probed_tp_)).count());
+    }
+    
 } // end of namespace 'ev'
 
 #endif // NRS_EV_DEVICE_H_
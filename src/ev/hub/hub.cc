@@ -203,13 +203,18 @@ ev::hub::Hub::~Hub ()
  * @param a_disconnected_step_callback
  * @param a_device_step_factory
  * @param a_device_limits_step_callback
+ * @param a_device_lease_step_callback   Optional, called before a new device is created, to lease a slot from a global budget.
+ * @param a_device_release_step_callback Optional, called when a device is released, to return it's slot to a global budget.
+ * @param a_device_lifetime_step_callback Optional, called after a new device is created, to obtain it's lifetime limits.
  */
 void ev::hub::Hub::Start (ev::hub::Hub::InitializedCallback a_initialized_callback,
                           ev::hub::NextStepCallback a_next_step_callback,
                           ev::hub::PublishStepCallback a_publish_step_callback,
                           ev::hub::DisconnectedStepCallback a_disconnected_step_callback,
                           ev::hub::DeviceFactoryStepCallback a_device_step_factory,
-                          ev::hub::DeviceLimitsStepCallback a_device_limits_step_callback)
+                          ev::hub::DeviceLimitsStepCallback a_device_limits_step_callback,
+                          ev::hub::DeviceLeaseStepCallback a_device_lease_step_callback, ev::hub::DeviceReleaseStepCallback a_device_release_step_callback,
+                          ev::hub::DeviceLifetimeStepCallback a_device_lifetime_step_callback)
 {
     initialized_callback_ = a_initialized_callback;
     if ( nullptr == initialized_callback_ ) {
@@ -237,11 +242,19 @@ void ev::hub::Hub::Start (ev::hub::Hub::InitializedCallback a_initialized_callba
                             "a_device_factory");
     }
     
+    if ( ( nullptr == a_device_lease_step_callback ) != ( nullptr == a_device_release_step_callback ) ) {
+        throw ev::Exception("Unable to start hub loop: arguments '%s' and '%s' must be both set or both unset!",
+                            "a_device_lease_step_callback", "a_device_release_step_callback");
+    }
+    
     stepper_.next_         = new ev::hub::Hub::NextCallback(bridge_, a_next_step_callback);
     stepper_.publish_      = new ev::hub::Hub::PublishCallback(bridge_, a_publish_step_callback);
     stepper_.disconnected_ = new ev::hub::Hub::DisconnectedCallback(bridge_, a_disconnected_step_callback);
     stepper_.factory_      = std::move(a_device_step_factory);
     stepper_.limits_       = std::move(a_device_limits_step_callback);
+    stepper_.lease_        = std::move(a_device_lease_step_callback);
+    stepper_.release_      = std::move(a_device_release_step_callback);
+    stepper_.lifetime_     = std::move(a_device_lifetime_step_callback);
 
     try {
         
@@ -389,8 +402,11 @@ void ev::hub::Hub::Stop (int a_sig_no)
         stepper_.disconnected_ = nullptr;
     }
     
-    stepper_.setup_   = nullptr;
-    stepper_.factory_ = nullptr;
+    stepper_.setup_    = nullptr;
+    stepper_.factory_  = nullptr;
+    stepper_.lease_    = nullptr;
+    stepper_.release_  = nullptr;
+    stepper_.lifetime_ = nullptr;
     
     OSALITE_DEBUG_TRACE("ev_hub", "<~ Stop()...");
 }
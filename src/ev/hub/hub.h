@@ -188,7 +188,9 @@ namespace ev
             virtual void Start (InitializedCallback a_initialized_callback,
                                 NextStepCallback a_next_step_callback, PublishStepCallback a_publish_step_callback, DisconnectedStepCallback a_disconnected_step_callback,
                                 DeviceFactoryStepCallback a_device_factory,
-                                DeviceLimitsStepCallback a_device_limits_step_callback);
+                                DeviceLimitsStepCallback a_device_limits_step_callback,
+                                DeviceLeaseStepCallback a_device_lease_step_callback = nullptr, DeviceReleaseStepCallback a_device_release_step_callback = nullptr,
+                                DeviceLifetimeStepCallback a_device_lifetime_step_callback = nullptr);
             virtual void Stop  (int a_sig_no);
             
         protected:
@@ -32,7 +32,7 @@ ev::hub::KeepAliveHandler::KeepAliveHandler (ev::hub::StepperCallbacks& a_steppe
     : ev::hub::Handler(a_stepper_callbacks, a_thread_id)
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
-    supported_target_ = { ev::Object::Target::Redis };
+    supported_target_ = { ev::Object::Target::Redis, ev::Object::Target::PostgreSQL };
 }
 
 /**
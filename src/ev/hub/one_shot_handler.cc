@@ -26,6 +26,16 @@
 
 #include "osal/osalite.h"
 
+const int64_t ev::hub::OneShotHandler::k_probe_idle_ms_    = 30000;
+const int64_t ev::hub::OneShotHandler::k_probe_timeout_ms_ = 5000;
+
+const double  ev::hub::OneShotHandler::k_limit_decrease_factor_   = 0.5;
+const double  ev::hub::OneShotHandler::k_limit_latency_tolerance_ = 2.0;
+
+const int64_t ev::hub::OneShotHandler::k_pin_timeout_ms_ = 30000;
+
+const int64_t ev::hub::OneShotHandler::k_lease_idle_ms_ = 60000;
+
 /**
  * @brief Default constructor.
  *
@@ -46,6 +56,29 @@ ev::hub::OneShotHandler::OneShotHandler (ev::hub::StepperCallbacks& a_stepper_ca
             devices_limits_[target] = a_stepper_callbacks.limits_(target);
         }
     }
+    for ( auto target : supported_target_ ) {
+        // ... configured limit is the upper bound, start from there ...
+        size_t max_limit = 2;
+        const auto limits_it = devices_limits_.find(target);
+        if ( devices_limits_.end() != limits_it ) {
+            max_limit = std::max(limits_it->second, static_cast<size_t>(1));
+        }
+        limiters_[target] = {
+            /* limit_          */ static_cast<double>(max_limit),
+            /* baseline_       */ -1.0,
+            /* latency_        */ -1.0,
+            /* since_decrease_ */ 0
+        };
+        stats_[target] = {
+            /* probes_         */ 0,
+            /* failed_probes_  */ 0,
+            /* evicted_        */ 0,
+            /* limit_          */ max_limit,
+            /* max_limit_      */ max_limit,
+            /* latency_        */ 0.0,
+            /* errors_         */ 0
+        };
+    }
 }
 
 /**
@@ -56,6 +89,29 @@ ev::hub::OneShotHandler::~OneShotHandler ()
     OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     // ... get rid of 'zombies' objects ...
     KillZombies();
+    
+    // ... release replacement devices that are still connecting ...
+    for ( auto it : recycling_devices_ ) {
+        ReleaseSlot(it.first);
+        delete it.first;
+    }
+    recycling_devices_.clear();
+    
+    // ... release devices that are being probed ...
+    for ( auto it : probing_devices_ ) {
+        ReleaseSlot(it.first);
+        delete it.first;
+    }
+    probing_devices_.clear();
+    
+    // ... release pinned devices that are not in use, server will rollback their transactions ...
+    for ( auto it : pins_ ) {
+        if ( false == it.second.busy_ ) {
+            ReleaseSlot(it.second.device_);
+            delete it.second.device_;
+        }
+    }
+    pins_.clear();
 
     // ... release devices ...
     for ( auto map : { &cached_devices_, &in_use_devices_ } ) {
@@ -65,6 +121,7 @@ ev::hub::OneShotHandler::~OneShotHandler ()
                 continue;
             }
             while ( it->second->size() > 0 ) {
+                ReleaseSlot((*it->second)[0]);
                 delete (*it->second)[0];
                 it->second->erase(it->second->begin());
             }
@@ -76,6 +133,8 @@ ev::hub::OneShotHandler::~OneShotHandler ()
     // ... just ptrs ...
     device_request_map_.clear();
     request_device_map_.clear();
+    leases_.clear();
+    streams_.clear();
 }
 
 #ifdef __APPLE__
@@ -88,6 +147,12 @@ ev::hub::OneShotHandler::~OneShotHandler ()
 void ev::hub::OneShotHandler::Idle ()
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... replace aged or idle devices in background ...
+    RecycleDevices();
+    // ... check devices health ...
+    ProbeDevices();
+    // ... release devices pinned to requesters that stopped issuing requests ...
+    ExpirePins();
     // ... push next ...
     Push();
     // ... publish pending ...
@@ -235,6 +300,44 @@ void ev::hub::OneShotHandler::OnConnectionStatusChanged (const ev::Device::Conne
     // ... connection error or device disconnected ....
     //
     
+    // ... already a 'zombie'?
+    if ( zombies_.end() != zombies_.find(a_device) ) {
+        // ... nothing to do here ...
+        return;
+    }
+    
+    // ... a replacement device that failed to connect?
+    const auto recycling_it = recycling_devices_.find(a_device);
+    if ( recycling_devices_.end() != recycling_it ) {
+        // ... forget it, aged device will be kept until next attempt ...
+        recycling_devices_.erase(recycling_it);
+        zombies_.insert(a_device);
+        return;
+    }
+    
+    // ... a device that was being probed?
+    const auto probing_it = probing_devices_.find(a_device);
+    if ( probing_devices_.end() != probing_it ) {
+        // ... probe failed ...
+        stats_[probing_it->second.target_].failed_probes_++;
+        stats_[probing_it->second.target_].evicted_++;
+        probing_devices_.erase(probing_it);
+        zombies_.insert(a_device);
+        return;
+    }
+    
+    // ... a pinned device?
+    const auto pin_it = FindPin(a_device);
+    if ( pins_.end() != pin_it ) {
+        const bool busy = pin_it->second.busy_;
+        pins_.erase(pin_it);
+        if ( false == busy ) {
+            // ... not in use, it's not tracked by control maps ...
+            zombies_.insert(a_device);
+            return;
+        }
+    }
+    
     // ... sanity check required ...
     SanityCheck();
    
@@ -267,9 +370,13 @@ void ev::hub::OneShotHandler::OnConnectionStatusChanged (const ev::Device::Conne
     // ... promote devie to a 'zombie'
     zombies_.insert(a_device);
     
-    // ... search for associated request ...
-    const auto r_it = device_request_map_.find(a_device);
-    if ( device_request_map_.end() != r_it ) {
+    // ... search for associated request(s), more than one if pipelined ...
+    std::vector<ev::Request*> requests;
+    const auto range = device_request_map_.equal_range(a_device);
+    for ( auto r_it = range.first ; range.second != r_it ; ++r_it ) {
+        requests.push_back(r_it->second);
+    }
+    for ( auto request : requests ) {
         
         typedef struct {
             const int64_t            invoke_id_;
@@ -278,10 +385,13 @@ void ev::hub::OneShotHandler::OnConnectionStatusChanged (const ev::Device::Conne
         } Payload;
         
         // ... prepare callback payload ...
-        Payload* payload = new Payload({r_it->second->GetInvokeID(), r_it->second->target_, r_it->second->GetTag()});
+        Payload* payload = new Payload({request->GetInvokeID(), request->target_, request->GetTag()});
+        
+        // ... feed adaptive limiter ...
+        AdjustLimit(request->target_, /* a_failed */ true, /* a_latency */ 0.0);
 
         // ... untrack ...
-        Unlink(r_it->second);
+        Unlink(request);
         
         // ... issue callbacks ...
         stepper_.disconnected_->Call(
@@ -311,12 +421,87 @@ void ev::hub::OneShotHandler::OnConnectionStatusChanged (const ev::Device::Conne
  * @param a_result
  *
  * @return True when the object ownership is accepted, otherwise it will be relased the this function caller.
+ *
+ * @remarks For this handler, it's a partial result of a running request ( e.g. a batch of rows ) and it will be published.
  */
-bool ev::hub::OneShotHandler::OnUnhandledDataObjectReceived (const ev::Device* /* a_device */, const ev::Request* /* a_request */, ev::Result* /* a_result */)
+bool ev::hub::OneShotHandler::OnUnhandledDataObjectReceived (const ev::Device* a_device, const ev::Request* a_request, ev::Result* a_result)
 {
-    // ... this function should not be called for this handler, if so it might be a bug ...
-    // ... reject ownership of the data object ...
-    return false;
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... only for a running request ...
+    const auto range = device_request_map_.equal_range(const_cast<ev::Device*>(a_device));
+    const auto r_it  = std::find_if(range.first, range.second, [a_request](const DeviceRequestsMap::value_type& a_it) {
+        return ( a_request == a_it.second );
+    });
+    if ( range.second == r_it ) {
+        // ... reject ownership of the data object ...
+        return false;
+    }
+    
+    // ... keep track of published, but not consumed, results ...
+    auto s_it = streams_.find(a_request);
+    if ( streams_.end() == s_it ) {
+        s_it = streams_.insert(std::make_pair(a_request, StreamCounter(new std::atomic<size_t>(0)))).first;
+    }
+    StreamCounter counter = s_it->second;
+    (void)counter->fetch_add(1);
+    
+    typedef struct {
+        const int64_t            invoke_id_;
+        const ev::Object::Target target_;
+        const uint8_t            tag_;
+        ev::Result*              result_;
+        StreamCounter            counter_;
+    } Payload;
+    
+    // ... issue callbacks ...
+    stepper_.publish_->Call(
+                            [this, a_request, a_result, counter] () -> void* {
+                                OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+                                // ... prepare callback payload ...
+                                return new Payload({a_request->GetInvokeID(), a_request->target_, a_request->GetTag(), a_result, counter});
+                            },
+                            [](void* a_payload, ev::hub::PublishStepCallback a_callback) {
+                                OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+                                Payload* r_payload = static_cast<Payload*>(a_payload);
+                                std::vector<ev::Result*> results = { r_payload->result_ };
+                                a_callback(
+                                           /* a_invoke_id */ r_payload->invoke_id_,
+                                           /* a_target    */ r_payload->target_,
+                                           /* a_tag       */ r_payload->tag_,
+                                           /* a_results   */ results
+                                );
+                                // ... release 'uncollected' results ...
+                                for ( auto result : results ) {
+                                    delete result;
+                                }
+                                // ... consumed, device can read more ...
+                                (void)r_payload->counter_->fetch_sub(1);
+                                // ... release payload ...
+                                delete r_payload;
+                            }
+    );
+    
+    // ... if it reached here, ownership of data object is accepted ...
+    return true;
+}
+
+/**
+ * @brief Flow control for devices that deliver partial results.
+ *
+ * @param a_device
+ * @param a_request
+ *
+ * @return Number of partial results published for a request, that were not yet consumed.
+ */
+size_t ev::hub::OneShotHandler::PendingDataObjectsCount (const ev::Device* /* a_device */, const ev::Request* a_request)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    const auto it = streams_.find(a_request);
+    if ( streams_.end() == it ) {
+        return 0;
+    }
+    return it->second->load();
 }
 
 #ifdef __APPLE__
@@ -358,16 +543,89 @@ void ev::hub::OneShotHandler::Push ()
             // ... a vector should be ready !
             throw ev::Exception("Unexpected device 'in-use' map state: nullptr!");
         }
-        const size_t in_use_devices_cnt = in_use_device_for_type_it->second->size();
-        // ... limit reached?
-        const auto limits_it          = devices_limits_.find(current_request->target_);
-        size_t     max_devices_in_use = 2;
-        if ( devices_limits_.end() != limits_it ) {
-            max_devices_in_use = limits_it->second;
+        // ... a device pinned to this request invoke id?
+        auto pin_it = pins_.find(current_request->GetInvokeID());
+        if ( pins_.end() != pin_it && current_request->target_ != pin_it->second.target_ ) {
+            pin_it = pins_.end();
         }
-        if ( in_use_devices_cnt >= max_devices_in_use ) {
+        if ( pins_.end() != pin_it && true == pin_it->second.busy_ ) {
+            // ... wait for previous request to be completed ...
             break;
         }
+        // ... nothing to abort if pinned device is gone ( expired or released on error ), server already rolled back ...
+        if ( pins_.end() == pin_it && ev::Request::Control::Abort == current_request->control_ ) {
+            // ... remove it ...
+            pending_requests_.erase(pending_requests_.begin() + idx);
+            // ... mark as completed, without a result ...
+            completed_requests_.push_back(current_request);
+            // ... publish now ...
+            Publish();
+            // ... next ...
+            continue;
+        }
+        // ... already answered by a local cache?
+        if ( pins_.end() == pin_it && ev::Request::Control::NotSet == current_request->control_ ) {
+            ev::Result* cached_result = current_request->CachedResult();
+            if ( nullptr != cached_result ) {
+                // ... remove it ...
+                pending_requests_.erase(pending_requests_.begin() + idx);
+                // ... mark as completed ...
+                current_request->AttachResult(cached_result);
+                completed_requests_.push_back(current_request);
+                // ... publish result now ...
+                Publish();
+                // ... next ...
+                continue;
+            }
+        }
+        // ... a device that can also execute it, without waiting for it's previous requests?
+        ev::Device* pipelined_device = ( pins_.end() == pin_it ? Pipelined(current_request) : nullptr );
+        // ... pinned devices that are not in use are still taken ...
+        size_t in_use_devices_cnt = in_use_device_for_type_it->second->size();
+        for ( auto it : pins_ ) {
+            if ( current_request->target_ == it.second.target_ && false == it.second.busy_ ) {
+                in_use_devices_cnt++;
+            }
+        }
+        // ... limit reached?
+        const size_t max_devices_in_use = Limit(current_request->target_);
+        if ( pins_.end() == pin_it && nullptr == pipelined_device && in_use_devices_cnt >= max_devices_in_use ) {
+            break;
+        }
+        // ... pick the cached device that is best suited for this request ( e.g. a read replica or an already configured session ) ...
+        auto                 cached_device_it = cached_device_for_type_it->second->end();
+        ev::Device::Affinity affinity         = ev::Device::Affinity::None;
+        if ( pins_.end() == pin_it && nullptr == pipelined_device ) {
+            for ( auto it = cached_device_for_type_it->second->begin(); it != cached_device_for_type_it->second->end(); ++it ) {
+                const ev::Device::Affinity device_affinity = (*it)->AffinityFor(current_request);
+                if ( device_affinity > affinity ) {
+                    affinity         = device_affinity;
+                    cached_device_it = it;
+                    if ( ev::Device::Affinity::Matched == affinity ) {
+                        break;
+                    }
+                }
+            }
+        }
+        // ... a new device will be required?
+        bool leased = false;
+        if ( pins_.end() == pin_it
+            &&
+            nullptr == pipelined_device
+            &&
+            affinity < ev::Device::Affinity::Preferred
+            &&
+            supported_target_.end() != supported_target_.find(current_request->target_)
+            &&
+            not ( ev::Request::Control::Invalidate == current_request->control_ && ev::Object::Target::CURL != current_request->target_ )
+        ) {
+            if ( true == AcquireSlot(current_request->target_) ) {
+                leased = true;
+            } else if ( ev::Device::Affinity::None == affinity ) {
+                // ... global budget exhausted, wait for a slot to be returned ...
+                break;
+            } // else { /* ... use fallback device ... */ }
+        }
         // ... remove it ...
         pending_requests_.erase(pending_requests_.begin() + idx);
         ++idx;
@@ -397,13 +655,27 @@ void ev::hub::OneShotHandler::Push ()
             {
                 ev::Device* device;
                 bool        new_device;
-                if ( 0 == cached_device_for_type_it->second->size() ) {
+                const bool  pinned = ( pins_.end() != pin_it );
+                if ( true == pinned ) {
+                    // ... same requester, same device ( and session ) ...
+                    device               = pin_it->second.device_;
+                    new_device           = false;
+                    pin_it->second.busy_ = true;
+                } else if ( nullptr != pipelined_device ) {
+                    // ... already connected and 'in use' ...
+                    device     = pipelined_device;
+                    new_device = false;
+                } else if ( cached_device_for_type_it->second->end() == cached_device_it || true == leased ) {
                     device     = stepper_.factory_(current_request);
                     new_device = true;
+                    if ( true == leased ) {
+                        BindSlot(current_request->target_, device);
+                    }
+                    ApplyLifetime(current_request->target_, device);
                 } else {
-                    device     = (*cached_device_for_type_it->second)[0];
+                    device     = (*cached_device_it);
                     new_device = false;
-                    cached_device_for_type_it->second->erase(cached_device_for_type_it->second->begin());
+                    cached_device_for_type_it->second->erase(cached_device_it);
                 }
                 
                 // ... ensure deice exists ...
@@ -418,27 +690,41 @@ void ev::hub::OneShotHandler::Push ()
                 // ... listen to connection status changes ...
                 device->SetListener(this);
                 
+                // ... collect partial results ...
+                device->SetHandler(this);
+                
                 Link(current_request, device);
                 
                 const ev::Device::Status connect_rv = device->Connect([this, current_request](const ev::Device::ConnectionStatus& a_status, ev::Device* a_device) {
                     
                     bool success = ( ev::Device::ConnectionStatus::Connected == a_status );
                     if ( true == success ) {
+                        const auto exec_start = std::chrono::steady_clock::now();
                         const ev::Device::Status exec_rv = a_device->Execute(
-                                                                             [this, current_request, a_device] (const ev::Device::ExecutionStatus& a_exec_status, ev::Result* a_exec_result) {
+                                                                             [this, current_request, a_device, exec_start] (const ev::Device::ExecutionStatus& a_exec_status, ev::Result* a_exec_result) {
                                                                                  
                                                                                  OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
                                                                                  
-                                                                                 (void)a_exec_status;
-                                                                                 
                                                                                  const auto target = current_request->target_;
                                                                                  
+                                                                                 // ... feed adaptive limiter ...
+                                                                                 AdjustLimit(target, ( ev::Device::ExecutionStatus::Error == a_exec_status ),
+                                                                                             static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - exec_start).count()) / 1000.0
+                                                                                 );
+                                                                                 
                                                                                  Unlink(current_request);
                                                                                  
                                                                                  current_request->AttachResult(a_exec_result);
                                                                                  
                                                                                  // ... mark request as completed ...
                                                                                  completed_requests_.push_back(current_request);
+                                                                                 // ... other requests still pipelined on this device?
+                                                                                 if ( device_request_map_.end() != device_request_map_.find(a_device) ) {
+                                                                                     // ... it stays 'in use' ...
+                                                                                     SanityCheck();
+                                                                                     Publish();
+                                                                                     return;
+                                                                                 }
                                                                                  // ... remove device from 'in use' map ...
                                                                                  auto i_u_it = in_use_devices_.find(target);
                                                                                  if ( in_use_devices_.end() != i_u_it ) {
@@ -450,13 +736,40 @@ void ev::hub::OneShotHandler::Push ()
                                                                                      }
                                                                                  }
                                                                                  
+                                                                                 // ... pinned to requester?
+                                                                                 const auto pin_it     = pins_.find(current_request->GetInvokeID());
+                                                                                 const bool was_pinned = ( pins_.end() != pin_it && a_device == pin_it->second.device_ );
+                                                                                 bool       keep_pin   = false;
+                                                                                 if ( true == was_pinned || ( ev::Request::Control::Pin == current_request->control_ && pins_.end() == pin_it ) ) {
+                                                                                     if ( ev::Device::ExecutionStatus::Ok == a_exec_status
+                                                                                         && ev::Request::Control::Unpin != current_request->control_ && ev::Request::Control::Abort != current_request->control_ ) {
+                                                                                         // ... keep it for the next request, reuse limits are only applied when it's unpinned ...
+                                                                                         pins_[current_request->GetInvokeID()] = { a_device, target, std::chrono::steady_clock::now(), false };
+                                                                                         keep_pin = true;
+                                                                                     } else {
+                                                                                         if ( true == was_pinned ) {
+                                                                                             pins_.erase(pin_it);
+                                                                                         }
+                                                                                         if ( ev::Device::ExecutionStatus::Error == a_exec_status ) {
+                                                                                             // ... session state is unknown, server will rollback when it's disconnected ...
+                                                                                             a_device->InvalidateReuse();
+                                                                                         }
+                                                                                     }
+                                                                                 }
+                                                                                 
                                                                                  // ... and add it to 'cached' map
-                                                                                 if ( false == a_device->Reusable() ) {
+                                                                                 if ( true == keep_pin ) {
+                                                                                     // ... not available to others ...
+                                                                                     a_device->Touch();
+                                                                                 } else if ( false == a_device->Reusable() ) {
                                                                                      // ... device already unlinked ...
                                                                                      // ... we're no longer tracking it ...
                                                                                      // ... it should be deleted after this callback ...
                                                                                      a_device->SetUntracked();
+                                                                                     // ... return it's slot now ...
+                                                                                     ReleaseSlot(a_device);
                                                                                  } else {
+                                                                                     a_device->Touch();
                                                                                      cached_devices_[target]->push_back(a_device);
                                                                                  }
                                                                                  
@@ -480,6 +793,29 @@ void ev::hub::OneShotHandler::Push ()
                     if ( false == success ) {
 
                         const auto target = current_request->target_;
+                        
+                        // ... feed adaptive limiter ...
+                        AdjustLimit(target, /* a_failed */ true, /* a_latency */ 0.0);
+                        
+                        // ... a pinned device session state is unknown, it can't be reused ...
+                        const auto pin_it = FindPin(a_device);
+                        if ( pins_.end() != pin_it ) {
+                            pins_.erase(pin_it);
+                            a_device->InvalidateReuse();
+                        }
+                        
+                        // ... other requests still pipelined on this device?
+                        if ( device_request_map_.count(a_device) > 1 ) {
+                            ev::Result* result = new ev::Result(target);
+                            result->AttachDataObject(a_device->DetachLastError());
+                            current_request->AttachResult(result);
+                            Unlink(current_request);
+                            rejected_requests_.push_back(current_request);
+                            // ... it stays 'in use' ...
+                            SanityCheck();
+                            Publish();
+                            return;
+                        }
 
                         auto i_u_it = in_use_devices_.find(target);
                         if ( in_use_devices_.end() != i_u_it ) {
@@ -506,6 +842,7 @@ void ev::hub::OneShotHandler::Push ()
                             // ... no longer usable ...
                             // ... device already unlinked ...
                             // ... it's safe to delete it now ...
+                            ReleaseSlot(a_device);
                             delete a_device;
                         } else {
                             // ... keep track of the device ...
@@ -521,8 +858,10 @@ void ev::hub::OneShotHandler::Push ()
                 });
                 
                 if ( ev::Device::Status::Async == connect_rv || ev::Device::Status::Nop == connect_rv ) {
-                    // ... keep track of the device ...
-                    in_use_devices_[current_request->target_]->push_back(device);
+                    // ... keep track of the device, unless it's already tracked ...
+                    if ( nullptr == pipelined_device ) {
+                        in_use_devices_[current_request->target_]->push_back(device);
+                    }
                     // ... sanity check required ...
                     SanityCheck();
                     // ... it's an async request ...
@@ -537,8 +876,13 @@ void ev::hub::OneShotHandler::Push ()
                 current_request->AttachResult(result);
 
                 // ... request wont run ...
-                if ( true == new_device ) {
-                    // ... new device is invalid ...
+                if ( true == new_device || true == pinned ) {
+                    // ... new device is invalid or pinned device session state is unknown ...
+                    const auto f_pin_it = FindPin(device);
+                    if ( pins_.end() != f_pin_it ) {
+                        pins_.erase(f_pin_it);
+                    }
+                    ReleaseSlot(device);
                     delete device;
                 } else {
                     // ... keep track of the device ...
@@ -658,7 +1002,7 @@ void ev::hub::OneShotHandler::Link (Request* a_request, Device* a_device)
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     request_device_map_[a_request] = a_device;
-    device_request_map_[a_device]  = a_request;
+    device_request_map_.insert(std::make_pair(a_device, a_request));
     OSALITE_ASSERT(request_device_map_.size() == device_request_map_.size());
 }
 
@@ -673,12 +1017,20 @@ void ev::hub::OneShotHandler::Unlink (Request* a_request)
     OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     const auto r_it = request_device_map_.find(a_request);
     if ( request_device_map_.end() != r_it ) {
-        const auto d_it = device_request_map_.find(r_it->second);
-        if ( device_request_map_.end() != d_it ) {
-            device_request_map_.erase(d_it);
+        const auto range = device_request_map_.equal_range(r_it->second);
+        for ( auto d_it = range.first ; range.second != d_it ; ++d_it ) {
+            if ( a_request == d_it->second ) {
+                device_request_map_.erase(d_it);
+                break;
+            }
         }
         request_device_map_.erase(r_it);
     }
+    // ... forget partial results counter, pending callbacks still hold a reference ...
+    const auto s_it = streams_.find(a_request);
+    if ( streams_.end() != s_it ) {
+        streams_.erase(s_it);
+    }
     OSALITE_ASSERT(request_device_map_.size() == device_request_map_.size());
 }
 
@@ -688,6 +1040,7 @@ void ev::hub::OneShotHandler::Unlink (Request* a_request)
 void ev::hub::OneShotHandler::KillZombies ()
 {
     for ( auto device : zombies_ ) {
+        ReleaseSlot(device);
         delete device;
     }
     zombies_.clear();
@@ -716,6 +1069,12 @@ void ev::hub::OneShotHandler::InvalidateDevices (const ev::Object::Target a_targ
             (*device_it)->InvalidateReuse();
         }
     }
+    // ... pinned devices will be released when unpinned ...
+    for ( auto it : pins_ ) {
+        if ( a_target == it.second.target_ ) {
+            it.second.device_->InvalidateReuse();
+        }
+    }
     PurgeDevices();
 }
 
@@ -727,11 +1086,507 @@ void ev::hub::OneShotHandler::PurgeDevices ()
     for ( auto it : cached_devices_ ) {
         for ( auto device_it = (*it.second).begin(); device_it != (*it.second).end(); ) {
             if ( false == (*device_it)->Reusable() ) {
+                ReleaseSlot(*device_it);
+                delete (*device_it);
+                device_it = (*it.second).erase(device_it);
+            } else {
+                ++device_it;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Iterate all cached devices and replace or release those that exceeded their lifetime limits.
+ *
+ * @remarks Devices that are in use will be drained first, they will be replaced when they return to the cache.
+ *          Devices holding a slot from the global budget are released when idle for more than \link k_lease_idle_ms_ \link,
+ *          even if no idle limit is set, so idle workers won't starve busy ones.
+ */
+void ev::hub::OneShotHandler::RecycleDevices ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    
+    for ( auto it : cached_devices_ ) {
+        bool recycling = false;
+        for ( auto r_it : recycling_devices_ ) {
+            if ( it.first == r_it.second ) {
+                recycling = true;
+                break;
+            }
+        }
+        for ( auto device_it = (*it.second).begin(); device_it != (*it.second).end(); ) {
+            if ( true == (*device_it)->Idled(now)
+                || ( leases_.end() != leases_.find(*device_it) && (*device_it)->IdleTime(now) >= k_lease_idle_ms_ ) ) {
+                // ... no one is using it, no replacement needed ( and it's slot is available to other workers ) ...
+                ReleaseSlot(*device_it);
                 delete (*device_it);
                 device_it = (*it.second).erase(device_it);
             } else {
+                if ( false == recycling && true == (*device_it)->Aged(now) ) {
+                    // ... only one replacement at a time, per target ...
+                    Recycle(it.first, (*device_it));
+                    recycling = true;
+                }
                 ++device_it;
             }
         }
     }
 }
+
+/**
+ * @brief Open a replacement for an aged device, aged device will only be released after the replacement is connected.
+ *
+ * @param a_target
+ * @param a_device Aged device.
+ */
+void ev::hub::OneShotHandler::Recycle (const ev::Object::Target a_target, const ev::Device* a_device)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... factory expects a request, borrow aged device loggable data ...
+    const ev::Request request(a_device->LoggableData(), a_target, ev::Request::Mode::OneShot);
+    
+    // ... replacement is an extra device, it also needs a slot from the global budget ...
+    if ( false == AcquireSlot(a_target) ) {
+        // ... aged device will be kept until next attempt ...
+        return;
+    }
+    
+    ev::Device* device = stepper_.factory_(&request);
+    BindSlot(a_target, device);
+    if ( nullptr == device ) {
+        // ... aged device will be kept until next attempt ...
+        return;
+    }
+    ApplyLifetime(a_target, device);
+    
+    // ... setup device ...
+    stepper_.setup_(device);
+    
+    // ... listen to connection status changes ...
+    device->SetListener(this);
+    
+    // ... keep track of it ...
+    recycling_devices_[device] = a_target;
+    
+    const ev::Device::Status connect_rv = device->Connect([this, a_target](const ev::Device::ConnectionStatus& a_status, ev::Device* a_device) {
+        
+        OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+        
+        const auto r_it = recycling_devices_.find(a_device);
+        if ( recycling_devices_.end() == r_it ) {
+            // ... already handled ...
+            return;
+        }
+        recycling_devices_.erase(r_it);
+        
+        if ( ev::Device::ConnectionStatus::Connected != a_status ) {
+            // ... can't delete it now, we're at it's own callback ...
+            zombies_.insert(a_device);
+            return;
+        }
+        
+        const auto now = std::chrono::steady_clock::now();
+        
+        // ... release an aged device that's not in use ...
+        bool replaced = false;
+        auto cached_it = cached_devices_.find(a_target);
+        if ( cached_devices_.end() != cached_it ) {
+            for ( auto device_it = (*cached_it->second).begin(); device_it != (*cached_it->second).end(); ++device_it ) {
+                if ( true == (*device_it)->Aged(now) ) {
+                    ReleaseSlot(*device_it);
+                    delete (*device_it);
+                    (*cached_it->second).erase(device_it);
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        // ... or drain an aged device that's in use ...
+        bool drained = false;
+        if ( false == replaced ) {
+            const auto in_use_it = in_use_devices_.find(a_target);
+            if ( in_use_devices_.end() != in_use_it ) {
+                for ( auto device : *in_use_it->second ) {
+                    if ( true == device->Aged(now) && true == device->Reusable() ) {
+                        // ... it will be released as soon as it's current request is completed ...
+                        device->InvalidateReuse();
+                        drained = true;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        // ... nothing was replaced or drained ( aged device is gone or already draining ), replacement is not needed ...
+        if ( false == replaced && false == drained ) {
+            ReleaseSlot(a_device);
+            // ... can't delete it now, we're at it's own callback ...
+            zombies_.insert(a_device);
+            SanityCheck();
+            return;
+        }
+        
+        OSALITE_DEBUG_TRACE("ev_one_shot_handler",
+                            "{ %d } : recycled %s device ~> %p",
+                            (int)a_target, replaced ? "cached" : "in use", a_device
+        );
+        
+        // ... replacement is now available ...
+        a_device->Touch();
+        cached_devices_[a_target]->push_back(a_device);
+        
+        // ... sanity check required ...
+        SanityCheck();
+    });
+    
+    if ( not ( ev::Device::Status::Async == connect_rv || ev::Device::Status::Nop == connect_rv ) ) {
+        // ... unable to start connection, aged device will be kept until next attempt ...
+        const auto r_it = recycling_devices_.find(device);
+        if ( recycling_devices_.end() != r_it ) {
+            recycling_devices_.erase(r_it);
+            ReleaseSlot(device);
+            delete device;
+        }
+    }
+}
+
+/**
+ * @brief Apply lifetime limits to a new device, so it can be recycled or released by \link RecycleDevices \link.
+ *
+ * @param a_target
+ * @param a_device New device, nullptr is ignored.
+ */
+void ev::hub::OneShotHandler::ApplyLifetime (const ev::Object::Target a_target, ev::Device* a_device)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    if ( nullptr == a_device || nullptr == stepper_.lifetime_ ) {
+        return;
+    }
+    int64_t max_age_ms  = -1;
+    int64_t max_idle_ms = -1;
+    stepper_.lifetime_(a_target, max_age_ms, max_idle_ms);
+    a_device->SetLifetime(max_age_ms, max_idle_ms);
+}
+
+/**
+ * @brief Evict devices that failed to reply to a health probe in time and probe cached devices that are idle for too long.
+ *
+ * @remarks While being probed, a device won't be used to dispatch requests.
+ */
+void ev::hub::OneShotHandler::ProbeDevices ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    
+    // ... evict devices that didn't reply in time ...
+    for ( auto it = probing_devices_.begin(); probing_devices_.end() != it ; ) {
+        if ( std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.start_).count() >= k_probe_timeout_ms_ ) {
+            OSALITE_DEBUG_TRACE("ev_one_shot_handler",
+                                "{ %d } : device %p probe timed out",
+                                (int)it->second.target_, it->first
+            );
+            stats_[it->second.target_].failed_probes_++;
+            stats_[it->second.target_].evicted_++;
+            // ... we're not at it's own callback, it's safe to delete it now ...
+            ReleaseSlot(it->first);
+            delete it->first;
+            it = probing_devices_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    // ... probe idle devices ...
+    for ( auto it : cached_devices_ ) {
+        const auto target = it.first;
+        // ... not available until probe reply is received ...
+        std::vector<ev::Device*> idle_devices;
+        for ( auto device_it = (*it.second).begin(); device_it != (*it.second).end(); ) {
+            if ( (*device_it)->SinceProbe(now) >= k_probe_idle_ms_ ) {
+                idle_devices.push_back(*device_it);
+                device_it = (*it.second).erase(device_it);
+            } else {
+                ++device_it;
+            }
+        }
+        for ( auto device : idle_devices ) {
+            // ... a probe is not a usage, idle time must not be reset ...
+            device->Probed();
+            probing_devices_[device] = { target, now };
+            const ev::Device::Status ping_rv = device->Ping([this, device] (const ev::Device::ExecutionStatus& a_status, ev::Result* a_result) {
+                
+                OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+                
+                // ... reply content is not relevant ...
+                if ( nullptr != a_result ) {
+                    delete a_result;
+                }
+                
+                const auto p_it = probing_devices_.find(device);
+                if ( probing_devices_.end() == p_it ) {
+                    // ... already evicted ...
+                    return;
+                }
+                const auto target = p_it->second.target_;
+                probing_devices_.erase(p_it);
+                
+                if ( ev::Device::ExecutionStatus::Ok == a_status ) {
+                    // ... alive, make it available again ...
+                    cached_devices_[target]->push_back(device);
+                } else {
+                    OSALITE_DEBUG_TRACE("ev_one_shot_handler",
+                                        "{ %d } : device %p probe failed",
+                                        (int)target, device
+                    );
+                    stats_[target].failed_probes_++;
+                    stats_[target].evicted_++;
+                    // ... can't delete it now, we're at it's own callback ...
+                    zombies_.insert(device);
+                }
+                
+            });
+            
+            if ( ev::Device::Status::Async == ping_rv ) {
+                stats_[target].probes_++;
+                continue;
+            }
+            
+            const auto p_it = probing_devices_.find(device);
+            if ( probing_devices_.end() == p_it ) {
+                // ... already handled by callback ...
+                continue;
+            }
+            probing_devices_.erase(p_it);
+            if ( ev::Device::Status::Nop == ping_rv ) {
+                // ... probes not supported by this device, keep it ...
+                (*it.second).push_back(device);
+            } else {
+                // ... can't be probed, assume it's dead ...
+                stats_[target].failed_probes_++;
+                stats_[target].evicted_++;
+                ReleaseSlot(device);
+                delete device;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Release pinned devices that were not used for more than \link k_pin_timeout_ms_ \link.
+ *
+ * @remarks A requester that fails, times out or is unregistered won't issue more requests, server will rollback the
+ *          pinned device session transaction, if any, when it's disconnected.
+ */
+void ev::hub::OneShotHandler::ExpirePins ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    
+    for ( auto it = pins_.begin(); pins_.end() != it ; ) {
+        if ( false == it->second.busy_ && std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.last_used_).count() >= k_pin_timeout_ms_ ) {
+            OSALITE_DEBUG_TRACE("ev_one_shot_handler",
+                                "{ %d } : device %p pinned to " INT64_FMT " expired",
+                                (int)it->second.target_, it->second.device_, it->first
+            );
+            // ... we're not at it's own callback, it's safe to delete it now ...
+            ReleaseSlot(it->second.device_);
+            delete it->second.device_;
+            it = pins_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Search for a pinned device.
+ *
+ * @param a_device
+ *
+ * @return Pin iterator, \link pins_.end() \link if device is not pinned.
+ */
+ev::hub::OneShotHandler::PinsMap::iterator ev::hub::OneShotHandler::FindPin (const ev::Device* a_device)
+{
+    return std::find_if(pins_.begin(), pins_.end(), [a_device](const PinsMap::value_type& a_it) {
+        return ( a_it.second.device_ == a_device );
+    });
+}
+
+/**
+ * @brief Search for an 'in use' device that can also execute a request, without waiting for it's previous requests.
+ *
+ * @param a_request
+ *
+ * @return A device with room in it's pipeline, nullptr if none.
+ *
+ * @remarks Only for requests that don't depend on a device session, see \link ev::Device::PipelineDepth \link.
+ */
+ev::Device* ev::hub::OneShotHandler::Pipelined (const ev::Request* a_request)
+{
+    if ( ev::Request::Control::NotSet != a_request->control_ ) {
+        return nullptr;
+    }
+    const auto it = in_use_devices_.find(a_request->target_);
+    if ( in_use_devices_.end() == it ) {
+        return nullptr;
+    }
+    for ( auto device : *it->second ) {
+        const size_t in_flight = device_request_map_.count(device);
+        if ( 0 == in_flight || in_flight >= device->PipelineDepth() ) {
+            continue;
+        }
+        if ( false == device->Reusable() || pins_.end() != FindPin(device) || device->AffinityFor(a_request) < ev::Device::Affinity::Preferred ) {
+            continue;
+        }
+        return device;
+    }
+    return nullptr;
+}
+
+/**
+ * @return Current maximum number of devices in use for a specific target.
+ *
+ * @param a_target
+ */
+size_t ev::hub::OneShotHandler::Limit (const ev::Object::Target a_target) const
+{
+    size_t max_limit = 2;
+    const auto limits_it = devices_limits_.find(a_target);
+    if ( devices_limits_.end() != limits_it ) {
+        max_limit = std::max(limits_it->second, static_cast<size_t>(1));
+    }
+    const auto limiter_it = limiters_.find(a_target);
+    if ( limiters_.end() == limiter_it ) {
+        return max_limit;
+    }
+    // ... configured limit is always the upper bound ...
+    return std::min(max_limit, std::max(static_cast<size_t>(limiter_it->second.limit_), static_cast<size_t>(1)));
+}
+
+/**
+ * @brief Adjust a target limit ( AIMD ) using the outcome of a completed request.
+ *
+ * @param a_target
+ * @param a_failed  True when the request failed to execute ( connection or device error ).
+ * @param a_latency Execution latency, in milliseconds.
+ *
+ * @remarks Limit is increased by 1 for each 'limit' requests that succeeded without latency degradation, and
+ *          multiplied by \link k_limit_decrease_factor_ \link when a request fails or when the latency exceeds
+ *          \link k_limit_latency_tolerance_ \link times the best observed latency, at most once per 'limit' requests.
+ */
+void ev::hub::OneShotHandler::AdjustLimit (const ev::Object::Target a_target, const bool a_failed, const double a_latency)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const auto limiter_it = limiters_.find(a_target);
+    if ( limiters_.end() == limiter_it ) {
+        return;
+    }
+    
+    Limiter&   limiter   = limiter_it->second;
+    PoolStats& stats     = stats_[a_target];
+    const auto max_limit = static_cast<double>(stats.max_limit_);
+    
+    bool congested = a_failed;
+    if ( true == a_failed ) {
+        stats.errors_++;
+    } else {
+        // ... smoothed latency ...
+        limiter.latency_ = ( limiter.latency_ < 0.0 ? a_latency : ( limiter.latency_ * 0.9 ) + ( a_latency * 0.1 ) );
+        // ... best latency, slowly drifting towards current latency so it can recover from a change in the backend ...
+        if ( limiter.baseline_ < 0.0 || a_latency < limiter.baseline_ ) {
+            limiter.baseline_ = a_latency;
+        } else {
+            limiter.baseline_ += ( limiter.latency_ - limiter.baseline_ ) * 0.01;
+        }
+        congested = ( limiter.baseline_ > 0.0 && limiter.latency_ > ( limiter.baseline_ * k_limit_latency_tolerance_ ) );
+    }
+    
+    limiter.since_decrease_++;
+    
+    if ( true == congested ) {
+        // ... multiplicative decrease, at most once per 'limit' completed requests ...
+        if ( limiter.since_decrease_ >= static_cast<size_t>(limiter.limit_) ) {
+            limiter.limit_          = std::max(limiter.limit_ * k_limit_decrease_factor_, 1.0);
+            limiter.since_decrease_ = 0;
+        }
+    } else {
+        // ... additive increase ...
+        limiter.limit_ = std::min(limiter.limit_ + ( 1.0 / limiter.limit_ ), max_limit);
+    }
+    
+    stats.limit_   = Limit(a_target);
+    stats.latency_ = std::max(limiter.latency_, 0.0);
+    
+    OSALITE_DEBUG_TRACE("ev_one_shot_handler",
+                        "{ %d } : limit %.2f / %d, latency %.2fms, baseline %.2fms%s",
+                        (int)a_target, limiter.limit_, (int)stats.max_limit_, limiter.latency_, limiter.baseline_,
+                        ( true == congested ? " : CONGESTED" : "" )
+    );
+}
+
+#ifdef __APPLE__
+#pragma mark - Global Budget
+#endif
+
+/**
+ * @brief Lease a slot from the global ( cross-process ) devices budget, before creating a new device.
+ *
+ * @param a_target
+ *
+ * @return True if a slot was leased or if no global budget is set, false if the budget is exhausted.
+ */
+bool ev::hub::OneShotHandler::AcquireSlot (const ev::Object::Target a_target)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    if ( nullptr == stepper_.lease_ ) {
+        return true;
+    }
+    return stepper_.lease_(a_target);
+}
+
+/**
+ * @brief Bind a previously leased slot to a new device, if the device wasn't created the slot is returned immediately.
+ *
+ * @param a_target
+ * @param a_device
+ */
+void ev::hub::OneShotHandler::BindSlot (const ev::Object::Target a_target, const ev::Device* a_device)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    if ( nullptr == stepper_.release_ ) {
+        return;
+    }
+    if ( nullptr == a_device ) {
+        stepper_.release_(a_target);
+    } else {
+        leases_[a_device] = a_target;
+    }
+}
+
+/**
+ * @brief Return a device slot to the global ( cross-process ) devices budget.
+ *
+ * @param a_device
+ *
+ * @remarks Must be called when a device is released or no longer tracked, it's safe to call it more than once.
+ */
+void ev::hub::OneShotHandler::ReleaseSlot (const ev::Device* a_device)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    const auto it = leases_.find(a_device);
+    if ( leases_.end() == it ) {
+        return;
+    }
+    const auto target = it->second;
+    leases_.erase(it);
+    if ( nullptr != stepper_.release_ ) {
+        stepper_.release_(target);
+    }
+}
@@ -30,6 +30,9 @@
 #include <map>    // std::map
 #include <vector> // std::vector
 #include <deque>  // std::deque
+#include <chrono> // std::chrono::steady_clock
+#include <memory> // std::shared_ptr
+#include <atomic> // std::atomic
 
 namespace ev
 {
@@ -40,10 +43,51 @@ namespace ev
         class OneShotHandler final : public Handler
         {
             
+        public: // Data Type(s)
+            
+            typedef struct {
+                size_t probes_;        //!< Number of health probes sent.
+                size_t failed_probes_; //!< Number of health probes that failed or timed out.
+                size_t evicted_;       //!< Number of devices evicted because of a failed probe.
+                size_t limit_;         //!< Current adaptive limit of devices in use.
+                size_t max_limit_;     //!< Configured upper bound of devices in use.
+                double latency_;       //!< Smoothed execution latency, in milliseconds.
+                size_t errors_;        //!< Number of requests that failed to execute.
+            } PoolStats;
+            
+            typedef std::map<Object::Target, PoolStats> PoolStatsMap;
+            
         private: // Data Type(s)
             
+            typedef struct {
+                Object::Target                        target_;
+                std::chrono::steady_clock::time_point start_;
+            } Probe;
+            
+            typedef struct {
+                double limit_;          //!< Current limit, additive increase, multiplicative decrease.
+                double baseline_;       //!< Best observed latency, in milliseconds, -1 if none.
+                double latency_;        //!< Smoothed latency, in milliseconds, -1 if none.
+                size_t since_decrease_; //!< Number of completed requests since last decrease.
+            } Limiter;
+            
+            typedef struct {
+                Device*                               device_;    //!< Device pinned to an invoke id.
+                Object::Target                        target_;    //!< Device target.
+                std::chrono::steady_clock::time_point last_used_; //!< Last time a request was completed by this device.
+                bool                                  busy_;      //!< True while executing a request, it's also tracked as 'in use'.
+            } Pin;
+            
             typedef std::map<Object::Target, std::vector<Device*>*> DevicesMap;
             typedef std::map<Object::Target, size_t>                DevicesLimits;
+            typedef std::map<Device*, Object::Target>               RecyclingMap;
+            typedef std::map<Device*, Probe>                        ProbingMap;
+            typedef std::map<Object::Target, Limiter>               LimitersMap;
+            typedef std::map<const Device*, Object::Target>         LeasesMap;
+            typedef std::shared_ptr<std::atomic<size_t>>            StreamCounter;
+            typedef std::map<const Request*, StreamCounter>         StreamsMap;
+            typedef std::map<int64_t, Pin>                          PinsMap;
+            typedef std::multimap<Device*, Request*>                DeviceRequestsMap; //!< More than one request per device when pipelining.
             
         private: // Data
             
@@ -53,9 +97,25 @@ namespace ev
             DevicesMap                  in_use_devices_;
             DevicesMap                  cached_devices_;
             std::map<Request*, Device*> request_device_map_;
-            std::map<Device*, Request*> device_request_map_;
+            DeviceRequestsMap           device_request_map_;
             DevicesLimits               devices_limits_;
+            LimitersMap                 limiters_;
             std::set<Device*>           zombies_;
+            RecyclingMap                recycling_devices_;
+            ProbingMap                  probing_devices_;
+            PoolStatsMap                stats_;
+            LeasesMap                   leases_;
+            StreamsMap                  streams_;
+            PinsMap                     pins_;
+            
+        public: // Static Const Data
+            
+            static const int64_t        k_probe_idle_ms_;
+            static const int64_t        k_probe_timeout_ms_;
+            static const double         k_limit_decrease_factor_;
+            static const double         k_limit_latency_tolerance_;
+            static const int64_t        k_pin_timeout_ms_;
+            static const int64_t        k_lease_idle_ms_;
             
         public: // Constructor(s) / Destructor
             
@@ -72,6 +132,11 @@ namespace ev
             
             virtual void OnConnectionStatusChanged     (const ev::Device::ConnectionStatus& a_status, ev::Device* a_device);
             virtual bool OnUnhandledDataObjectReceived (const ev::Device* a_device, const ev::Request* a_request, ev::Result* a_result);
+            virtual size_t PendingDataObjectsCount     (const ev::Device* a_device, const ev::Request* a_request);
+            
+        public: // Method(s) / Function(s)
+            
+            const PoolStatsMap& Stats () const;
             
         private: // Method(s) / Function(s)
             
@@ -82,8 +147,33 @@ namespace ev
             void KillZombies ();
             void InvalidateDevices  (const ev::Object::Target a_target);
             void PurgeDevices       ();
+            void RecycleDevices     ();
+            void Recycle            (const ev::Object::Target a_target, const ev::Device* a_device);
+            void ProbeDevices       ();
+            void ExpirePins         ();
+            void ApplyLifetime      (const ev::Object::Target a_target, ev::Device* a_device);
+            
+            PinsMap::iterator FindPin   (const ev::Device* a_device);
+            Device*           Pipelined (const Request* a_request);
+            
+            size_t Limit       (const ev::Object::Target a_target) const;
+            void   AdjustLimit (const ev::Object::Target a_target, const bool a_failed, const double a_latency);
+            
+            bool   AcquireSlot (const ev::Object::Target a_target);
+            void   BindSlot    (const ev::Object::Target a_target, const ev::Device* a_device);
+            void   ReleaseSlot (const ev::Device* a_device);
             
         };
+        
+        /**
+         * @return R/O access to devices pool stats, per target.
+         *
+         * @remarks Must be called from the hub thread.
+         */
+        inline const OneShotHandler::PoolStatsMap& OneShotHandler::Stats () const
+        {
+            return stats_;
+        }
 
     } // end of namespace 'hub'
     
@@ -139,6 +139,10 @@ namespace ev
         typedef std::function<::ev::Device*(const ::ev::Object* a_target)> DeviceFactoryStepCallback;
         typedef std::function<void(::ev::Device* a_device)>                DeviceSetupStepCallback;
         typedef std::function<size_t(const ::ev::Object::Target a_target)> DeviceLimitsStepCallback;
+        typedef std::function<bool(const ::ev::Object::Target a_target)>   DeviceLeaseStepCallback;
+        typedef std::function<void(const ::ev::Object::Target a_target)>   DeviceReleaseStepCallback;
+        typedef std::function<void(const ::ev::Object::Target a_target,
+                                   int64_t& o_max_age_ms, int64_t& o_max_idle_ms)> DeviceLifetimeStepCallback;
 
         
         class StepperCallbacks
@@ -146,12 +150,15 @@ namespace ev
             
         public: // Pointers
             
-            NextCallback*             next_;
-            PublishCallback*          publish_;
-            DisconnectedCallback*     disconnected_;
-            DeviceFactoryStepCallback factory_;
-            DeviceSetupStepCallback   setup_;
-            DeviceLimitsStepCallback  limits_;
+            NextCallback*              next_;
+            PublishCallback*           publish_;
+            DisconnectedCallback*      disconnected_;
+            DeviceFactoryStepCallback  factory_;
+            DeviceSetupStepCallback    setup_;
+            DeviceLimitsStepCallback   limits_;
+            DeviceLeaseStepCallback    lease_;
+            DeviceReleaseStepCallback  release_;
+            DeviceLifetimeStepCallback lifetime_;
             
         public: // Constructor / Destructor
             
@@ -166,6 +173,9 @@ namespace ev
                 factory_      = nullptr;
                 setup_        = nullptr;
                 limits_       = nullptr;
+                lease_        = nullptr;
+                release_      = nullptr;
+                lifetime_     = nullptr;
             }
             
             /**
@@ -177,6 +187,9 @@ namespace ev
                 factory_ = nullptr;
                 setup_   = nullptr;
                 limits_  = nullptr;
+                lease_    = nullptr;
+                release_  = nullptr;
+                lifetime_ = nullptr;
             }
             
         };
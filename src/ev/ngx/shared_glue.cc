@@ -41,6 +41,18 @@ std::string ev::ngx::SharedGlue::s_job_id_key_ = "";
     /* sessionless_tubes_ */ {}
 };
 
+ngx_shm_t ev::ngx::SharedGlue::s_budget_shm_ = {
+    /* addr   */ nullptr,
+    /* size   */ 0,
+    /* name   */ { 0, nullptr },
+    /* log    */ nullptr,
+    /* exists */ 0
+};
+
+static const ::ev::Object::Target k_budget_targets_[] = {
+    ::ev::Object::Target::Redis, ::ev::Object::Target::PostgreSQL, ::ev::Object::Target::CURL
+};
+
 /**
  * @brief Destructor.
  */
@@ -91,6 +103,28 @@ void ev::ngx::SharedGlue::PreConfigure (const ngx_core_conf_t* a_config, const b
     if ( true == a_master ) {
         osal::File::Delete(socket_files_dn_.c_str(), "ev-*.socket", nullptr);
     }
+    
+    // ... global devices budget must be allocated by master, before workers are forked ...
+    // ... ( and only once, so leases from workers of a previous generation are still accounted for ) ...
+    if ( true == a_master && nullptr == s_budget_shm_.addr ) {
+        s_budget_shm_.size      = sizeof(DeviceBudget) * ( sizeof(k_budget_targets_) / sizeof(k_budget_targets_[0]) );
+        s_budget_shm_.name.data = (u_char*)"ev-devices-budget";
+        s_budget_shm_.name.len  = sizeof("ev-devices-budget") - 1;
+        s_budget_shm_.log       = ngx_cycle->log;
+        if ( NGX_OK != ngx_shm_alloc(&s_budget_shm_) ) {
+            s_budget_shm_.addr = nullptr;
+            throw ev::Exception("Unable to allocate %zu byte(s) of shared memory for devices budget!",
+                                s_budget_shm_.size
+            );
+        }
+        memset(s_budget_shm_.addr, 0, s_budget_shm_.size);
+        for ( auto target : k_budget_targets_ ) {
+            const auto limits_it = device_limits_.find(target);
+            if ( device_limits_.end() != limits_it ) {
+                Budget(target)->max_ = static_cast<ngx_atomic_uint_t>(limits_it->second.max_conn_global_);
+            }
+        }
+    }
 }
 
 /**
@@ -111,6 +145,115 @@ void ev::ngx::SharedGlue::PreWorkerStartup (std::string& o_scheduler_socket_fn,
     ss.str("");
     ss << socket_files_dn_ << "ev-shared-handler-" << pid << ".socket";
     o_shared_handler_socket_fn = ss.str();
+    
+    // ... return slots leased by a previous worker, that exited without releasing them, from this process slot ...
+    for ( auto target : k_budget_targets_ ) {
+        DeviceBudget* budget = Budget(target);
+        if ( nullptr == budget || ngx_process_slot < 0 || ngx_process_slot >= NGX_MAX_PROCESSES ) {
+            continue;
+        }
+        const ngx_atomic_uint_t stale = budget->per_worker_[ngx_process_slot];
+        if ( stale > 0 ) {
+            (void) ngx_atomic_fetch_add(&budget->per_worker_[ngx_process_slot], -static_cast<ngx_atomic_int_t>(stale));
+            (void) ngx_atomic_fetch_add(&budget->in_use_, -static_cast<ngx_atomic_int_t>(stale));
+        }
+    }
+}
+
+/**
+ * @brief Lease a device slot from the global ( all workers ) devices budget.
+ *
+ * @param a_target
+ *
+ * @return True if a slot was leased or if no global limit is set for this target, false if budget is exhausted.
+ *
+ * @remarks Lock free, it can be called from any thread. Each leased slot must be returned with \link ReleaseDevice \link.
+ */
+bool ev::ngx::SharedGlue::LeaseDevice (const ::ev::Object::Target a_target)
+{
+    DeviceBudget* budget = Budget(a_target);
+    if ( nullptr == budget || 0 == budget->max_ || ngx_process_slot < 0 || ngx_process_slot >= NGX_MAX_PROCESSES ) {
+        return true;
+    }
+    while ( true ) {
+        const ngx_atomic_uint_t in_use = budget->in_use_;
+        if ( in_use >= budget->max_ ) {
+            return false;
+        }
+        if ( 0 != ngx_atomic_cmp_set(&budget->in_use_, in_use, in_use + 1) ) {
+            (void) ngx_atomic_fetch_add(&budget->per_worker_[ngx_process_slot], 1);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Return a device slot, previously leased with \link LeaseDevice \link, to the global devices budget.
+ *
+ * @param a_target
+ *
+ * @remarks Lock free, it can be called from any thread.
+ */
+void ev::ngx::SharedGlue::ReleaseDevice (const ::ev::Object::Target a_target)
+{
+    DeviceBudget* budget = Budget(a_target);
+    if ( nullptr == budget || ngx_process_slot < 0 || ngx_process_slot >= NGX_MAX_PROCESSES ) {
+        return;
+    }
+    // ... only slots leased by this worker can be returned ...
+    while ( true ) {
+        const ngx_atomic_uint_t leased = budget->per_worker_[ngx_process_slot];
+        if ( 0 == leased ) {
+            return;
+        }
+        if ( 0 != ngx_atomic_cmp_set(&budget->per_worker_[ngx_process_slot], leased, leased - 1) ) {
+            (void) ngx_atomic_fetch_add(&budget->in_use_, -1);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Obtain a new device lifetime limits, a random jitter is applied to it's maximum age.
+ *
+ * @param a_target
+ * @param o_max_age_ms  Maximum lifetime in milliseconds, -1 if no limit is set.
+ * @param o_max_idle_ms Maximum idle time in milliseconds, -1 if no limit is set.
+ *
+ * @remarks Meant to be used as the scheduler's device lifetime callback, it's called from the hub thread.
+ */
+void ev::ngx::SharedGlue::DeviceLifetime (const ::ev::Object::Target a_target, int64_t& o_max_age_ms, int64_t& o_max_idle_ms)
+{
+    o_max_age_ms  = -1;
+    o_max_idle_ms = -1;
+    const auto limits_it = device_limits_.find(a_target);
+    if ( device_limits_.end() == limits_it ) {
+        return;
+    }
+    if ( nullptr != limits_it->second.rnd_conn_lifetime_ ) {
+        o_max_age_ms = limits_it->second.rnd_conn_lifetime_();
+    }
+    if ( limits_it->second.max_conn_idle_ > 0 ) {
+        o_max_idle_ms = limits_it->second.max_conn_idle_;
+    }
+}
+
+/**
+ * @return Global devices budget for a specific target, nullptr if not allocated.
+ *
+ * @param a_target
+ */
+ev::ngx::SharedGlue::DeviceBudget* ev::ngx::SharedGlue::Budget (const ::ev::Object::Target a_target)
+{
+    if ( nullptr == s_budget_shm_.addr ) {
+        return nullptr;
+    }
+    for ( size_t idx = 0 ; idx < ( sizeof(k_budget_targets_) / sizeof(k_budget_targets_[0]) ) ; ++idx ) {
+        if ( a_target == k_budget_targets_[idx] ) {
+            return reinterpret_cast<DeviceBudget*>(s_budget_shm_.addr) + idx;
+        }
+    }
+    return nullptr;
 }
 
 /**
@@ -139,12 +282,20 @@ void ev::ngx::SharedGlue::SetupService (const std::map<std::string, std::string>
  * @param a_min_queries_per_conn_key
  * @param a_max_queries_per_conn_key
  * @param a_postgresql_post_connect_queries_key;
+ * @param a_max_conn_lifetime_key Maximum connection lifetime, in seconds, a random jitter of up to 25% will be subtracted per connection.
+ * @param a_max_conn_idle_key     Maximum connection idle time, in seconds.
+ * @param a_max_conn_global_key   Maximum number of connections for all workers, 0 or not set if no limit, see \link LeaseDevice \link.
+ * @param a_replicas_key          JSON array of read replicas connection strings, see \link ev::postgresql::Replicas \link.
+ * @param a_max_replica_lag_key   Maximum acceptable replication lag, in milliseconds, a replica that exceeds it won't execute reads.
  */ 
 void ev::ngx::SharedGlue::SetupPostgreSQL (const std::map<std::string, std::string>& a_config,
                                            const char* const a_conn_str_key, const char* const a_statement_timeout_key,
                                            const char* const a_max_conn_per_worker_key,
                                            const char* const a_min_queries_per_conn_key, const char* const a_max_queries_per_conn_key,
-                                           const char* const a_post_connect_queries_key)
+                                           const char* const a_post_connect_queries_key,
+                                           const char* const a_max_conn_lifetime_key, const char* const a_max_conn_idle_key,
+                                           const char* const a_max_conn_global_key,
+                                           const char* const a_replicas_key, const char* const a_max_replica_lag_key)
 {
     
     const std::map<std::string, std::string> map = {
@@ -201,6 +352,36 @@ void ev::ngx::SharedGlue::SetupPostgreSQL (const std::map<std::string, std::stri
         postgresql_min_queries_per_conn = tmp;
     }
 
+    int64_t postgresql_max_conn_lifetime = -1;
+    if ( nullptr != a_max_conn_lifetime_key ) {
+        const auto postgresql_max_conn_lifetime_it = a_config.find(a_max_conn_lifetime_key);
+        if ( a_config.end() != postgresql_max_conn_lifetime_it ) {
+            postgresql_max_conn_lifetime = std::max((int64_t)std::stoll(postgresql_max_conn_lifetime_it->second), (int64_t)0) * 1000;
+            if ( 0 == postgresql_max_conn_lifetime ) {
+                postgresql_max_conn_lifetime = -1;
+            }
+        }
+    }
+
+    int64_t postgresql_max_conn_idle = -1;
+    if ( nullptr != a_max_conn_idle_key ) {
+        const auto postgresql_max_conn_idle_it = a_config.find(a_max_conn_idle_key);
+        if ( a_config.end() != postgresql_max_conn_idle_it ) {
+            postgresql_max_conn_idle = std::max((int64_t)std::stoll(postgresql_max_conn_idle_it->second), (int64_t)0) * 1000;
+            if ( 0 == postgresql_max_conn_idle ) {
+                postgresql_max_conn_idle = -1;
+            }
+        }
+    }
+
+    size_t postgresql_max_conn_global = 0;
+    if ( nullptr != a_max_conn_global_key ) {
+        const auto postgresql_max_conn_global_it = a_config.find(a_max_conn_global_key);
+        if ( a_config.end() != postgresql_max_conn_global_it ) {
+            postgresql_max_conn_global = static_cast<size_t>(std::max(std::stoll(postgresql_max_conn_global_it->second), (long long)0));
+        }
+    }
+
     device_limits_[::ev::Object::Target::PostgreSQL] = {
         /* max_conn_per_worker_  */ postgresql_max_conn_per_worker,
         /* max_queries_per_conn_ */ postgresql_max_queries_per_conn,
@@ -227,9 +408,32 @@ void ev::ngx::SharedGlue::SetupPostgreSQL (const std::map<std::string, std::stri
             
             return max_queries_per_conn;
             
-        }
+        },
+        /* max_conn_lifetime_    */ postgresql_max_conn_lifetime,
+        /* max_conn_idle_        */ postgresql_max_conn_idle,
+        /* rnd_conn_lifetime_    */ [this] () -> int64_t {
+            
+            int64_t max_conn_lifetime = -1;
+            
+            const auto limits_it = device_limits_.find(ev::Object::Target::PostgreSQL);
+            if ( device_limits_.end() != limits_it && limits_it->second.max_conn_lifetime_ > 0 ) {
+                // ... subtract up to 25% so connections opened together won't all be recycled at the same time ...
+                const int64_t jitter = ( limits_it->second.max_conn_lifetime_ / 4 );
+                max_conn_lifetime = limits_it->second.max_conn_lifetime_ - ( jitter > 0 ? ( random() % ( jitter + 1 ) ) : 0 );
+            }
+            
+            return max_conn_lifetime;
+            
+        },
+        /* max_conn_global_      */ postgresql_max_conn_global
     };
     
+    // ... budget zone already allocated?
+    DeviceBudget* budget = Budget(::ev::Object::Target::PostgreSQL);
+    if ( nullptr != budget ) {
+        budget->max_ = static_cast<ngx_atomic_uint_t>(postgresql_max_conn_global);
+    }
+    
     if ( nullptr != a_post_connect_queries_key ) {
         const auto postgresql_post_connect_queries_it = a_config.find(a_post_connect_queries_key);
         if ( a_config.end() != postgresql_post_connect_queries_it ) {
@@ -239,6 +443,33 @@ void ev::ngx::SharedGlue::SetupPostgreSQL (const std::map<std::string, std::stri
             }
         }    
     }
+    
+    postgresql_replicas_.clear();
+    if ( nullptr != a_replicas_key ) {
+        const auto postgresql_replicas_it = a_config.find(a_replicas_key);
+        if ( a_config.end() != postgresql_replicas_it ) {
+            Json::Value  replicas;
+            Json::Reader reader;
+            if ( false == reader.parse(postgresql_replicas_it->second, replicas) || false == replicas.isArray() ) {
+                throw ev::Exception("Unable to parse %s value - expected valid JSON array string!", a_replicas_key);
+            }
+            for ( Json::ArrayIndex idx = 0 ; idx < replicas.size() ; ++idx ) {
+                if ( false == replicas[idx].isString() ) {
+                    throw ev::Exception("Unable to parse %s value - expected an array of connection strings!", a_replicas_key);
+                }
+                postgresql_replicas_.push_back(replicas[idx].asString());
+            }
+        }
+    }
+    
+    if ( nullptr != a_max_replica_lag_key ) {
+        const auto postgresql_max_replica_lag_it = a_config.find(a_max_replica_lag_key);
+        if ( a_config.end() != postgresql_max_replica_lag_it ) {
+            config_map_[a_max_replica_lag_key] = postgresql_max_replica_lag_it->second;
+        } else {
+            config_map_[a_max_replica_lag_key] = "1000";
+        }
+    }
 }
 
 /**
@@ -249,12 +480,21 @@ void ev::ngx::SharedGlue::SetupPostgreSQL (const std::map<std::string, std::stri
  * @param a_port_number_key
  * @param a_database_key
  * @param a_max_conn_per_worker
+ * @param a_pipeline_depth_key  Maximum number of commands sent and waiting for a reply, per connection, see \link ev::redis::Device::PipelineDepth \link.
+ * @param a_cluster_nodes_key   JSON array of REDIS Cluster seed nodes, as '<ip address>:<port number>', see \link ev::redis::Cluster \link.
+ * @param a_sentinels_key       JSON array of REDIS Sentinels, as '<ip address>:<port number>', see \link ev::redis::Sentinel \link.
+ * @param a_sentinel_master_key Name of the master monitored by sentinels.
+ * @param a_subscriptions_connections_key Number of keep alive connections for subscriptions, see \link ev::redis::subscriptions::Manager::Startup \link.
  */
 void ev::ngx::SharedGlue::SetupREDIS (const std::map<std::string, std::string>& a_config,
                                       const char* const a_ip_address_key,
                                       const char* const a_port_number_key,
                                       const char* const a_database_key,
-                                      const char* const a_max_conn_per_worker)
+                                      const char* const a_max_conn_per_worker,
+                                      const char* const a_pipeline_depth_key,
+                                      const char* const a_cluster_nodes_key,
+                                      const char* const a_sentinels_key, const char* const a_sentinel_master_key,
+                                      const char* const a_subscriptions_connections_key)
 {
     
     const std::map<std::string, std::string> map = {
@@ -296,8 +536,75 @@ void ev::ngx::SharedGlue::SetupREDIS (const std::map<std::string, std::string>&
         /* max_conn_per_worker_  */ redis_max_conn_per_worker,
         /* max_queries_per_conn_ */ -1,
         /* min_queries_per_conn_ */ -1,
-        /* rnd_queries_per_conn_ */ nullptr
+        /* rnd_queries_per_conn_ */ nullptr,
+        /* max_conn_lifetime_    */ -1,
+        /* max_conn_idle_        */ -1,
+        /* rnd_conn_lifetime_    */ nullptr,
+        /* max_conn_global_      */ 0
     };
+    
+    if ( nullptr != a_pipeline_depth_key ) {
+        const auto redis_pipeline_depth_it = a_config.find(a_pipeline_depth_key);
+        if ( a_config.end() != redis_pipeline_depth_it ) {
+            config_map_[a_pipeline_depth_key] = redis_pipeline_depth_it->second;
+        } else {
+            config_map_[a_pipeline_depth_key] = "1";
+        }
+    }
+    
+    redis_cluster_nodes_.clear();
+    if ( nullptr != a_cluster_nodes_key ) {
+        const auto redis_cluster_nodes_it = a_config.find(a_cluster_nodes_key);
+        if ( a_config.end() != redis_cluster_nodes_it ) {
+            Json::Value  nodes;
+            Json::Reader reader;
+            if ( false == reader.parse(redis_cluster_nodes_it->second, nodes) || false == nodes.isArray() ) {
+                throw ev::Exception("Unable to parse %s value - expected valid JSON array string!", a_cluster_nodes_key);
+            }
+            for ( Json::ArrayIndex idx = 0 ; idx < nodes.size() ; ++idx ) {
+                if ( false == nodes[idx].isString() ) {
+                    throw ev::Exception("Unable to parse %s value - expected an array of <ip address>:<port number> strings!", a_cluster_nodes_key);
+                }
+                redis_cluster_nodes_.push_back(nodes[idx].asString());
+            }
+        }
+    }
+    
+    redis_sentinels_.clear();
+    if ( nullptr != a_sentinels_key ) {
+        const auto redis_sentinels_it = a_config.find(a_sentinels_key);
+        if ( a_config.end() != redis_sentinels_it ) {
+            Json::Value  sentinels;
+            Json::Reader reader;
+            if ( false == reader.parse(redis_sentinels_it->second, sentinels) || false == sentinels.isArray() ) {
+                throw ev::Exception("Unable to parse %s value - expected valid JSON array string!", a_sentinels_key);
+            }
+            for ( Json::ArrayIndex idx = 0 ; idx < sentinels.size() ; ++idx ) {
+                if ( false == sentinels[idx].isString() ) {
+                    throw ev::Exception("Unable to parse %s value - expected an array of <ip address>:<port number> strings!", a_sentinels_key);
+                }
+                redis_sentinels_.push_back(sentinels[idx].asString());
+            }
+        }
+    }
+    
+    if ( nullptr != a_sentinel_master_key ) {
+        const auto redis_sentinel_master_it = a_config.find(a_sentinel_master_key);
+        if ( a_config.end() != redis_sentinel_master_it ) {
+            config_map_[a_sentinel_master_key] = redis_sentinel_master_it->second;
+        } else {
+            config_map_[a_sentinel_master_key] = "";
+        }
+    }
+    
+    if ( nullptr != a_subscriptions_connections_key ) {
+        const auto redis_subscriptions_connections_it = a_config.find(a_subscriptions_connections_key);
+        if ( a_config.end() != redis_subscriptions_connections_it ) {
+            config_map_[a_subscriptions_connections_key] = redis_subscriptions_connections_it->second;
+        } else {
+            config_map_[a_subscriptions_connections_key] = "1";
+        }
+    }
 }
 
 /**
@@ -319,7 +626,11 @@ void ev::ngx::SharedGlue::SetupCURL (const std::map<std::string, std::string>& a
         /* max_conn_per_worker_  */ curl_max_conn_per_worker,
         /* max_queries_per_conn_ */ -1,
         /* min_queries_per_conn_ */ -1,
-        /* rnd_queries_per_conn_ */ nullptr
+        /* rnd_queries_per_conn_ */ nullptr,
+        /* max_conn_lifetime_    */ -1,
+        /* max_conn_idle_        */ -1,
+        /* rnd_conn_lifetime_    */ nullptr,
+        /* max_conn_global_      */ 0
     };
 }
 
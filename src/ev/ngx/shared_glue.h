@@ -24,6 +24,7 @@
 
 #include <string>     // std::string
 #include <map>        // std::map
+#include <vector>     // std::vector
 #include <functional> // std::function
 
 #include "ev/object.h"
@@ -51,19 +52,33 @@ namespace ev
                 ssize_t                  max_queries_per_conn_;
                 ssize_t                  min_queries_per_conn_;
                 std::function<ssize_t()> rnd_queries_per_conn_;
+                int64_t                  max_conn_lifetime_;
+                int64_t                  max_conn_idle_;
+                std::function<int64_t()> rnd_conn_lifetime_;
+                size_t                   max_conn_global_;
             } DeviceLimits;
             
+            typedef struct _DeviceBudget {
+                ngx_atomic_t             max_;                            //!< Maximum number of connections, for all workers, 0 if no limit is set.
+                ngx_atomic_t             in_use_;                         //!< Number of leased connections, for all workers.
+                ngx_atomic_t             per_worker_[NGX_MAX_PROCESSES];  //!< Number of leased connections, per worker process slot.
+            } DeviceBudget;
+            
         protected: // Data
             
             std::map<ev::Object::Target, DeviceLimits> device_limits_;
             std::map<std::string, std::string>         config_map_;
             Json::Value                                postgresql_post_connect_queries_;
+            std::vector<std::string>                   postgresql_replicas_;
+            std::vector<std::string>                   redis_cluster_nodes_;
+            std::vector<std::string>                   redis_sentinels_;
             
         protected: // Static Data
             
             static std::string                         s_service_id_;
             static std::string                         s_job_id_key_;
             static ::ev::beanstalk::Config             s_beanstalkd_config_;
+            static ngx_shm_t                           s_budget_shm_;
             
         protected: // Threading
             
@@ -82,6 +97,10 @@ namespace ev
             void PreConfigure     (const ngx_core_conf_t* a_config, const bool a_master);
             void PreWorkerStartup (std::string& o_scheduler_socket_fn, std::string& o_shared_handler_socket_fn);
             
+            bool LeaseDevice      (const ::ev::Object::Target a_target);
+            void ReleaseDevice    (const ::ev::Object::Target a_target);
+            void DeviceLifetime   (const ::ev::Object::Target a_target, int64_t& o_max_age_ms, int64_t& o_max_idle_ms);
+            
             const ::ev::beanstalk::Config& BeanstalkdConfig () const;
             const std::string&             ServiceID        () const;
             const std::string&             JobIDKey         () const;
@@ -95,13 +114,20 @@ namespace ev
                                           const char* const a_conn_str_key, const char* const a_statement_timeout_key,
                                           const char* const a_max_conn_per_worker_key,
                                           const char* const a_min_queries_per_conn_key, const char* const a_max_queries_per_conn_key,
-                                          const char* const a_postgresql_post_connect_queries_key);
+                                          const char* const a_postgresql_post_connect_queries_key,
+                                          const char* const a_max_conn_lifetime_key = nullptr, const char* const a_max_conn_idle_key = nullptr,
+                                          const char* const a_max_conn_global_key = nullptr,
+                                          const char* const a_replicas_key = nullptr, const char* const a_max_replica_lag_key = nullptr);
             
             virtual void SetupREDIS      (const std::map<std::string, std::string>& a_config,
                                           const char* const a_ip_address_key,
                                           const char* const a_port_number_key,
                                           const char* const a_database_key,
-                                          const char* const a_max_conn_per_worker);
+                                          const char* const a_max_conn_per_worker,
+                                          const char* const a_pipeline_depth_key = nullptr,
+                                          const char* const a_cluster_nodes_key = nullptr,
+                                          const char* const a_sentinels_key = nullptr, const char* const a_sentinel_master_key = nullptr,
+                                          const char* const a_subscriptions_connections_key = nullptr);
             
             virtual void SetupCURL      (const std::map<std::string, std::string>& a_config,
                                          const char* const a_max_conn_per_worker);
@@ -113,6 +139,10 @@ namespace ev
                                           const char* const a_beanstalkd_sessionless_tubes_key,
                                           ::ev::beanstalk::Config& o_config);
             
+        private: // Method(s) / Function(s)
+            
+            static DeviceBudget* Budget (const ::ev::Object::Target a_target);
+            
         }; // end of class 'SharedGlue'
 
         /**
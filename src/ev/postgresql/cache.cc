@@ -0,0 +1,265 @@
+/**
+ * @file cache.cc - PostgreSQL Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/cache.h"
+
+#include "ev/exception.h"
+
+#include <algorithm> // std::max
+
+size_t                                 ev::postgresql::Cache::max_entries_    = 0;
+int64_t                                ev::postgresql::Cache::default_ttl_ms_ = 0;
+bool                                   ev::postgresql::Cache::enabled_        = false;
+ev::postgresql::Cache::EntriesMap      ev::postgresql::Cache::entries_;
+ev::postgresql::Cache::LRUList         ev::postgresql::Cache::lru_;
+ev::postgresql::Cache::TagsMap         ev::postgresql::Cache::tags_;
+uint64_t                               ev::postgresql::Cache::generation_     = 0;
+
+/**
+ * @brief One-shot initializer.
+ *
+ * @param a_max_entries    Maximum number of cached replies.
+ * @param a_default_ttl_ms Default entry TTL, in milliseconds.
+ *
+ * @remarks PostgreSQL subscriptions must be started, see \link ev::postgresql::subscriptions::Manager::Startup \link.
+ */
+void ev::postgresql::Cache::Startup (const size_t a_max_entries, const int64_t a_default_ttl_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( true == enabled_ ) {
+        throw ev::Exception("PostgreSQL cache already configured!");
+    }
+    
+    max_entries_    = a_max_entries;
+    default_ttl_ms_ = std::max(a_default_ttl_ms, static_cast<int64_t>(0));
+    generation_     = 0;
+    enabled_        = ( max_entries_ > 0 && default_ttl_ms_ > 0 );
+}
+
+/**
+ * @brief Call this to dealloc previously allocated memory.
+ */
+void ev::postgresql::Cache::Shutdown ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( true == enabled_ && tags_.size() > 0 ) {
+        try {
+            ::ev::postgresql::subscriptions::Manager::GetInstance().Unlisten(this);
+        } catch (const ev::Exception& a_ev_exception) {
+            // ... subscriptions already shutdown ...
+        }
+    }
+    
+    Clear();
+    tags_.clear();
+    enabled_ = false;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Lookup a cached reply.
+ *
+ * @param a_key Normalized query.
+ *
+ * @return Shared, immutable, entry or nullptr if not cached or expired.
+ */
+ev::postgresql::Cache::EntryPtr ev::postgresql::Cache::Get (const std::string& a_key)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( false == enabled_ ) {
+        return nullptr;
+    }
+    
+    const auto it = entries_.find(a_key);
+    if ( entries_.end() == it ) {
+        return nullptr;
+    }
+    
+    // ... expired?
+    if ( std::chrono::steady_clock::now() >= it->second.entry_->expires_at_ ) {
+        Erase(it);
+        return nullptr;
+    }
+    
+    // ... most recently used ...
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it_);
+    
+    return it->second.entry_;
+}
+
+/**
+ * @brief Cache a reply.
+ *
+ * @param a_key        Normalized query.
+ * @param a_json       Reply.
+ * @param a_status     Reply HTTP status.
+ * @param a_tags       Channels that invalidate this entry, at least one is required.
+ * @param a_generation Value of \link Generation \link read before query was issued.
+ * @param a_ttl_ms     Entry TTL, in milliseconds, -1 to use default.
+ *
+ * @return True if reply was cached, false otherwise.
+ */
+bool ev::postgresql::Cache::Set (const std::string& a_key, const std::string& a_json, const uint16_t a_status,
+                                 const std::set<std::string>& a_tags, const uint64_t a_generation, const int64_t a_ttl_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... an invalidation arrived while query was running, reply might be stale ...
+    if ( false == enabled_ || 0 == a_tags.size() || a_generation != generation_ ) {
+        return false;
+    }
+    
+    // ... all channels must be listened to, and confirmed, otherwise an invalidation could be missed ...
+    std::set<std::string> channels;
+    for ( auto tag : a_tags ) {
+        if ( tags_.end() == tags_.find(tag) || false == ::ev::postgresql::subscriptions::Manager::GetInstance().IsListening(tag) ) {
+            channels.insert(tag);
+        }
+    }
+    if ( channels.size() > 0 ) {
+        try {
+            ::ev::postgresql::subscriptions::Manager::GetInstance().Listen(channels,
+                                                                           [this] (const std::string& a_channel, const std::string& /* a_payload */) {
+                                                                               Invalidate(a_channel);
+                                                                           },
+                                                                           this
+            );
+        } catch (const ev::Exception& a_ev_exception) {
+            // ... subscriptions not available, an entry that can't be invalidated won't be cached ...
+            return false;
+        }
+        for ( auto channel : channels ) {
+            if ( tags_.end() == tags_.find(channel) ) {
+                tags_[channel] = {};
+            }
+        }
+        // ... not confirmed yet, replies will only be cached once they are ...
+        return false;
+    }
+    
+    // ... replace previous entry, if any ...
+    const auto it = entries_.find(a_key);
+    if ( entries_.end() != it ) {
+        Erase(it);
+    }
+    
+    const int64_t ttl_ms = ( a_ttl_ms > 0 ? a_ttl_ms : default_ttl_ms_ );
+    
+    lru_.push_front(a_key);
+    entries_[a_key] = {
+        /* entry_  */ EntryPtr(new Entry(a_json, a_status, a_tags, std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms))),
+        /* lru_it_ */ lru_.begin()
+    };
+    for ( auto tag : a_tags ) {
+        tags_[tag].insert(a_key);
+    }
+    
+    // ... evict least recently used entries ...
+    while ( entries_.size() > max_entries_ ) {
+        Erase(entries_.find(lru_.back()));
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Drop all entries tagged with a channel.
+ *
+ * @param a_tag Channel name.
+ *
+ * @remarks Channel is still listened to, tags are expected to be a small set ( e.g. table names ).
+ */
+void ev::postgresql::Cache::Invalidate (const std::string& a_tag)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    generation_++;
+    
+    const auto tag_it = tags_.find(a_tag);
+    if ( tags_.end() == tag_it ) {
+        return;
+    }
+    
+    // ... erase changes tag keys ...
+    const std::set<std::string> keys = tag_it->second;
+    for ( auto key : keys ) {
+        const auto it = entries_.find(key);
+        if ( entries_.end() != it ) {
+            Erase(it);
+        }
+    }
+}
+
+/**
+ * @brief Drop all entries.
+ */
+void ev::postgresql::Cache::Clear ()
+{
+    generation_++;
+    entries_.clear();
+    lru_.clear();
+    for ( auto& it : tags_ ) {
+        it.second.clear();
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief This method will be called when PostgreSQL subscriptions connection is lost, notifications might have been missed.
+ */
+void ev::postgresql::Cache::OnPostgreSQLConnectionLost ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... nothing is cached until channels are listened to again ...
+    Clear();
+    tags_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Erase an entry.
+ *
+ * @param a_it
+ */
+void ev::postgresql::Cache::Erase (ev::postgresql::Cache::EntriesMap::iterator a_it)
+{
+    for ( auto tag : a_it->second.entry_->tags_ ) {
+        const auto tag_it = tags_.find(tag);
+        if ( tags_.end() != tag_it ) {
+            tag_it->second.erase(a_it->first);
+        }
+    }
+    lru_.erase(a_it->second.lru_it_);
+    entries_.erase(a_it);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file cache.h - PostgreSQL Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_CACHE_H_
+#define NRS_EV_POSTGRESQL_CACHE_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/postgresql/subscriptions/manager.h"
+
+#include <string> // std::string
+#include <set>    // std::set
+#include <map>    // std::map
+#include <list>   // std::list
+#include <memory> // std::shared_ptr
+#include <chrono> // std::chrono::steady_clock
+
+namespace ev
+{
+    
+    namespace postgresql
+    {
+        
+        /**
+         * @brief An opt-in, size bounded, LRU cache of PostgreSQL replies.
+         *
+         * @remarks Entries are tagged with channel names and invalidated when a 'NOTIFY' is received on any of them,
+         *          TTL is a safety net for lost notifications. Must be used from the main thread only.
+         *          An entry is only cached after all of it's channels 'LISTEN' commands are confirmed.
+         */
+        class Cache final : public osal::Singleton<Cache>, public ::ev::postgresql::subscriptions::Manager::Client
+        {
+            
+        public: // Data Type(s)
+            
+            class Entry
+            {
+                
+            public: // Const Data
+                
+                const std::string                           json_;       //!< Cached reply.
+                const uint16_t                              status_;     //!< Cached reply HTTP status.
+                const std::set<std::string>                 tags_;       //!< Channels that invalidate this entry.
+                const std::chrono::steady_clock::time_point expires_at_; //!< When this entry is no longer valid.
+                
+            public: // Constructor(s) / Destructor
+                
+                /**
+                 * @brief Default constructor.
+                 *
+                 * @param a_json
+                 * @param a_status
+                 * @param a_tags
+                 * @param a_expires_at
+                 */
+                Entry (const std::string& a_json, const uint16_t a_status, const std::set<std::string>& a_tags,
+                       const std::chrono::steady_clock::time_point& a_expires_at)
+                    : json_(a_json), status_(a_status), tags_(a_tags), expires_at_(a_expires_at)
+                {
+                    /* empty */
+                }
+                
+            }; // end of class 'Entry'
+            
+            typedef std::shared_ptr<const Entry> EntryPtr;
+            
+        private: // Data Type(s)
+            
+            typedef std::list<std::string> LRUList;
+            
+            typedef struct {
+                EntryPtr          entry_;  //!< Shared, immutable, entry.
+                LRUList::iterator lru_it_; //!< Position in LRU list.
+            } Slot;
+            
+            typedef std::map<std::string, Slot>                  EntriesMap;
+            typedef std::map<std::string, std::set<std::string>> TagsMap;
+            
+        private: // Static Data
+            
+            static size_t     max_entries_;
+            static int64_t    default_ttl_ms_;
+            static bool       enabled_;
+            static EntriesMap entries_;
+            static LRUList    lru_;
+            static TagsMap    tags_;
+            static uint64_t   generation_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const size_t a_max_entries, const int64_t a_default_ttl_ms);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool     Enabled    () const;
+            uint64_t Generation () const;
+            EntryPtr Get        (const std::string& a_key);
+            bool     Set        (const std::string& a_key, const std::string& a_json, const uint16_t a_status,
+                                 const std::set<std::string>& a_tags, const uint64_t a_generation, const int64_t a_ttl_ms = -1);
+            void     Invalidate (const std::string& a_tag);
+            void     Clear      ();
+            
+        public: // Inherited Pure Virtual Method(s) / Function(s) - from ::ev::postgresql::subscriptions::Manager::Client
+            
+            virtual void OnPostgreSQLConnectionLost ();
+            
+        private: // Method(s) / Function(s)
+            
+            void Erase (EntriesMap::iterator a_it);
+            
+        }; // end of class 'Cache'
+        
+        /**
+         * @return True if cache was started, false otherwise.
+         */
+        inline bool Cache::Enabled () const
+        {
+            return enabled_;
+        }
+        
+        /**
+         * @return Invalidations counter, it must be read before a query is issued and passed to \link Set \link.
+         */
+        inline uint64_t Cache::Generation () const
+        {
+            return generation_;
+        }
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_CACHE_H_
@@ -0,0 +1,60 @@
+/**
+ * @file copy_request.cc - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/copy_request.h"
+
+/**
+ * @brief 'COPY ... FROM STDIN' constructor.
+ *
+ * @param a_loggable_data
+ * @param a_payload       'COPY ... FROM STDIN' command.
+ * @param a_producer      Data producer, see \link ProducerCallback \link.
+ */
+ev::postgresql::CopyRequest::CopyRequest (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload,
+                                          ev::postgresql::CopyRequest::ProducerCallback a_producer)
+    : ev::postgresql::Request(a_loggable_data, a_payload),
+      direction_(ev::postgresql::CopyRequest::Direction::In), producer_(a_producer), consumer_(nullptr)
+{
+    /* empty */
+}
+
+/**
+ * @brief 'COPY ... TO STDOUT' constructor.
+ *
+ * @param a_loggable_data
+ * @param a_payload       'COPY ... TO STDOUT' command.
+ * @param a_consumer      Data consumer, see \link ConsumerCallback \link.
+ */
+ev::postgresql::CopyRequest::CopyRequest (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload,
+                                          ev::postgresql::CopyRequest::ConsumerCallback a_consumer)
+    : ev::postgresql::Request(a_loggable_data, a_payload),
+      direction_(ev::postgresql::CopyRequest::Direction::Out), producer_(nullptr), consumer_(a_consumer)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor
+ */
+ev::postgresql::CopyRequest::~CopyRequest ()
+{
+    /* empty */
+}
@@ -0,0 +1,126 @@
+/**
+ * @file copy_request.h - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_COPY_REQUEST_H_
+#define NRS_EV_POSTGRESQL_COPY_REQUEST_H_
+
+#include "ev/postgresql/request.h"
+
+#include <string>     // std::string
+#include <functional> // std::function
+
+namespace ev
+{
+    namespace postgresql
+    {
+        
+        /**
+         * @brief A request for 'COPY ... FROM STDIN' or 'COPY ... TO STDOUT', data is streamed in chunks.
+         *
+         * @remarks Callbacks are called from the hub thread.
+         */
+        class CopyRequest final : public Request
+        {
+            
+        public: // Data Type(s)
+            
+            enum class Direction : uint8_t
+            {
+                In,
+                Out
+            };
+            
+            /**
+             * @brief Called when the device is ready to send more data.
+             *
+             * @param o_chunk Next chunk of data to send, in the format expected by the 'COPY' command.
+             *
+             * @return True if a chunk was set, false when there's no more data to send.
+             *
+             * @remarks Throw an \link ev::Exception \link to abort the 'COPY' command.
+             */
+            typedef std::function<bool(std::string& o_chunk)>                          ProducerCallback;
+            
+            /**
+             * @brief Called for each row received.
+             *
+             * @param a_data   Row data, not NULL terminated, it's only valid during this call.
+             * @param a_length Row data length.
+             *
+             * @remarks Throw an \link ev::Exception \link to stop receiving data, remaining data will be discarded.
+             */
+            typedef std::function<void(const char* const a_data, const size_t a_length)> ConsumerCallback;
+            
+        public: // Const Data
+            
+            const Direction direction_;
+            
+        private: // Data
+            
+            ProducerCallback producer_;
+            ConsumerCallback consumer_;
+            
+        public: // Constructor(s) / Destructor
+            
+            CopyRequest(const Loggable::Data& a_loggable_data, const std::string& a_payload, ProducerCallback a_producer);
+            CopyRequest(const Loggable::Data& a_loggable_data, const std::string& a_payload, ConsumerCallback a_consumer);
+            virtual ~CopyRequest();
+            
+        public: // Method(s) / Function(s)
+            
+            bool Produce (std::string& o_chunk) const;
+            void Consume (const char* const a_data, const size_t a_length) const;
+            
+        }; // end of class 'CopyRequest'
+        
+        /**
+         * @brief Ask producer for the next chunk of data.
+         *
+         * @param o_chunk
+         *
+         * @return True if a chunk was set, false when there's no more data to send.
+         */
+        inline bool CopyRequest::Produce (std::string& o_chunk) const
+        {
+            if ( nullptr == producer_ ) {
+                return false;
+            }
+            return producer_(o_chunk);
+        }
+        
+        /**
+         * @brief Deliver a received row to consumer.
+         *
+         * @param a_data
+         * @param a_length
+         */
+        inline void CopyRequest::Consume (const char* const a_data, const size_t a_length) const
+        {
+            if ( nullptr != consumer_ ) {
+                consumer_(a_data, a_length);
+            }
+        }
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_COPY_REQUEST_H_
@@ -0,0 +1,77 @@
+/**
+ * @file cursor_request.cc - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/cursor_request.h"
+
+#include "ev/exception.h"
+
+#include <algorithm> // std::max
+
+/**
+ * @brief 'Declare' step constructor.
+ *
+ * @param a_loggable_data
+ * @param a_name           Cursor name.
+ * @param a_query          Cursor query.
+ * @param a_rows_per_fetch Maximum number of rows per page.
+ */
+ev::postgresql::CursorRequest::CursorRequest (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_name, const std::string& a_query,
+                                              const size_t a_rows_per_fetch)
+    : ev::postgresql::Request(a_loggable_data,
+                              "BEGIN; DECLARE " + ev::postgresql::Request::Identifier(a_name) + " NO SCROLL CURSOR FOR " + a_query + "; FETCH FORWARD " + std::to_string(std::max(a_rows_per_fetch, static_cast<size_t>(1))) + " FROM " + ev::postgresql::Request::Identifier(a_name) + ";",
+                              ev::Request::Control::Pin
+      ),
+      step_(ev::postgresql::CursorRequest::Step::Declare), rows_per_fetch_(std::max(a_rows_per_fetch, static_cast<size_t>(1)))
+{
+    /* empty */
+}
+
+/**
+ * @brief 'Fetch' or 'Close' step constructor.
+ *
+ * @param a_loggable_data
+ * @param a_step           One of \link Step \link, except 'Declare'.
+ * @param a_name           Cursor name.
+ * @param a_rows_per_fetch Maximum number of rows per page.
+ */
+ev::postgresql::CursorRequest::CursorRequest (const ::ev::Loggable::Data& a_loggable_data, const ev::postgresql::CursorRequest::Step a_step, const std::string& a_name,
+                                              const size_t a_rows_per_fetch)
+    : ev::postgresql::Request(a_loggable_data,
+                              ( ev::postgresql::CursorRequest::Step::Close == a_step
+                                    ? "CLOSE " + ev::postgresql::Request::Identifier(a_name) + "; COMMIT;"
+                                    : "FETCH FORWARD " + std::to_string(std::max(a_rows_per_fetch, static_cast<size_t>(1))) + " FROM " + ev::postgresql::Request::Identifier(a_name) + ";"
+                              ),
+                              ( ev::postgresql::CursorRequest::Step::Close == a_step ? ev::Request::Control::Unpin : ev::Request::Control::Pin )
+      ),
+      step_(a_step), rows_per_fetch_(std::max(a_rows_per_fetch, static_cast<size_t>(1)))
+{
+    if ( ev::postgresql::CursorRequest::Step::Declare == a_step ) {
+        throw ev::Exception("A cursor query is required to declare cursor '%s'!", a_name.c_str());
+    }
+}
+
+/**
+ * @brief Destructor
+ */
+ev::postgresql::CursorRequest::~CursorRequest ()
+{
+    /* empty */
+}
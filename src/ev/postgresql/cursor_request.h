@@ -0,0 +1,73 @@
+/**
+ * @file cursor_request.h - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_CURSOR_REQUEST_H_
+#define NRS_EV_POSTGRESQL_CURSOR_REQUEST_H_
+
+#include "ev/postgresql/request.h"
+
+#include <string> // std::string
+
+namespace ev
+{
+    namespace postgresql
+    {
+        
+        /**
+         * @brief A server-side cursor step, a task should issue a 'Declare', followed by zero or more 'Fetch' and a 'Close' step.
+         *
+         * @remarks The same device is pinned to the task, inside a transaction, from 'Declare' until 'Close'. If a step fails,
+         *          or if the task stops issuing steps, the device is destroyed and the server rolls back the transaction.
+         *          Each step reply is delivered to the next task step, the page is the last data object of the result
+         *          and no more rows are available when it contains less than \link rows_per_fetch_ \link rows.
+         */
+        class CursorRequest final : public Request
+        {
+            
+        public: // Data Type(s)
+            
+            enum class Step : uint8_t
+            {
+                Declare, //!< 'BEGIN', 'DECLARE' cursor and 'FETCH' first page.
+                Fetch,   //!< 'FETCH' next page.
+                Close    //!< 'CLOSE' cursor and 'COMMIT'.
+            };
+            
+        public: // Const Data
+            
+            const Step   step_;           //!< One of \link Step \link.
+            const size_t rows_per_fetch_; //!< Maximum number of rows per page.
+            
+        public: // Constructor(s) / Destructor
+            
+            CursorRequest(const Loggable::Data& a_loggable_data, const std::string& a_name, const std::string& a_query,
+                          const size_t a_rows_per_fetch = 500);
+            CursorRequest(const Loggable::Data& a_loggable_data, const Step a_step, const std::string& a_name,
+                          const size_t a_rows_per_fetch = 500);
+            virtual ~CursorRequest();
+            
+        }; // end of class 'CursorRequest'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_CURSOR_REQUEST_H_
@@ -27,6 +27,8 @@
 #include "ev/postgresql/object.h"
 #include "ev/postgresql/reply.h"
 #include "ev/postgresql/error.h"
+#include "ev/postgresql/notification.h"
+#include "ev/postgresql/replicas.h"
 
 #include "ev/exception.h"
 
@@ -51,6 +53,9 @@
 #define EV_POSTGRESQL_DEVICE_LOG_FMT "%s, %s"
 #endif
 
+const size_t ev::postgresql::Device::k_copy_chunks_per_event_ = 64;
+const int    ev::postgresql::Device::k_stream_backoff_ms_     = 5;
+
 /**
  * @brief Default constructor.
  *
@@ -59,10 +64,11 @@
  * @param a_statement_timeout
  * @param a_post_connect_queries
  * @param a_max_queries_per_conn
+ * @param a_replica              True when \p a_conn_str is a read replica connection string, see \link ev::postgresql::Replicas::Route \link.
  */
 ev::postgresql::Device::Device (const ::ev::Loggable::Data& a_loggable_data,
                                 const char* const a_conn_str, const int a_statement_timeout,
-                                const Json::Value& a_post_connect_queries, const ssize_t a_max_queries_per_conn)
+                                const Json::Value& a_post_connect_queries, const ssize_t a_max_queries_per_conn, const bool a_replica)
     : ev::Device(a_loggable_data)
 {
     context_                      = nullptr;
@@ -71,6 +77,7 @@ ev::postgresql::Device::Device (const ::ev::Loggable::Data& a_loggable_data,
     post_connect_queries_         = a_post_connect_queries;
     post_connect_queries_applied_ = false;
     max_reuse_count_              = a_max_queries_per_conn;
+    replica_                      = a_replica;
 }
 
 /**
@@ -104,23 +111,13 @@ ev::postgresql::Device::Status ev::postgresql::Device::Connect (ev::postgresql::
     // ... already connected?
     if ( nullptr != context_ ) {
 
-        // ... reset flags ...
-        const int del_rc = event_del(context_->event_);
-        if ( 0 != del_rc ) {
-            exception_callback_(ev::Exception("Error while deleting PostgreSQL event: code %d!", del_rc));
-        }
-        const int assign_rv = event_assign(context_->event_, event_base_ptr_, PQsocket(context_->connection_), EV_WRITE | EV_READ | EV_PERSIST, PostgreSQLEVCallback, context_);
-        if ( 0 != assign_rv ) {
-            exception_callback_(ev::Exception("Error while assigning PostgreSQL event: code %d!", assign_rv));
-        }
-        const int add_rv = event_add(context_->event_, nullptr);
-        if ( 0 != add_rv ) {
-            exception_callback_(ev::Exception("Error while adding PostgreSQL event: code %d!", del_rc));
-        }
-        
         // ... keep track of callback ...
         connected_callback_ = a_callback;
         
+        // ... an idle socket is never writable 'on demand', so run callback once from the event loop ...
+        Watch(EV_READ);
+        event_active(context_->event_, EV_WRITE, 0);
+        
         // ... it will be an asynchronous call ...
         return ev::postgresql::Device::Status::Async;
     }
@@ -222,8 +219,9 @@ ev::postgresql::Device::Status ev::postgresql::Device::Connect (ev::postgresql::
     }
 #endif
     
+    // ... as documented by libpq, start polling as if PQconnectPoll returned PGRES_POLLING_WRITING ...
     context_->event_ = event_new(event_base_ptr_,
-                                 fd, EV_READ | EV_WRITE | EV_PERSIST, PostgreSQLEVCallback, context_);
+                                 fd, EV_WRITE | EV_PERSIST, PostgreSQLEVCallback, context_);
     if ( nullptr == context_->event_ ) {
         last_error_msg_ = "Unable to create a new event for PostgreSQL socket!";
         PQfinish(context_->connection_);
@@ -242,6 +240,7 @@ ev::postgresql::Device::Status ev::postgresql::Device::Connect (ev::postgresql::
         connected_callback_ = nullptr;
         return ev::postgresql::Device::Status::Error;
     }
+    context_->watched_ = EV_WRITE | EV_TIMEOUT;
     
     if ( CONNECTION_STARTED != PQstatus(context_->connection_) ) {
         last_error_msg_ = PQerrorMessage(context_->connection_);
@@ -304,15 +303,64 @@ ev::postgresql::Device::Status ev::postgresql::Device::Execute (ev::postgresql::
     ev::postgresql::Device::Status rv;
     
     execute_callback_        = a_callback;
-    context_->query_         = postgresql_request->AsCString();
     context_->loggable_data_ = postgresql_request->loggable_data_;
     context_->exec_start_    = std::chrono::steady_clock::now();
+    
+    // ... per request statement timeout? ( parameterized queries can only have one statement, ...
+    // ... changing and restoring the session value would cost two extra round trips, device default applies )
+    // ... ( inside an explicit transaction block, e.g. a pinned device, 'SET LOCAL' would last until it ends, device default applies )
+    const std::vector<std::string>& params = postgresql_request->Params();
+    if ( postgresql_request->StatementTimeout() > -1 && 0 == params.size() && PQTRANS_IDLE == PQtransactionStatus(context_->connection_) ) {
+        // ... same round trip: statements sent in one query string run in an implicit transaction, ...
+        // ... 'SET LOCAL' applies to following statements only and it's reset when that transaction ends ...
+        context_->query_        = "SET LOCAL statement_timeout TO " + std::to_string(postgresql_request->StatementTimeout()) + "; ";
+        context_->skip_results_ = 1;
+    } else {
+        context_->query_        = "";
+        context_->skip_results_ = 0;
+    }
+    
+    // ... session affinity, only applied when it differs from current session ...
+    context_->skip_results_    += Configure(postgresql_request, context_->query_);
+    context_->deferred_request_ = nullptr;
+    if ( 0 == params.size() ) {
+        context_->query_ += postgresql_request->AsString();
+    } else if ( 0 != context_->query_.length() ) {
+        // ... parameterized queries can only have one statement, send it after session setup ...
+        context_->deferred_request_ = postgresql_request;
+    } else {
+        context_->query_ = postgresql_request->AsString();
+    }
+    
+    // ... 'COPY' data will be streamed by the request callbacks ...
+    context_->copy_request_ = dynamic_cast<const ev::postgresql::CopyRequest*>(postgresql_request);
+    context_->copy_state_   = CopyState::None;
+    context_->copy_eof_     = false;
+    context_->copy_chunk_   = "";
+    context_->copy_error_   = "";
+    
+    // ... rows will be published in batches, while the query is running?
+    context_->stream_request_ = ( nullptr != handler_ptr_ ? dynamic_cast<const ev::postgresql::StreamRequest*>(postgresql_request) : nullptr );
+    context_->stream_paused_  = false;
+    
+    // ... 'keep alive' request ( e.g. 'LISTEN' ), replies and notifications are delivered to handler ...
+    if ( ev::Request::Mode::KeepAlive == postgresql_request->mode_ && nullptr != handler_ptr_ ) {
+        context_->keep_alive_request_ = postgresql_request;
+        context_->keep_alive_busy_    = true;
+    } else {
+        context_->keep_alive_request_ = nullptr;
+        context_->keep_alive_busy_    = false;
+    }
 
-    // ... send the query ...
-    if ( 1 != PQsendQuery(context_->connection_, postgresql_request->AsCString()) ) {
+    // ... send the query, parameters are sent out-of-line, verbatim ...
+    const int send_rv = ( nullptr != context_->deferred_request_ ? Send(std::vector<std::string>()) : Send(params) );
+    if ( 1 != send_rv ) {
         last_error_msg_   = PQerrorMessage(context_->connection_);
         rv                = ev::postgresql::Device::Status::Error;
         execute_callback_ = nullptr;
+        context_->keep_alive_busy_  = false;
+        context_->session_set_      = false;
+        context_->deferred_request_ = nullptr;
         ev::Logger::GetInstance().Log("libpq", context_->loggable_data_,
                                       EV_POSTGRESQL_DEVICE_LOG_FMT " - %s\n\t%s",
                                       __FUNCTION__, "ERROR",
@@ -321,6 +369,13 @@ ev::postgresql::Device::Status ev::postgresql::Device::Execute (ev::postgresql::
         );
     } else {
         rv = ev::postgresql::Device::Status::Async;
+        // ... must be set right after the query is sent ...
+        if ( nullptr != context_->stream_request_ && 1 != PQsetSingleRowMode(context_->connection_) ) {
+            // ... not available, fallback to a single reply ...
+            context_->stream_request_ = nullptr;
+        }
+        // ... listen to WRITE events only until the query is flushed ...
+        Arm();
         ev::Logger::GetInstance().Log("libpq", context_->loggable_data_,
                                       EV_POSTGRESQL_DEVICE_LOG_FMT "\n\t%s",
                                       __FUNCTION__, "SENT",
@@ -335,6 +390,81 @@ ev::postgresql::Device::Status ev::postgresql::Device::Execute (ev::postgresql::
     return rv;
 }
 
+/**
+ * @brief Probe the current PostgreSQL connection by sending an empty query.
+ *
+ * @param a_callback
+ *
+ * @return One of \link ev::postgresql::Device::Status \link.
+ */
+ev::postgresql::Device::Status ev::postgresql::Device::Ping (ev::postgresql::Device::ExecuteCallback a_callback)
+{
+    // ... no connection or busy?
+    if ( nullptr == context_ || nullptr != execute_callback_ ) {
+        // ... can't probe connection ...
+        return ev::postgresql::Device::Status::Error;
+    }
+    
+    execute_callback_        = a_callback;
+    context_->query_         = "";
+    context_->loggable_data_ = loggable_data_;
+    context_->exec_start_    = std::chrono::steady_clock::now();
+    context_->skip_results_  = 0;
+    context_->copy_request_  = nullptr;
+    context_->copy_state_    = CopyState::None;
+    context_->stream_request_ = nullptr;
+    context_->keep_alive_request_ = nullptr;
+    context_->keep_alive_busy_    = false;
+    
+    // ... send an empty query, reply will be PGRES_EMPTY_QUERY ...
+    if ( 1 != PQsendQuery(context_->connection_, "") ) {
+        last_error_msg_   = PQerrorMessage(context_->connection_);
+        execute_callback_ = nullptr;
+        return ev::postgresql::Device::Status::Error;
+    }
+    
+    // ... listen to WRITE events only until the query is flushed ...
+    Arm();
+    
+    // ... reuse counter is not increased, this is not a 'real' query ...
+    return ev::postgresql::Device::Status::Async;
+}
+
+/**
+ * @brief Check how well suited this device is to execute a request.
+ *
+ * @param a_request
+ *
+ * @return One of \link ev::Device::Affinity \link.
+ *
+ * @remarks Replicas only execute read only requests while their lag is acceptable, primary executes read only requests
+ *          only as a fallback while there's a healthy replica.
+ */
+ev::Device::Affinity ev::postgresql::Device::AffinityFor (const ev::Request* a_request) const
+{
+    const ev::postgresql::Request* request = dynamic_cast<const ev::postgresql::Request*>(a_request);
+    const bool read_only = ( nullptr != request && true == request->ReadOnly() );
+    if ( true == replica_ ) {
+        if ( false == read_only || false == ev::postgresql::Replicas::GetInstance().IsHealthy(connection_string_) ) {
+            return ev::Device::Affinity::None;
+        }
+    } else if ( true == read_only && true == ev::postgresql::Replicas::GetInstance().HasHealthy() ) {
+        return ev::Device::Affinity::Fallback;
+    }
+    // ... session already configured for this request?
+    if ( nullptr != request && nullptr != context_ && true == context_->session_known_
+        &&
+        ( 0 == request->AffinityKey().length() || request->AffinityKey() == context_->affinity_key_ )
+        &&
+        ( 0 != request->SearchPath().length() ? request->SearchPath() : context_->default_search_path_ ) == context_->search_path_
+        &&
+        ( 0 != request->Role().length() ? request->Role() : context_->default_role_ ) == context_->role_
+    ) {
+        return ev::Device::Affinity::Matched;
+    }
+    return ev::Device::Affinity::Preferred;
+}
+
 /**
  * @return The last set error object, nullptr if none.
  */
@@ -428,6 +558,410 @@ void ev::postgresql::Device::Disconnect ()
 #pragma mark -
 #endif
 
+/**
+ * @brief Stream 'COPY' data, using current request callbacks.
+ *
+ * @return True when 'COPY' data transfer is finished, false when we must wait for the socket to be ready.
+ *
+ * @remarks At most \link k_copy_chunks_per_event_ \link chunks are handled per call, so other events won't starve.
+ */
+bool ev::postgresql::Device::Copy ()
+{
+    PGconn* connection = context_->connection_;
+    size_t  count      = 0;
+    
+    // ... 'COPY ... FROM STDIN' ...
+    if ( CopyState::In == context_->copy_state_ ) {
+        while ( count < k_copy_chunks_per_event_ ) {
+            // ... ask producer for next chunk?
+            if ( 0 == context_->copy_chunk_.length() && false == context_->copy_eof_ ) {
+                if ( nullptr == context_->copy_request_ || CopyRequest::Direction::In != context_->copy_request_->direction_ ) {
+                    context_->copy_error_ = "'COPY ... FROM STDIN' requires a 'COPY' request with a data producer!";
+                    context_->copy_eof_   = true;
+                } else {
+                    try {
+                        context_->copy_eof_ = ( false == context_->copy_request_->Produce(context_->copy_chunk_) );
+                    } catch (const ev::Exception& a_ev_exception) {
+                        context_->copy_error_ = a_ev_exception.what();
+                    } catch (const std::exception& a_std_exception) {
+                        context_->copy_error_ = a_std_exception.what();
+                    } catch (...) {
+                        context_->copy_error_ = STD_CPP_GENERIC_EXCEPTION_TRACE();
+                    }
+                    if ( 0 != context_->copy_error_.length() ) {
+                        // ... abort ...
+                        context_->copy_chunk_ = "";
+                        context_->copy_eof_   = true;
+                    }
+                }
+            }
+            // ... send chunk?
+            if ( context_->copy_chunk_.length() > 0 ) {
+                const int put_rv = PQputCopyData(connection, context_->copy_chunk_.c_str(), static_cast<int>(context_->copy_chunk_.length()));
+                if ( 1 == put_rv ) {
+                    // ... queued ...
+                    context_->copy_chunk_.clear();
+                    count++;
+                    continue;
+                } else if ( 0 == put_rv ) {
+                    // ... no buffer space, wait for socket to be writable ...
+                    return false;
+                }
+                // ... connection trouble ...
+                context_->copy_error_ = PQerrorMessage(connection);
+                context_->copy_state_ = CopyState::None;
+                return true;
+            }
+            // ... no more data, end it ( server will reject all data if an error message is provided ) ...
+            const int end_rv = PQputCopyEnd(connection, ( 0 == context_->copy_error_.length() ? nullptr : context_->copy_error_.c_str() ));
+            if ( 0 == end_rv ) {
+                // ... wait for socket to be writable ...
+                return false;
+            } else if ( 1 != end_rv ) {
+                // ... connection trouble ...
+                context_->copy_error_ = PQerrorMessage(connection);
+                context_->copy_state_ = CopyState::None;
+                return true;
+            }
+            context_->copy_state_ = CopyState::Flushing;
+            break;
+        }
+        if ( CopyState::In == context_->copy_state_ ) {
+            // ... let other events run, continue on next event ...
+            return false;
+        }
+    }
+    
+    // ... 'COPY ... FROM STDIN' - all data was sent ...
+    if ( CopyState::Flushing == context_->copy_state_ ) {
+        const int flush_rv = PQflush(connection);
+        if ( 1 == flush_rv ) {
+            // ... wait for socket to be writable ...
+            return false;
+        } else if ( 0 != flush_rv ) {
+            context_->copy_error_ = PQerrorMessage(connection);
+        }
+        context_->copy_state_ = CopyState::None;
+        return true;
+    }
+    
+    // ... 'COPY ... TO STDOUT' ...
+    if ( CopyState::Out == context_->copy_state_ ) {
+        while ( count < k_copy_chunks_per_event_ ) {
+            char*     buffer = nullptr;
+            const int get_rv = PQgetCopyData(connection, &buffer, /* async */ 1);
+            if ( get_rv > 0 ) {
+                // ... deliver row, unless consumer already gave up ...
+                if ( 0 == context_->copy_error_.length() ) {
+                    if ( nullptr == context_->copy_request_ || CopyRequest::Direction::Out != context_->copy_request_->direction_ ) {
+                        context_->copy_error_ = "'COPY ... TO STDOUT' requires a 'COPY' request with a data consumer!";
+                    } else {
+                        try {
+                            context_->copy_request_->Consume(buffer, static_cast<size_t>(get_rv));
+                        } catch (const ev::Exception& a_ev_exception) {
+                            context_->copy_error_ = a_ev_exception.what();
+                        } catch (const std::exception& a_std_exception) {
+                            context_->copy_error_ = a_std_exception.what();
+                        } catch (...) {
+                            context_->copy_error_ = STD_CPP_GENERIC_EXCEPTION_TRACE();
+                        }
+                    }
+                }
+                PQfreemem(buffer);
+                count++;
+            } else if ( 0 == get_rv ) {
+                // ... wait for more data to arrive ...
+                return false;
+            } else {
+                // ... -1 done or -2 connection trouble ...
+                if ( -2 == get_rv ) {
+                    context_->copy_error_ = PQerrorMessage(connection);
+                }
+                context_->copy_state_ = CopyState::None;
+                return true;
+            }
+        }
+        // ... let other events run, rows already buffered by libpq won't make socket readable, continue on next loop iteration ...
+        event_active(context_->event_, EV_READ, 0);
+        return false;
+    }
+    
+    // ... nothing to do ...
+    return true;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Collect a row of a streaming request, publishing a batch when it's full.
+ *
+ * @param a_row     Single row result, ownership is transfered to this function.
+ * @param a_elapsed Elapsed time, in milliseconds, since query was sent.
+ */
+void ev::postgresql::Device::Stream (PGresult* a_row, const int a_elapsed)
+{
+    if ( nullptr == context_->stream_batch_ ) {
+        // ... new batch, same columns ...
+        context_->stream_batch_ = PQcopyResult(a_row, PG_COPYRES_ATTRS);
+        if ( nullptr == context_->stream_batch_ ) {
+            PQclear(a_row);
+            throw ev::Exception("Unable to allocate a PostgreSQL result for a batch of rows!");
+        }
+    }
+    
+    const int row     = PQntuples(context_->stream_batch_);
+    const int columns = PQnfields(a_row);
+    for ( int column = 0 ; column < columns ; ++column ) {
+        int set_rv;
+        if ( 1 == PQgetisnull(a_row, 0, column) ) {
+            set_rv = PQsetvalue(context_->stream_batch_, row, column, nullptr, -1);
+        } else {
+            set_rv = PQsetvalue(context_->stream_batch_, row, column, PQgetvalue(a_row, 0, column), PQgetlength(a_row, 0, column));
+        }
+        if ( 0 == set_rv ) {
+            PQclear(a_row);
+            throw ev::Exception("Unable to copy PostgreSQL row %d to a batch of rows!", row);
+        }
+    }
+    PQclear(a_row);
+    
+    // ... batch is full?
+    if ( static_cast<size_t>(row + 1) >= context_->stream_request_->rows_per_batch_ ) {
+        Flush(a_elapsed);
+        // ... stop reading socket if consumer is behind ...
+        if ( true == Backlogged() ) {
+            Pause();
+        }
+    }
+}
+
+/**
+ * @brief Publish collected rows of a streaming request, if any.
+ *
+ * @param a_elapsed Elapsed time, in milliseconds, since query was sent.
+ */
+void ev::postgresql::Device::Flush (const int a_elapsed)
+{
+    if ( nullptr == context_->stream_batch_ ) {
+        return;
+    }
+    
+    ev::Result* result = new ev::Result(ev::Object::Target::PostgreSQL);
+    result->AttachDataObject(new ev::postgresql::Reply(context_->stream_batch_, static_cast<uint64_t>(a_elapsed)));
+    context_->stream_batch_ = nullptr;
+    
+    if ( nullptr == handler_ptr_ || false == handler_ptr_->OnUnhandledDataObjectReceived(this, context_->stream_request_, result) ) {
+        // ... no one collected it ...
+        delete result;
+    }
+}
+
+/**
+ * @return True when the consumer of the current streaming request is behind.
+ */
+bool ev::postgresql::Device::Backlogged () const
+{
+    if ( nullptr == context_ || nullptr == context_->stream_request_ || nullptr == handler_ptr_ ) {
+        return false;
+    }
+    return ( handler_ptr_->PendingDataObjectsCount(this, context_->stream_request_) >= context_->stream_request_->max_batches_in_flight_ );
+}
+
+/**
+ * @brief Stop reading from socket, consumer will be checked every \link k_stream_backoff_ms_ \link.
+ */
+void ev::postgresql::Device::Pause ()
+{
+    struct timeval backoff;
+    backoff.tv_sec  = 0;
+    backoff.tv_usec = k_stream_backoff_ms_ * 1000;
+    
+    context_->stream_paused_ = true;
+    
+    // ... timeout only, no READ or WRITE events ...
+    Watch(0, &backoff);
+}
+
+/**
+ * @brief Resume reading from socket.
+ */
+void ev::postgresql::Device::Resume ()
+{
+    context_->stream_paused_ = false;
+    
+    // ... rows already buffered by libpq are collected by the caller, in this same event ...
+    Watch(EV_READ);
+}
+
+/**
+ * @brief Arm libevent interest for current state, WRITE events are only listened to while there's output pending.
+ *
+ * @remarks Pending output is flushed, as required by libpq in non blocking mode.
+ */
+void ev::postgresql::Device::Arm ()
+{
+    short flags = EV_READ;
+    if ( CopyState::In == context_->copy_state_ || CopyState::Flushing == context_->copy_state_ ) {
+        // ... 'COPY ... FROM STDIN' data is produced when socket is writable ...
+        flags |= EV_WRITE;
+    } else if ( 1 == PQflush(context_->connection_) ) {
+        // ... output buffer not empty yet ...
+        flags |= EV_WRITE;
+    } // else { /* ... errors will be reported when reading ... */ }
+    Watch(flags);
+}
+
+/**
+ * @brief Update libevent interest, event is only re-armed if flags or timeout changed.
+ *
+ * @param a_flags   EV_READ and / or EV_WRITE, 0 for timeout only.
+ * @param a_timeout Optional timeout.
+ */
+void ev::postgresql::Device::Watch (const short a_flags, const struct timeval* a_timeout)
+{
+    if ( a_flags == context_->watched_ && nullptr == a_timeout ) {
+        // ... already armed, without a timeout ...
+        return;
+    }
+    const int del_rc = event_del(context_->event_);
+    if ( 0 != del_rc ) {
+        exception_callback_(ev::Exception("Error while deleting PostgreSQL event: code %d!", del_rc));
+    }
+    const int assign_rv = event_assign(context_->event_, event_base_ptr_, PQsocket(context_->connection_), a_flags | EV_PERSIST, PostgreSQLEVCallback, context_);
+    if ( 0 != assign_rv ) {
+        exception_callback_(ev::Exception("Error while assigning PostgreSQL event: code %d!", assign_rv));
+    }
+    const int add_rv = event_add(context_->event_, a_timeout);
+    if ( 0 != add_rv ) {
+        exception_callback_(ev::Exception("Error while adding PostgreSQL event: code %d!", add_rv));
+    }
+    context_->watched_ = ( nullptr != a_timeout ? ( a_flags | EV_TIMEOUT ) : a_flags );
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Deliver all pending asynchronous notifications, as a single result, to the current 'keep alive' request handler.
+ */
+void ev::postgresql::Device::Notify ()
+{
+    ev::Result* result = nullptr;
+    PGnotify*   notify;
+    while ( nullptr != ( notify = PQnotifies(context_->connection_) ) ) {
+        if ( nullptr == result ) {
+            result = new ev::Result(ev::Object::Target::PostgreSQL);
+        }
+        result->AttachDataObject(new ev::postgresql::Notification(notify));
+        PQfreemem(notify);
+    }
+    // ... nothing to deliver?
+    if ( nullptr == result ) {
+        return;
+    }
+    if ( nullptr == handler_ptr_ || false == handler_ptr_->OnUnhandledDataObjectReceived(this, context_->keep_alive_request_, result) ) {
+        delete result;
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Send current query.
+ *
+ * @param a_params Out-of-line query parameters, $1 ... $n, sent verbatim, empty if none.
+ *
+ * @return 1 if query was sent, 0 otherwise.
+ */
+int ev::postgresql::Device::Send (const std::vector<std::string>& a_params)
+{
+    if ( 0 == a_params.size() ) {
+        return PQsendQuery(context_->connection_, context_->query_.c_str());
+    }
+    std::vector<const char*> values;
+    std::vector<int>         lengths;
+    values.reserve(a_params.size());
+    lengths.reserve(a_params.size());
+    for ( auto& param : a_params ) {
+        values.push_back(param.c_str());
+        lengths.push_back(static_cast<int>(param.length()));
+    }
+    // ... libpq copies values to it's output buffer, they don't need to outlive this call ...
+    return PQsendQueryParams(context_->connection_, context_->query_.c_str(), static_cast<int>(a_params.size()),
+                             /* paramTypes   */ nullptr, values.data(), lengths.data(),
+                             /* paramFormats */ nullptr, /* resultFormat */ 0
+    );
+}
+
+/**
+ * @brief Append the statements required to configure this session for a request, if any.
+ *
+ * @param a_request
+ * @param o_query   Statements are appended to this query.
+ *
+ * @return Number of statements appended.
+ *
+ * @remarks Session state is only trusted again when the query that changed it is committed, see \link session_known_ \link.
+ */
+size_t ev::postgresql::Device::Configure (const ev::postgresql::Request* a_request, std::string& o_query)
+{
+    const bool keyed = ( 0 != a_request->AffinityKey().length() || 0 != a_request->SearchPath().length() || 0 != a_request->Role().length() );
+    // ... inside a transaction block the session belongs to it's owner, requests without affinity don't change it ...
+    if ( false == keyed && PQTRANS_IDLE != PQtransactionStatus(context_->connection_) ) {
+        return 0;
+    }
+    const std::string& search_path = ( 0 != a_request->SearchPath().length() ? a_request->SearchPath() : context_->default_search_path_ );
+    const std::string& role        = ( 0 != a_request->Role().length()       ? a_request->Role()       : context_->default_role_        );
+    size_t count = 0;
+    if ( false == context_->session_known_ || search_path != context_->search_path_ ) {
+        if ( 0 != a_request->SearchPath().length() ) {
+            // ... request supplied, quote each schema name ...
+            std::string schemas;
+            size_t      start = 0;
+            while ( start <= search_path.length() ) {
+                size_t end = search_path.find(',', start);
+                if ( std::string::npos == end ) {
+                    end = search_path.length();
+                }
+                const size_t first = search_path.find_first_not_of(" \t", start);
+                const size_t last  = search_path.find_last_not_of(" \t", end > 0 ? end - 1 : 0);
+                if ( std::string::npos != first && first < end && std::string::npos != last && last >= first ) {
+                    schemas += ( 0 != schemas.length() ? ", " : "" ) + ev::postgresql::Request::Identifier(search_path.substr(first, last - first + 1));
+                }
+                start = end + 1;
+            }
+            o_query += "SET search_path TO " + ( 0 != schemas.length() ? schemas : "''" ) + "; ";
+        } else {
+            // ... device default, as reported by the server, it's already a valid list ...
+            o_query += "SET search_path TO " + search_path + "; ";
+        }
+        count++;
+    }
+    if ( false == context_->session_known_ || role != context_->role_ ) {
+        o_query += "SET ROLE " + ev::postgresql::Request::Identifier(role) + "; ";
+        count++;
+    }
+    if ( true == keyed ) {
+        context_->affinity_key_ = a_request->AffinityKey();
+    }
+    if ( count > 0 ) {
+        context_->search_path_   = search_path;
+        context_->role_          = role;
+        context_->session_known_ = false;
+        context_->session_set_   = true;
+    }
+    return count;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
 /**
  * @brief
  *
@@ -440,6 +974,15 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
     PostgreSQLContext*      context = static_cast<PostgreSQLContext*>(a_arg);
     ev::postgresql::Device* device  = static_cast<ev::postgresql::Device*>(context->device_ptr_);
     
+    // ... socket reads paused, waiting for stream consumer?
+    if ( true == context->stream_paused_ ) {
+        if ( true == device->Backlogged() ) {
+            // ... still behind, check again later ...
+            return;
+        }
+        device->Resume();
+    }
+    
     PostgresPollingStatusType polling_status_type = PQconnectPoll(context->connection_);
     
     if ( PGRES_POLLING_READING == polling_status_type || PGRES_POLLING_WRITING == polling_status_type ) {
@@ -459,10 +1002,11 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
          */
         if ( CONNECTION_MADE == PQstatus(context->connection_) && EV_WRITE == ( a_flags & EV_WRITE ) ) {
             polling_status_type = PQconnectPoll(context->connection_);
-            if ( PGRES_POLLING_READING == polling_status_type || PGRES_POLLING_WRITING == polling_status_type ) {
-                // ... event is always set ...
-                return;
-            }
+        }
+        if ( PGRES_POLLING_READING == polling_status_type || PGRES_POLLING_WRITING == polling_status_type ) {
+            // ... wait only for what libpq asked for ...
+            device->Watch(( PGRES_POLLING_READING == polling_status_type ? EV_READ : EV_WRITE ), &context->connection_timeout_);
+            return;
         }
     }
     
@@ -504,6 +1048,21 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
         return;
     }
 
+    // ... pending output ( query or parameters ) and socket is writable?
+    if ( EV_WRITE == ( a_flags & EV_WRITE ) && CopyState::None == context->copy_state_ ) {
+        const int flush_rv = PQflush(context->connection_);
+        if ( -1 == flush_rv ) {
+            // ... keep track of error message ...
+            device->last_error_msg_ = PQerrorMessage(context->connection_);
+            // ... disconnect device ...
+            device->Disconnect();
+            // ... nothing else to do ...
+            return;
+        }
+        // ... stop listening to WRITE events as soon as all output is sent ...
+        device->Watch(( 1 == flush_rv ? EV_READ | EV_WRITE : EV_READ ));
+    }
+    
     // ... read in all data that is currently waiting for us ...
     const int c_rv = PQconsumeInput(context->connection_);
     if ( 1 != c_rv ) {
@@ -518,6 +1077,22 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
         }
     }
     
+    // ... asynchronous notifications ( 'LISTEN' )?
+    if ( nullptr != context->keep_alive_request_ ) {
+        device->Notify();
+    }
+    
+    // ... 'COPY' sub-protocol in progress?
+    if ( nullptr != device->execute_callback_ && CopyState::None != context->copy_state_ ) {
+        const bool copied = device->Copy();
+        // ... WRITE events only while there's 'COPY' data to send ...
+        device->Arm();
+        if ( false == copied ) {
+            // ... more data to send or to receive, wait for next event ...
+            return;
+        }
+    }
+    
     // ... this must be always called ...
     if ( 0 != PQisBusy(context->connection_) ) {
         // ... connection would block, so we wait for more data to arrive ...
@@ -529,7 +1104,8 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
 
     // ... connection event?
     if ( true == call_connection_callback ) {
-        // ... connection established ...
+        // ... connection established, drop connection timeout and WRITE events ...
+        device->Watch(EV_READ);
         if ( device->statement_timeout_ > -1 && false == device->context_->statement_timeout_set_ ) {
             ExecStatusType post_connect_query_exec_status = PGRES_FATAL_ERROR;
             // ... set statement timeout ...
@@ -578,10 +1154,32 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
                 return;
             }
         }
+        // ... session defaults, restored for requests without affinity ...
+        // ... ( read only once per connection, a reused session may have been changed by a previous request ) ...
+        if ( false == context->session_defaults_read_ ) {
+            PGresult* session_result = PQexec(context->connection_, "SELECT current_setting('search_path'), current_user;");
+            if ( nullptr == session_result || PGRES_TUPLES_OK != PQresultStatus(session_result) || 1 != PQntuples(session_result) ) {
+                device->exception_callback_(ev::Exception("Error while reading PostgreSQL session defaults: %s!",
+                                                          nullptr != session_result ? PQresStatus(PQresultStatus(session_result)) : PQerrorMessage(context->connection_)
+                                                         )
+                                            );
+                if ( nullptr != session_result ) {
+                    PQclear(session_result);
+                }
+                return;
+            }
+            context->default_search_path_   = PQgetvalue(session_result, 0, 0);
+            context->default_role_          = PQgetvalue(session_result, 0, 1);
+            context->search_path_           = context->default_search_path_;
+            context->role_                  = context->default_role_;
+            context->session_known_         = true;
+            context->session_defaults_read_ = true;
+            PQclear(session_result);
+        }
         // ... notify ...
         device->connected_callback_(ev::Device::ConnectionStatus::Connected, device);
         device->connected_callback_ = nullptr;
-    } else if ( nullptr != device->execute_callback_ ) {
+    } else if ( nullptr != device->execute_callback_ || true == context->keep_alive_busy_ ) {
 
         // ... alloc result ...
         if ( nullptr == device->context_->pending_result_ ) {
@@ -592,19 +1190,42 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
 
         // ... data event?
         PGresult* postgresql_result;
-        while ( nullptr != ( postgresql_result = PQgetResult(context->connection_) ) ) {
+        while ( true ) {
+            
+            // ... this must be always called, PQgetResult would block ...
+            if ( 0 != PQisBusy(context->connection_) ) {
+                // ... connection would block, so we wait for more data to arrive ...
+                finished = false;
+                break;
+            }
+            
+            if ( nullptr == ( postgresql_result = PQgetResult(context->connection_) ) ) {
+                // ... no more results ...
+                break;
+            }
+            
             try {
 
-                // ... this must be always called ...
-                if ( nullptr == postgresql_result && 0 != PQisBusy(context->connection_) ) {
-                    // ... connection would block, so we wait for more data to arrive ...
-                    finished = false;
-                    break;
-                }
-                
                 const ExecStatusType result_status = PQresultStatus(postgresql_result);
                 
                 const int elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - device->context_->exec_start_).count());
+                
+                // ... streaming?
+                if ( nullptr != device->context_->stream_request_ ) {
+                    if ( PGRES_SINGLE_TUPLE == result_status ) {
+                        // ... collect row, ownership is transfered ...
+                        device->Stream(postgresql_result, elapsed);
+                        postgresql_result = nullptr;
+                        if ( true == device->context_->stream_paused_ ) {
+                            // ... stop reading, consumer is behind ...
+                            finished = false;
+                            break;
+                        }
+                        continue;
+                    }
+                    // ... final reply or error, publish pending rows first ...
+                    device->Flush(elapsed);
+                }
 
                 ev::Logger::GetInstance().Log("libpq", device->context_->loggable_data_,
                                               EV_POSTGRESQL_DEVICE_LOG_FMT ", %ums\n\t%s",
@@ -612,8 +1233,28 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
                                               device->context_->query_.c_str()
                 );
                 
-                if ( ( PGRES_COMMAND_OK != result_status ) && ( PGRES_TUPLES_OK != result_status ) ) {
-                    // ... failed ...
+                if ( PGRES_COPY_IN == result_status || PGRES_COPY_OUT == result_status ) {
+                    // ... switch to 'COPY' sub-protocol ...
+                    PQclear(postgresql_result);
+                    postgresql_result = nullptr;
+                    device->context_->copy_state_ = ( PGRES_COPY_IN == result_status ? CopyState::In : CopyState::Out );
+                    const bool copied = device->Copy();
+                    device->Arm();
+                    if ( false == copied || 0 != PQisBusy(context->connection_) ) {
+                        // ... wait for next event ...
+                        finished = false;
+                        break;
+                    }
+                    // ... 'COPY' command result is next ...
+                    continue;
+                }
+                
+                if ( device->context_->skip_results_ > 0 && PGRES_COMMAND_OK == result_status ) {
+                    // ... reply to a statement not requested by caller ( e.g. 'SET LOCAL' ), drop it ...
+                    device->context_->skip_results_--;
+                } else if ( ( PGRES_COMMAND_OK != result_status ) && ( PGRES_TUPLES_OK != result_status ) ) {
+                    // ... failed, session changes sent with it were rolled back ...
+                    device->context_->session_set_ = false;
                     device->context_->pending_result_->AttachDataObject(new ev::postgresql::Reply(result_status, PQresStatus(result_status), elapsed));
                 } else {
                     // ... succeeded ....
@@ -651,6 +1292,35 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
             
         }
         
+        // ... 'COPY' aborted by a callback or by a connection error?
+        if ( true == finished && 0 != device->context_->copy_error_.length() && 0 == device->last_error_msg_.length() ) {
+            device->last_error_msg_ = device->context_->copy_error_;
+        }
+        
+        // ... session setup done, send deferred parameterized query now?
+        if ( true == finished && nullptr != device->context_->deferred_request_ ) {
+            const ev::postgresql::Request* deferred_request = device->context_->deferred_request_;
+            device->context_->deferred_request_ = nullptr;
+            if ( 0 == device->last_error_msg_.length() && 0 == device->context_->pending_result_->DataObjectsCount() ) {
+                device->context_->query_        = deferred_request->AsString();
+                device->context_->skip_results_ = 0;
+                if ( 1 == device->Send(deferred_request->Params()) ) {
+                    if ( nullptr != device->context_->stream_request_ && 1 != PQsetSingleRowMode(context->connection_) ) {
+                        device->context_->stream_request_ = nullptr;
+                    }
+                    device->Arm();
+                    return;
+                }
+                device->last_error_msg_ = PQerrorMessage(context->connection_);
+            }
+        }
+        
+        // ... session changes are only trusted if they were committed ...
+        if ( true == finished && true == device->context_->session_set_ ) {
+            device->context_->session_known_ = ( 0 == device->last_error_msg_.length() && PQTRANS_IDLE == PQtransactionStatus(context->connection_) );
+            device->context_->session_set_   = false;
+        }
+        
         const int elapsed = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - device->context_->exec_start_).count());
 
         // ... no errors?
@@ -695,28 +1365,38 @@ void ev::postgresql::Device::PostgreSQLEVCallback (evutil_socket_t /* a_fd */, s
         }
         
         // ... notify caller ...
-        device->execute_callback_(device->last_error_msg_.length() > 0 ? ev::Device::ExecutionStatus::Error : ev::Device::ExecutionStatus::Ok, device->context_->pending_result_);
-        device->execute_callback_ = nullptr;
+        if ( nullptr != device->execute_callback_ ) {
+            device->execute_callback_(device->last_error_msg_.length() > 0 ? ev::Device::ExecutionStatus::Error : ev::Device::ExecutionStatus::Ok, device->context_->pending_result_);
+            device->execute_callback_ = nullptr;
+        } else {
+            // ... 'keep alive' request, no one is waiting for it, deliver reply to handler ...
+            ev::Result* result = device->context_->pending_result_;
+            if ( 0 != device->last_error_msg_.length() ) {
+                result->AttachDataObject(new ev::postgresql::Error(device->last_error_msg_));
+            }
+            device->context_->keep_alive_busy_ = false;
+            if ( nullptr == device->handler_ptr_ || false == device->handler_ptr_->OnUnhandledDataObjectReceived(device, device->context_->keep_alive_request_, result) ) {
+                delete result;
+            }
+            // ... notifications received while waiting for reply ...
+            device->Notify();
+        }
         device->context_->pending_result_ = nullptr;
         device->context_->query_  = "";
+        device->context_->skip_results_ = 0;
+        device->context_->copy_request_ = nullptr;
+        device->context_->copy_state_   = CopyState::None;
+        device->context_->copy_chunk_   = "";
+        device->context_->copy_error_   = "";
+        device->context_->stream_request_ = nullptr;
+        device->context_->stream_paused_  = false;
         if ( true == device->Tracked() ) {
-            // ... remove WRITE flag ....
-            const int del_rc = event_del(device->context_->event_);
-            if ( 0 != del_rc ) {
-                device->exception_callback_(ev::Exception("Error while deleting PostgreSQL event: code %d!", del_rc));
-            }
-            const int assign_rv = event_assign(device->context_->event_, device->event_base_ptr_, PQsocket(device->context_->connection_), EV_READ | EV_PERSIST, PostgreSQLEVCallback, device->context_);
-            if ( 0 != assign_rv ) {
-                device->exception_callback_(ev::Exception("Error while assigning PostgreSQL event: code %d!", assign_rv));
-            }
-            const int add_rv = event_add(device->context_->event_, nullptr);
-            if ( 0 != add_rv ) {
-                device->exception_callback_(ev::Exception("Error while adding PostgreSQL event: code %d!", add_rv));
-            }
+            // ... idle, READ only ( notifications or connection lost ), unless a callback already sent a new query ...
+            device->Arm();
         } else {
             delete device;
         }
-    } else {
+    } else if ( nullptr == context->keep_alive_request_ ) {
         device->last_error_msg_ = "Unexpected callback!";
         device->Disconnect();
     }
@@ -24,9 +24,13 @@
 
 #include "ev/device.h"
 
+#include "ev/postgresql/copy_request.h"
+#include "ev/postgresql/stream_request.h"
+
 #include "json/json.h"
 
 #include <string>     // std::string
+#include <vector>     // std::vector
 
 #include <stdlib.h>
 
@@ -45,6 +49,16 @@ namespace ev
         class Device : public ev::Device
         {
             
+        private: // Data Type(s)
+            
+            enum class CopyState : uint8_t
+            {
+                None,     //!< Not in 'COPY' sub-protocol.
+                In,       //!< 'COPY ... FROM STDIN', sending data.
+                Flushing, //!< 'COPY ... FROM STDIN', all data sent, waiting for output buffer to be flushed.
+                Out       //!< 'COPY ... TO STDOUT', receiving data.
+            };
+            
         private: // Data
             
             class PostgreSQLContext
@@ -62,6 +76,27 @@ namespace ev
                 bool                                  statement_timeout_set_; //!<
                 Result*                               pending_result_;        //!<
                 std::chrono::steady_clock::time_point exec_start_;
+                size_t                                skip_results_;          //!< Number of leading replies that were not requested by caller.
+                const CopyRequest*                    copy_request_;          //!< Current 'COPY' request, nullptr if none.
+                CopyState                             copy_state_;            //!< One of \link CopyState \link.
+                std::string                           copy_chunk_;            //!< Pending 'COPY ... FROM STDIN' chunk, not yet accepted by libpq.
+                bool                                  copy_eof_;              //!< True when producer has no more data.
+                std::string                           copy_error_;            //!< 'COPY' error message, empty if none.
+                const StreamRequest*                  stream_request_;        //!< Current streaming request, nullptr if none.
+                PGresult*                             stream_batch_;          //!< Rows collected for next batch, nullptr if none.
+                bool                                  stream_paused_;         //!< True while socket reads are paused, waiting for consumer.
+                const ev::Request*                    keep_alive_request_;    //!< Current 'keep alive' request, replies and notifications are delivered to handler, nullptr if none.
+                bool                                  keep_alive_busy_;       //!< True while a 'keep alive' request command is running.
+                short                                 watched_;               //!< Libevent flags currently armed, without EV_PERSIST, EV_TIMEOUT if a timeout is set.
+                std::string                           default_search_path_;   //!< Session 'search_path' after connect.
+                std::string                           default_role_;          //!< Session role after connect.
+                bool                                  session_defaults_read_; //!< True when session defaults were read, after first connect.
+                std::string                           affinity_key_;          //!< Affinity key of the last request that configured this session, empty if none.
+                std::string                           search_path_;           //!< Current session 'search_path'.
+                std::string                           role_;                  //!< Current session role.
+                bool                                  session_known_;         //!< False if session state is unknown, e.g. changed by a failed or uncommitted query.
+                bool                                  session_set_;           //!< True while running a query that changes session state.
+                const Request*                        deferred_request_;      //!< Parameterized request to send after session setup, nullptr if none.
 
                 
             public: // Constructor(s) / Destructor
@@ -82,6 +117,20 @@ namespace ev
                     statement_timeout_set_      = false;
                     pending_result_             = nullptr;
                     exec_start_                 = std::chrono::steady_clock::now();
+                    skip_results_               = 0;
+                    copy_request_               = nullptr;
+                    copy_state_                 = CopyState::None;
+                    copy_eof_                   = false;
+                    stream_request_             = nullptr;
+                    stream_batch_               = nullptr;
+                    stream_paused_              = false;
+                    keep_alive_request_         = nullptr;
+                    keep_alive_busy_            = false;
+                    watched_                    = 0;
+                    session_known_              = false;
+                    session_set_                = false;
+                    deferred_request_           = nullptr;
+                    session_defaults_read_      = false;
                 }
                 
                 /**
@@ -96,6 +145,9 @@ namespace ev
                     if ( nullptr != pending_result_ ) {
                         delete pending_result_;
                     }
+                    if ( nullptr != stream_batch_ ) {
+                        PQclear(stream_batch_);
+                    }
                 }
                 
             };
@@ -105,12 +157,18 @@ namespace ev
             int                statement_timeout_;            //!< PostgreSQL statement timeout.
             Json::Value        post_connect_queries_;         //!<
             bool               post_connect_queries_applied_; //!<
+            bool               replica_;                      //!< True when connected to a read replica, see \link Replicas \link.
 
+        public: // Static Const Data
+            
+            static const size_t k_copy_chunks_per_event_;
+            static const int    k_stream_backoff_ms_;
+            
         public: // Constructor(s) / Destructor
             
             Device (const Loggable::Data& a_loggable_data,
                     const char* const a_conn_str, const int a_statement_timeout, const Json::Value& a_post_connect_queries,
-                    const ssize_t a_max_queries_per_conn);
+                    const ssize_t a_max_queries_per_conn, const bool a_replica = false);
             virtual ~Device ();
             
         public: // Inherited Pure Virtual Method(s) / Function(s)
@@ -120,9 +178,26 @@ namespace ev
             virtual Status Execute         (ExecuteCallback a_callback, const ev::Request* a_request);
             virtual Error* DetachLastError ();
             
+        public: // Inherited Virtual Method(s) / Function(s)
+            
+            virtual Status   Ping        (ExecuteCallback a_callback);
+            virtual Affinity AffinityFor (const ev::Request* a_request) const;
+            
         private: // Method(s) / Function(s)
             
             void Disconnect ();
+            bool Copy       ();
+            void Stream     (PGresult* a_row, const int a_elapsed);
+            void Flush      (const int a_elapsed);
+            bool Backlogged () const;
+            void Pause      ();
+            void Resume     ();
+            void Notify     ();
+            void Arm        ();
+            void Watch      (const short a_flags, const struct timeval* a_timeout = nullptr);
+            int  Send       (const std::vector<std::string>& a_params);
+            
+            size_t Configure (const Request* a_request, std::string& o_query);
             
         private: // Static Callbacks
             
@@ -24,10 +24,15 @@
 #include "ev/postgresql/request.h"
 #include "ev/postgresql/reply.h"
 #include "ev/postgresql/error.h"
+#include "ev/postgresql/cache.h"
 
 #include <algorithm>
 
-#include <sstream>
+#include <memory>  // std::shared_ptr
+#include <vector>  // std::vector
+#include <utility> // std::move
+
+const std::string ev::postgresql::JSONAPI::k_query_ = "SELECT response,http_status FROM jsonapi($1, $2, $3, $4, $5, $6, $7, $8, $9);";
 
 /**
  * @brief Default constructor.
@@ -80,16 +85,45 @@ void ::ev::postgresql::JSONAPI::Get (const ::ev::Loggable::Data& a_loggable_data
                                      const std::string& a_uri, ::ev::postgresql::JSONAPI::Callback a_callback,
                                      std::string* o_query)
 {
-    /*
-     * Build Query
-     */
-    std::stringstream ss;
-    ss << "SELECT response,http_status FROM jsonapi('GET', '" << a_uri << "', '', '" << user_id_ << "', '" << company_id_ << "', '" << company_schema_ << "', '" << sharded_schema_ << "', '" << accounting_schema_ << "', '" << accounting_prefix_ << "');";
-    
-    /*
-     * Run query ( asynchronously )...
-     */
-    AsyncQuery(a_loggable_data, ss.str(), a_callback, o_query);
+    AsyncQuery(a_loggable_data, "GET", a_uri, "", /* a_read_only */ true, a_callback, o_query);
+}
+
+/**
+ * @brief An API to GET data that changes rarely, replies are cached, see \link ev::postgresql::Cache \link.
+ *
+ * @param a_uri
+ * @param a_tags   Channels that invalidate cached reply, when 'NOTIFY' is received on any of them.
+ * @param a_ttl_ms Cached reply TTL, in milliseconds, -1 to use cache default.
+ * @param a_callback
+ *
+ * @param o_query
+ */
+void ::ev::postgresql::JSONAPI::Get (const std::string& a_uri, const std::set<std::string>& a_tags, const int64_t a_ttl_ms,
+                                     ::ev::postgresql::JSONAPI::Callback a_callback,
+                                     std::string* o_query)
+{
+    Get(loggable_data_ref_, a_uri, a_tags, a_ttl_ms, a_callback, o_query);
+}
+
+/**
+ * @brief An API to GET data that changes rarely, replies are cached, see \link ev::postgresql::Cache \link.
+ *
+ * @param a_loggable_data
+ * @param a_uri
+ * @param a_tags   Channels that invalidate cached reply, when 'NOTIFY' is received on any of them.
+ * @param a_ttl_ms Cached reply TTL, in milliseconds, -1 to use cache default.
+ * @param a_callback
+ *
+ * @param o_query
+ *
+ * @remarks When reply is cached, callback is called before this function returns.
+ */
+void ::ev::postgresql::JSONAPI::Get (const ::ev::Loggable::Data& a_loggable_data,
+                                     const std::string& a_uri, const std::set<std::string>& a_tags, const int64_t a_ttl_ms,
+                                     ::ev::postgresql::JSONAPI::Callback a_callback,
+                                     std::string* o_query)
+{
+    AsyncQuery(a_loggable_data, "GET", a_uri, "", /* a_read_only */ true, a_callback, o_query, &a_tags, a_ttl_ms);
 }
 
 /**
@@ -121,19 +155,7 @@ void ::ev::postgresql::JSONAPI::Post (const ::ev::Loggable::Data& a_loggable_dat
                                       const std::string& a_uri, const std::string& a_body, ::ev::postgresql::JSONAPI::Callback a_callback,
                                       std::string* o_query)
 {
-    /*
-     * Build Query
-     */
-    std::string body;
-    SQLEscape(a_body, body);
-
-    std::stringstream ss;
-    ss << "SELECT response,http_status FROM jsonapi('POST','" << a_uri << "','" << body <<  "','" << user_id_ << "', '" << company_id_ << "', '" << company_schema_ << "', '" << sharded_schema_ << "', '" << accounting_schema_ << "', '" << accounting_prefix_ << "');";
-    
-    /*
-     * Run query ( asynchronously )...
-     */
-    AsyncQuery(a_loggable_data, ss.str(), a_callback, o_query);
+    AsyncQuery(a_loggable_data, "POST", a_uri, a_body, /* a_read_only */ false, a_callback, o_query);
 }
 
 /**
@@ -165,19 +187,7 @@ void ::ev::postgresql::JSONAPI::Patch (const ::ev::Loggable::Data& a_loggable_da
                                        const std::string& a_uri, const std::string& a_body, ::ev::postgresql::JSONAPI::Callback a_callback,
                                        std::string* o_query)
 {
-    /*
-     * Build Query
-     */
-    std::string body;
-    SQLEscape(a_body, body);
-
-    std::stringstream ss;
-    ss << "SELECT response,http_status FROM jsonapi('PATCH','" << a_uri << "','" << body <<  "','" << user_id_ << "', '" << company_id_ << "', '" << company_schema_ << "', '" << sharded_schema_ << "', '" << accounting_schema_ << "', '" << accounting_prefix_ << "');";
-
-    /*
-     * Run query ( asynchronously )...
-     */
-    AsyncQuery(a_loggable_data, ss.str(), a_callback, o_query);
+    AsyncQuery(a_loggable_data, "PATCH", a_uri, a_body, /* a_read_only */ false, a_callback, o_query);
 }
 
 /**
@@ -210,19 +220,7 @@ void ::ev::postgresql::JSONAPI::Delete (const ::ev::Loggable::Data& a_loggable_d
                                         const std::string& a_uri, const std::string& a_body, ::ev::postgresql::JSONAPI::Callback a_callback,
                                         std::string* o_query)
 {
-    /*
-     * Build Query
-     */
-    std::string body;
-    SQLEscape(a_body, body);
-
-    std::stringstream ss;
-    ss << "SELECT response,http_status FROM jsonapi('DELETE','" << a_uri << "','" << body <<  "','" << user_id_ << "', '" << company_id_ << "', '" << company_schema_ << "', '" << sharded_schema_ << "', '" << accounting_schema_ << "', '" << accounting_prefix_ << "');";
-    
-    /*
-     * Run query ( asynchronously )...
-     */
-    AsyncQuery(a_loggable_data, ss.str(), a_callback, o_query);
+    AsyncQuery(a_loggable_data, "DELETE", a_uri, a_body, /* a_read_only */ false, a_callback, o_query);
 }
 
 #ifdef __APPLE__
@@ -233,23 +231,77 @@ void ::ev::postgresql::JSONAPI::Delete (const ::ev::Loggable::Data& a_loggable_d
  * @brief Issue a PG request, using a task.
  *
  * @param a_loggable_data
- * @param a_query
+ * @param a_method
+ * @param a_uri
+ * @param a_body
+ * @param a_read_only    True when query doesn't write, so it can be routed to a replica.
  * @param a_callback
  *
- * @param o_query
+ * @param o_query        Parameterized query.
+ *
+ * @param a_cache_tags   Channels that invalidate a cached reply, nullptr if reply should not be cached.
+ * @param a_cache_ttl_ms Cached reply TTL, in milliseconds, -1 to use cache default.
  */
 void ::ev::postgresql::JSONAPI::AsyncQuery (const ::ev::Loggable::Data& a_loggable_data,
-                                            const std::string a_query, ::ev::postgresql::JSONAPI::Callback a_callback,
-                                            std::string* o_query)
+                                            const char* const a_method, const std::string& a_uri, const std::string& a_body, const bool a_read_only,
+                                            ::ev::postgresql::JSONAPI::Callback a_callback,
+                                            std::string* o_query,
+                                            const std::set<std::string>* a_cache_tags, const int64_t a_cache_ttl_ms)
 {
-    const std::string query = a_query;
     if ( nullptr != o_query ) {
-        (*o_query) = query;
+        (*o_query) = k_query_;
     }
     
-    NewTask([this, query, a_loggable_data] () -> ::ev::Object* {
+    // ... arguments are sent out-of-line and verbatim, no escaping, body is copied only once ...
+    const std::shared_ptr<std::vector<std::string>> params = std::make_shared<std::vector<std::string>>();
+    params->reserve(9);
+    params->push_back(a_method);
+    params->push_back(a_uri);
+    params->push_back(a_body);
+    params->push_back(user_id_);
+    params->push_back(company_id_);
+    params->push_back(company_schema_);
+    params->push_back(sharded_schema_);
+    params->push_back(accounting_schema_);
+    params->push_back(accounting_prefix_);
+    
+    const std::string uri = a_uri;
+    
+    // ... cached reply?
+    const bool            cacheable  = ( nullptr != a_cache_tags && true == ::ev::postgresql::Cache::GetInstance().Enabled() );
+    std::string           key;
+    std::set<std::string> tags;
+    uint64_t              generation = 0;
+    if ( true == cacheable ) {
+        // ... normalized query: statement and all parameters ...
+        key = k_query_;
+        for ( auto& param : *params ) {
+            key += '\0';
+            key += param;
+        }
+        const ::ev::postgresql::Cache::EntryPtr entry = ::ev::postgresql::Cache::GetInstance().Get(key);
+        if ( nullptr != entry ) {
+            // ... no round trip, but callback is still called asynchronously, as it would be if the query was executed ...
+            // ... ( entry is shared and immutable, it outlives an invalidation ) ...
+            ::ev::scheduler::Scheduler::GetInstance().SetClientTimeout(this, 0, [uri, entry, a_callback] () {
+                a_callback(/* a_uri */ uri.c_str(), /* a_json */ entry->json_.c_str(), /* a_error */ nullptr, /* a_status */ entry->status_, /* a_elapsed */ 0);
+            });
+            return;
+        }
+        tags       = *a_cache_tags;
+        generation = ::ev::postgresql::Cache::GetInstance().Generation();
+    }
+    
+    const std::string affinity_key = company_schema_;
+    
+    NewTask([params, a_read_only, affinity_key, a_loggable_data] () -> ::ev::Object* {
         
-        return new ::ev::postgresql::Request(a_loggable_data, query);
+        // ... task is only performed once, parameters can be moved ...
+        ::ev::postgresql::Request* request = new ::ev::postgresql::Request(a_loggable_data, k_query_, std::move(*params));
+        request->SetReadOnly(a_read_only);
+        // ... prefer devices that already served this company, schemas are passed as parameters, session is not changed ...
+        request->SetAffinity(affinity_key);
+        return request;
         
     })->Then([] (::ev::Object* a_object) -> ::ev::Object* {
         
@@ -281,7 +333,7 @@ void ::ev::postgresql::JSONAPI::AsyncQuery (const ::ev::Loggable::Data& a_loggab
          // ... same as reply, but it was detached ...
         return result->DetachDataObject();
         
-    })->Finally([this, query, a_callback] (::ev::Object* a_object) {
+    })->Finally([this, uri, a_callback, cacheable, key, tags, generation, a_cache_ttl_ms] (::ev::Object* a_object) {
         
         const ::ev::postgresql::Reply* reply = dynamic_cast<const ::ev::postgresql::Reply*>(a_object);
         if ( nullptr == reply ) {
@@ -308,11 +360,16 @@ void ::ev::postgresql::JSONAPI::AsyncQuery (const ::ev::Loggable::Data& a_loggab
         
         uint16_t status = static_cast<uint16_t>(atoi(value.raw_value(0, 1)));;
         
-        a_callback(/* a_uri */ query.c_str(), /* a_json */ value.raw_value(/* a_row */ 0, /* a_column */0), /* a_error */ nullptr, /* a_status */ status, reply->elapsed_);
+        // ... only successful replies are cached ...
+        if ( true == cacheable && status >= 200 && status < 300 && nullptr != value.raw_value(/* a_row */ 0, /* a_column */0) ) {
+            (void) ::ev::postgresql::Cache::GetInstance().Set(key, value.raw_value(/* a_row */ 0, /* a_column */0), status, tags, generation, a_cache_ttl_ms);
+        }
+        
+        a_callback(/* a_uri */ uri.c_str(), /* a_json */ value.raw_value(/* a_row */ 0, /* a_column */0), /* a_error */ nullptr, /* a_status */ status, reply->elapsed_);
         
-    })->Catch([query, a_callback] (const ::ev::Exception& a_ev_exception) {
+    })->Catch([uri, a_callback] (const ::ev::Exception& a_ev_exception) {
         
-        a_callback(/* a_uri */ query.c_str(), /* a_json */ nullptr, /* a_error */ a_ev_exception.what(), /* a_status */ 500, /* a_elapsed */ 0);
+        a_callback(/* a_uri */ uri.c_str(), /* a_json */ nullptr, /* a_error */ a_ev_exception.what(), /* a_status */ 500, /* a_elapsed */ 0);
  
     });
 }
@@ -28,6 +28,7 @@
 #include "ev/scheduler/scheduler.h"
 
 #include <string>        // std::string
+#include <set>           // std::set
 
 namespace ev
 {
@@ -114,6 +115,10 @@ namespace ev
             
             typedef std::function<void(const char* a_uri, const char* a_json, const char* a_error, uint16_t a_status, uint64_t a_elapsed)> Callback;
             
+        private: // Static Const Data
+            
+            static const std::string k_query_;
+            
         private: // Const Refs
             
             const Loggable::Data& loggable_data_ref_;
@@ -140,6 +145,13 @@ namespace ev
             virtual void Get    (const Loggable::Data& a_loggable_data,
                                  const std::string& a_uri,                            Callback a_callback,
                                  std::string* o_query = nullptr);
+            virtual void Get    (const std::string& a_uri, const std::set<std::string>& a_tags, const int64_t a_ttl_ms,
+                                 Callback a_callback,
+                                 std::string* o_query = nullptr);
+            virtual void Get    (const Loggable::Data& a_loggable_data,
+                                 const std::string& a_uri, const std::set<std::string>& a_tags, const int64_t a_ttl_ms,
+                                 Callback a_callback,
+                                 std::string* o_query = nullptr);
             virtual void Post   (const std::string& a_uri, const std::string& a_body, Callback a_callback,
                                  std::string* o_query = nullptr);
             virtual void Post   (const Loggable::Data& a_loggable_data,
@@ -182,8 +194,10 @@ namespace ev
         protected:
             
             void                   AsyncQuery (const ::ev::Loggable::Data& a_loggable_data,
-                                               const std::string a_uri, Callback a_callback,
-                                               std::string* o_query = nullptr);
+                                               const char* const a_method, const std::string& a_uri, const std::string& a_body, const bool a_read_only,
+                                               Callback a_callback,
+                                               std::string* o_query = nullptr,
+                                               const std::set<std::string>* a_cache_tags = nullptr, const int64_t a_cache_ttl_ms = -1);
             ::ev::scheduler::Task* NewTask    (const EV_TASK_PARAMS& a_callback);
             
         public: // STATIC API METHOD(S) / FUNCTION(S)
@@ -0,0 +1,43 @@
+/**
+ * @file notification.cc - PostgreSQL Notification
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/notification.h"
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_notify libpq notification, ownership is NOT transfered.
+ */
+ev::postgresql::Notification::Notification (const PGnotify* a_notify)
+    : ev::postgresql::Object(ev::postgresql::Object::Type::Reply),
+      channel_(nullptr != a_notify->relname ? a_notify->relname : ""), payload_(nullptr != a_notify->extra ? a_notify->extra : ""),
+      pid_(a_notify->be_pid)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+ev::postgresql::Notification::~Notification ()
+{
+    /* empty */
+}
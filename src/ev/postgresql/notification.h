@@ -0,0 +1,60 @@
+/**
+ * @file notification.h - PostgreSQL Notification
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_NOTIFICATION_H_
+#define NRS_EV_POSTGRESQL_NOTIFICATION_H_
+
+#include "ev/postgresql/object.h"
+
+#include <string> // std::string
+
+#include <libpq-fe.h>
+
+namespace ev
+{
+    
+    namespace postgresql
+    {
+        
+        /**
+         * @brief An asynchronous notification, received by a connection that issued a 'LISTEN' command.
+         */
+        class Notification final : public ev::postgresql::Object
+        {
+            
+        public: // Const Data
+            
+            const std::string channel_; //!< Channel name.
+            const std::string payload_; //!< Payload, empty if none.
+            const int         pid_;     //!< Notifying server process id.
+            
+        public: // Constructor(s) / Destructor
+            
+            Notification(const PGnotify* a_notify);
+            virtual ~Notification();
+            
+        }; // end of class 'Notification'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_NOTIFICATION_H_
@@ -0,0 +1,305 @@
+/**
+ * @file replicas.cc - PostgreSQL Replicas
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/replicas.h"
+
+#include "ev/postgresql/request.h"
+
+#include "ev/exception.h"
+
+#include "osal/osalite.h"
+
+#include <algorithm> // std::max
+#include <cstdlib>   // std::strtoll
+#include <string>    // std::to_string
+
+std::vector<ev::postgresql::Replicas::Replica> ev::postgresql::Replicas::replicas_          = {};
+int64_t                                        ev::postgresql::Replicas::max_lag_ms_        = 0;
+int64_t                                        ev::postgresql::Replicas::check_interval_ms_ = 0;
+size_t                                         ev::postgresql::Replicas::next_              = 0;
+bool                                           ev::postgresql::Replicas::aborted_           = false;
+std::thread*                                   ev::postgresql::Replicas::thread_            = nullptr;
+std::mutex                                     ev::postgresql::Replicas::mutex_;
+std::condition_variable                        ev::postgresql::Replicas::cv_;
+
+const int64_t                                  ev::postgresql::Replicas::k_default_check_interval_ms_ = 1000; // 1s
+const char* const                              ev::postgresql::Replicas::k_lag_query_                 =
+    "SELECT CASE"
+    " WHEN NOT pg_is_in_recovery() THEN 0"
+    " WHEN NOT EXISTS (SELECT 1 FROM pg_stat_wal_receiver WHERE status = 'streaming') THEN -1"
+    " WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0"
+    " ELSE COALESCE(EXTRACT(EPOCH FROM (now() - pg_last_xact_replay_timestamp())) * 1000, -1)"
+    " END::BIGINT;";
+
+/**
+ * @brief One-shot initializer, starts background lag checks.
+ *
+ * @param a_conn_strs         Replicas connection strings.
+ * @param a_max_lag_ms        Maximum acceptable replication lag, in milliseconds.
+ * @param a_check_interval_ms Lag check interval, in milliseconds.
+ */
+void ev::postgresql::Replicas::Startup (const std::vector<std::string>& a_conn_strs, const int64_t a_max_lag_ms,
+                                        const int64_t a_check_interval_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr != thread_ ) {
+        throw ev::Exception("PostgreSQL replicas already configured!");
+    }
+    
+    // ... nothing to do?
+    if ( 0 == a_conn_strs.size() ) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        replicas_.clear();
+        for ( auto conn_str : a_conn_strs ) {
+            replicas_.push_back({
+                /* conn_str_   */ conn_str,
+                /* lag_ms_     */ -1,
+                /* checked_at_ */ std::chrono::steady_clock::time_point()
+            });
+        }
+        max_lag_ms_        = std::max(a_max_lag_ms, static_cast<int64_t>(0));
+        check_interval_ms_ = std::max(a_check_interval_ms, static_cast<int64_t>(100));
+        next_              = 0;
+        aborted_           = false;
+    }
+    
+    thread_ = new std::thread(&ev::postgresql::Replicas::Loop, this);
+}
+
+/**
+ * @brief Call this to stop background lag checks and release previously allocated memory.
+ */
+void ev::postgresql::Replicas::Shutdown ()
+{
+    if ( nullptr != thread_ ) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            aborted_ = true;
+        }
+        cv_.notify_all();
+        thread_->join();
+        delete thread_;
+        thread_ = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    replicas_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Select a connection string for a new device that will execute a request.
+ *
+ * @param a_request
+ * @param o_conn_str Replica connection string, untouched if request should be executed by the primary.
+ *
+ * @return True if a healthy replica was selected, false if request must be executed by the primary.
+ *
+ * @remarks Only read only \link ev::postgresql::Request \link are routed to replicas, round-robin.
+ */
+bool ev::postgresql::Replicas::Route (const ev::Request* a_request, std::string& o_conn_str)
+{
+    const ev::postgresql::Request* request = dynamic_cast<const ev::postgresql::Request*>(a_request);
+    if ( nullptr == request || false == request->ReadOnly() ) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    for ( size_t idx = 0 ; idx < replicas_.size() ; ++idx ) {
+        const Replica& replica = replicas_[( next_ + idx ) % replicas_.size()];
+        if ( true == Healthy(replica, now) ) {
+            next_      = ( next_ + idx + 1 ) % replicas_.size();
+            o_conn_str = replica.conn_str_;
+            return true;
+        }
+    }
+    
+    // ... all replicas are lagging or unreachable, fallback to primary ...
+    return false;
+}
+
+/**
+ * @brief Check if a replica lag, measured in background, is acceptable.
+ *
+ * @param a_conn_str Replica connection string.
+ *
+ * @return True if so, false if it's lagging, unreachable or unknown.
+ */
+bool ev::postgresql::Replicas::IsHealthy (const std::string& a_conn_str)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    for ( auto& replica : replicas_ ) {
+        if ( a_conn_str == replica.conn_str_ ) {
+            return Healthy(replica, now);
+        }
+    }
+    return false;
+}
+
+/**
+ * @return True if at least one replica lag is acceptable, false otherwise.
+ */
+bool ev::postgresql::Replicas::HasHealthy ()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    const auto now = std::chrono::steady_clock::now();
+    for ( auto& replica : replicas_ ) {
+        if ( true == Healthy(replica, now) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Background thread loop, periodically measures all replicas lag.
+ */
+void ev::postgresql::Replicas::Loop ()
+{
+    std::vector<std::string> conn_strs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for ( auto& replica : replicas_ ) {
+            conn_strs.push_back(replica.conn_str_);
+        }
+    }
+    
+    // ... one connection per replica, owned by this thread ...
+    std::vector<PGconn*> connections(conn_strs.size(), nullptr);
+    
+    while ( true ) {
+        
+        // ... measure, without holding the lock, it may block ...
+        for ( size_t idx = 0 ; idx < conn_strs.size() ; ++idx ) {
+            const int64_t lag_ms = Measure(connections[idx], conn_strs[idx]);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ( idx < replicas_.size() ) {
+                replicas_[idx].lag_ms_     = lag_ms;
+                replicas_[idx].checked_at_ = std::chrono::steady_clock::now();
+            }
+        }
+        
+        // ... wait for next check or shutdown ...
+        std::unique_lock<std::mutex> lock(mutex_);
+        if ( true == cv_.wait_for(lock, std::chrono::milliseconds(check_interval_ms_), [] { return aborted_; }) ) {
+            break;
+        }
+    }
+    
+    for ( auto connection : connections ) {
+        if ( nullptr != connection ) {
+            PQfinish(connection);
+        }
+    }
+}
+
+/**
+ * @brief Synchronously measure a replica replication lag.
+ *
+ * @param a_connection Replica connection, ( re )established if needed.
+ * @param a_conn_str   Replica connection string.
+ *
+ * @return Lag in milliseconds, -1 if replica is unreachable or lag can't be measured.
+ *
+ * @remarks Connection and query are bounded by the check interval, so an unresponsive replica won't stall other checks.
+ */
+int64_t ev::postgresql::Replicas::Measure (PGconn*& a_connection, const std::string& a_conn_str)
+{
+    // ... ( re )connect?
+    if ( nullptr != a_connection && CONNECTION_OK != PQstatus(a_connection) ) {
+        PQfinish(a_connection);
+        a_connection = nullptr;
+    }
+    if ( nullptr == a_connection ) {
+        // ... connection string ( or URI ) is expanded first, timeout overrides it's own value, if any ...
+        const std::string connect_timeout = std::to_string(std::max(( check_interval_ms_ + 999 ) / 1000, static_cast<int64_t>(2)));
+        const char* const keywords[]      = { "dbname"          , "connect_timeout"      , nullptr };
+        const char* const values[]        = { a_conn_str.c_str(), connect_timeout.c_str(), nullptr };
+        a_connection = PQconnectdbParams(keywords, values, /* expand_dbname */ 1);
+        if ( nullptr == a_connection ) {
+            return -1;
+        }
+        if ( CONNECTION_OK != PQstatus(a_connection) ) {
+            PQfinish(a_connection);
+            a_connection = nullptr;
+            return -1;
+        }
+        // ... bound lag query execution time ...
+        const std::string statement_timeout = "SET statement_timeout TO " + std::to_string(check_interval_ms_) + ";";
+        PGresult* set_result = PQexec(a_connection, statement_timeout.c_str());
+        const bool set = ( nullptr != set_result && PGRES_COMMAND_OK == PQresultStatus(set_result) );
+        if ( nullptr != set_result ) {
+            PQclear(set_result);
+        }
+        if ( false == set ) {
+            PQfinish(a_connection);
+            a_connection = nullptr;
+            return -1;
+        }
+    }
+    
+    int64_t lag_ms = -1;
+    
+    PGresult* result = PQexec(a_connection, k_lag_query_);
+    if ( nullptr != result ) {
+        if ( PGRES_TUPLES_OK == PQresultStatus(result) && 1 == PQntuples(result) && 0 == PQgetisnull(result, 0, 0) ) {
+            lag_ms = std::max(static_cast<int64_t>(std::strtoll(PQgetvalue(result, 0, 0), nullptr, 10)), static_cast<int64_t>(-1));
+        }
+        PQclear(result);
+    }
+    
+    return lag_ms;
+}
+
+/**
+ * @brief Check if a replica lag is acceptable and was recently measured.
+ *
+ * @param a_replica
+ * @param a_tp      Reference time point.
+ *
+ * @return True if so, false otherwise.
+ *
+ * @remarks Mutex must be locked by caller.
+ */
+bool ev::postgresql::Replicas::Healthy (const ev::postgresql::Replicas::Replica& a_replica, const std::chrono::steady_clock::time_point& a_tp) const
+{
+    // ... a stale measurement is not trusted ...
+    if ( a_replica.lag_ms_ < 0 || std::chrono::duration_cast<std::chrono::milliseconds>(a_tp - a_replica.checked_at_).count() > ( 3 * check_interval_ms_ ) ) {
+        return false;
+    }
+    return ( a_replica.lag_ms_ <= max_lag_ms_ );
+}
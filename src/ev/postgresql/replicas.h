@@ -0,0 +1,101 @@
+/**
+ * @file replicas.h - PostgreSQL Replicas
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_REPLICAS_H_
+#define NRS_EV_POSTGRESQL_REPLICAS_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/request.h"
+
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <chrono>             // std::chrono::steady_clock
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex
+#include <condition_variable> // std::condition_variable
+
+#include <libpq-fe.h>
+
+namespace ev
+{
+    
+    namespace postgresql
+    {
+        
+        /**
+         * @brief Keeps track of PostgreSQL read replicas replication lag, lag is checked in background by a dedicated thread.
+         *
+         * @remarks A replica whose WAL receiver is not streaming is unhealthy, since it's replay lag can't be trusted,
+         *          connection role must be allowed to read 'pg_stat_wal_receiver' status ( e.g. a member of 'pg_read_all_stats' ).
+         */
+        class Replicas final : public osal::Singleton<Replicas>
+        {
+            
+        private: // Data Type(s)
+            
+            typedef struct {
+                std::string                           conn_str_;   //!< Replica connection string.
+                int64_t                               lag_ms_;     //!< Last measured lag, in milliseconds, -1 if unknown or unreachable.
+                std::chrono::steady_clock::time_point checked_at_; //!< When lag was last measured.
+            } Replica;
+            
+        public: // Static Const Data
+            
+            static const int64_t            k_default_check_interval_ms_;
+            static const char* const        k_lag_query_;
+            
+        private: // Static Data
+            
+            static std::vector<Replica>     replicas_;
+            static int64_t                  max_lag_ms_;
+            static int64_t                  check_interval_ms_;
+            static size_t                   next_;
+            static bool                     aborted_;
+            static std::thread*             thread_;
+            static std::mutex               mutex_;
+            static std::condition_variable  cv_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const std::vector<std::string>& a_conn_strs, const int64_t a_max_lag_ms,
+                           const int64_t a_check_interval_ms = k_default_check_interval_ms_);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool Route     (const ev::Request* a_request, std::string& o_conn_str);
+            bool IsHealthy (const std::string& a_conn_str);
+            bool HasHealthy ();
+            
+        private: // Method(s) / Function(s)
+            
+            void    Loop    ();
+            int64_t Measure (PGconn*& a_connection, const std::string& a_conn_str);
+            bool    Healthy (const Replica& a_replica, const std::chrono::steady_clock::time_point& a_tp) const;
+            
+        }; // end of class 'Replicas'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_REPLICAS_H_
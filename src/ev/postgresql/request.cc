@@ -23,17 +23,55 @@
 
 #include <vector>  // std::vector
 #include <cstdarg> // va_start, va_end, std::va_list
+#include <utility> // std::move
 
 /**
  * @brief Default constructor.
  *
  * @param a_loggable_data
  * @param a_payload
+ * @param a_control
  */
-ev::postgresql::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload)
-    : ev::Request(a_loggable_data, ev::Object::Target::PostgreSQL, ev::Request::Mode::OneShot)
+ev::postgresql::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload,
+                                  const ev::Request::Control a_control)
+    : ev::Request(a_loggable_data, ev::Object::Target::PostgreSQL, ev::Request::Mode::OneShot, a_control)
+{
+    payload_           = a_payload;
+    statement_timeout_ = -1;
+    read_only_         = false;
+}
+
+/**
+ * @brief Constructor for a request with a specific mode.
+ *
+ * @param a_loggable_data
+ * @param a_mode          One of \link ev::Request::Mode \link.
+ * @param a_payload
+ */
+ev::postgresql::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const ev::Request::Mode a_mode, const std::string& a_payload)
+    : ev::Request(a_loggable_data, ev::Object::Target::PostgreSQL, a_mode)
+{
+    payload_           = a_payload;
+    statement_timeout_ = -1;
+    read_only_         = false;
+}
+
+/**
+ * @brief Constructor for a parameterized request.
+ *
+ * @param a_loggable_data
+ * @param a_payload       Query, with $1 ... $n placeholders.
+ * @param a_params        Parameters values, moved to this object.
+ *
+ * @remarks Only one statement is allowed, so a per request statement timeout won't be applied.
+ */
+ev::postgresql::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload, std::vector<std::string>&& a_params)
+    : ev::Request(a_loggable_data, ev::Object::Target::PostgreSQL, ev::Request::Mode::OneShot),
+      params_(std::move(a_params))
 {
-    payload_ = a_payload;
+    payload_           = a_payload;
+    statement_timeout_ = -1;
+    read_only_         = false;
 }
 
 /**
@@ -59,7 +97,9 @@ ev::postgresql::Request::Request (const ::ev::Loggable::Data& a_loggable_data, c
         }
         length = static_cast<std::size_t>(status);
     }
-    payload_ = length > 0 ? std::string { temp.data(), length } : "";
+    payload_           = length > 0 ? std::string { temp.data(), length } : "";
+    statement_timeout_ = -1;
+    read_only_         = false;
 }
 
 /**
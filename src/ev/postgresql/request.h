@@ -24,7 +24,9 @@
 
 #include "ev/request.h"
 
-#include <string> // std::string
+#include <string>    // std::string
+#include <vector>    // std::vector
+#include <algorithm> // std::max
 
 namespace ev
 {
@@ -36,11 +38,20 @@ namespace ev
             
         private: // Data
             
-            std::string payload_; //!< Request query.
+            std::string              payload_;           //!< Request query.
+            std::vector<std::string> params_;            //!< Out-of-line query parameters, $1 ... $n, sent verbatim.
+            int                      statement_timeout_; //!< Statement timeout for this request only, in milliseconds, -1 to use device default.
+            bool                     read_only_;         //!< True when this request doesn't write, it can be routed to a replica.
+            std::string              affinity_key_;      //!< Schema, role or tenant id, devices that served the same key are preferred, empty if none.
+            std::string              search_path_;       //!< Session 'search_path' required by this request, empty for device default.
+            std::string              role_;              //!< Session role required by this request, empty for device default.
             
         public: // Constructor(s) / Destructor
             
-            Request(const Loggable::Data& a_loggable_data, const std::string& a_payload);
+            Request(const Loggable::Data& a_loggable_data, const std::string& a_payload,
+                    const ev::Request::Control a_control = ev::Request::Control::NotSet);
+            Request(const Loggable::Data& a_loggable_data, const ev::Request::Mode a_mode, const std::string& a_payload);
+            Request(const Loggable::Data& a_loggable_data, const std::string& a_payload, std::vector<std::string>&& a_params);
             Request(const Loggable::Data& a_loggable_data, const char* const a_format, ...) __attribute__((format(printf, 3, 4)));
             virtual ~Request();
             
@@ -49,8 +60,143 @@ namespace ev
             virtual const char* const  AsCString () const;
             virtual const std::string& AsString  () const;
             
+        public: // Method(s) / Function(s)
+            
+            void SetStatementTimeout (const int a_timeout);
+            int  StatementTimeout    () const;
+            void SetPayload          (const std::string& a_payload);
+            void SetReadOnly         (const bool a_read_only);
+            bool ReadOnly            () const;
+            void SetAffinity         (const std::string& a_key, const std::string& a_search_path = "", const std::string& a_role = "");
+            
+            const std::string& AffinityKey () const;
+            const std::string& SearchPath  () const;
+            const std::string& Role        () const;
+            
+            const std::vector<std::string>& Params () const;
+            
+        public: // Static Method(s) / Function(s)
+            
+            static std::string Identifier (const std::string& a_name);
+            
         }; // end of class 'Request'
         
+        /**
+         * @brief Set a statement timeout for this request only.
+         *
+         * @remark Ignored by parameterized requests, they can only carry one statement and device default applies.
+         *         Also ignored inside an explicit transaction block ( e.g. transaction or cursor requests ).
+         *
+         * @param a_timeout Timeout in milliseconds, 0 to disable timeout, -1 to use device default.
+         */
+        inline void Request::SetStatementTimeout (const int a_timeout)
+        {
+            statement_timeout_ = std::max(a_timeout, -1);
+        }
+        
+        /**
+         * @return Statement timeout for this request only, in milliseconds, -1 if device default should be used.
+         */
+        inline int Request::StatementTimeout () const
+        {
+            return statement_timeout_;
+        }
+        
+        /**
+         * @brief Replace this request query, for 'keep alive' requests that are reused.
+         *
+         * @param a_payload
+         */
+        inline void Request::SetPayload (const std::string& a_payload)
+        {
+            payload_ = a_payload;
+        }
+        
+        /**
+         * @brief Flag this request as read only, so it can be executed by a replica.
+         *
+         * @param a_read_only
+         */
+        inline void Request::SetReadOnly (const bool a_read_only)
+        {
+            read_only_ = a_read_only;
+        }
+        
+        /**
+         * @return True if this request can be executed by a replica, false if it must be executed by the primary.
+         */
+        inline bool Request::ReadOnly () const
+        {
+            return read_only_;
+        }
+        
+        /**
+         * @brief Set this request affinity, devices whose session is already configured for it are preferred.
+         *
+         * @param a_key         Schema, role or tenant id.
+         * @param a_search_path Session 'search_path', comma separated schema names ( each one is quoted ), applied only if the device session differs, empty for device default.
+         * @param a_role        Session role, applied only if the device session differs, empty for device default.
+         */
+        inline void Request::SetAffinity (const std::string& a_key, const std::string& a_search_path, const std::string& a_role)
+        {
+            affinity_key_ = a_key;
+            search_path_  = a_search_path;
+            role_         = a_role;
+        }
+        
+        /**
+         * @return Affinity key, empty if none.
+         */
+        inline const std::string& Request::AffinityKey () const
+        {
+            return affinity_key_;
+        }
+        
+        /**
+         * @return Session 'search_path' required by this request, empty for device default.
+         */
+        inline const std::string& Request::SearchPath () const
+        {
+            return search_path_;
+        }
+        
+        /**
+         * @return Session role required by this request, empty for device default.
+         */
+        inline const std::string& Request::Role () const
+        {
+            return role_;
+        }
+        
+        /**
+         * @return R/O access to out-of-line query parameters, empty if none.
+         */
+        inline const std::vector<std::string>& Request::Params () const
+        {
+            return params_;
+        }
+        
+        /**
+         * @return A quoted identifier, embedded double quotes are doubled, so it can be safely spliced into a statement.
+         *
+         * @param a_name Schema, role, channel, cursor or savepoint name, case sensitive.
+         */
+        inline std::string Request::Identifier (const std::string& a_name)
+        {
+            std::string rv = "\"";
+            for ( auto c : a_name ) {
+                if ( '\0' == c ) {
+                    // ... not allowed in identifiers, it would truncate the statement ...
+                    continue;
+                }
+                if ( '"' == c ) {
+                    rv += '"';
+                }
+                rv += c;
+            }
+            return rv + "\"";
+        }
+        
     } // end of namespace 'postgresql'
     
 } // end of namespace 'ev'
@@ -0,0 +1,48 @@
+/**
+ * @file stream_request.cc - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/stream_request.h"
+
+#include <algorithm> // std::max
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_loggable_data
+ * @param a_payload
+ * @param a_rows_per_batch
+ * @param a_max_batches_in_flight
+ */
+ev::postgresql::StreamRequest::StreamRequest (const ::ev::Loggable::Data& a_loggable_data, const std::string& a_payload,
+                                              const size_t a_rows_per_batch, const size_t a_max_batches_in_flight)
+    : ev::postgresql::Request(a_loggable_data, a_payload),
+      rows_per_batch_(std::max(a_rows_per_batch, static_cast<size_t>(1))), max_batches_in_flight_(std::max(a_max_batches_in_flight, static_cast<size_t>(1)))
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor
+ */
+ev::postgresql::StreamRequest::~StreamRequest ()
+{
+    /* empty */
+}
@@ -0,0 +1,60 @@
+/**
+ * @file stream_request.h - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_STREAM_REQUEST_H_
+#define NRS_EV_POSTGRESQL_STREAM_REQUEST_H_
+
+#include "ev/postgresql/request.h"
+
+#include <string> // std::string
+
+namespace ev
+{
+    namespace postgresql
+    {
+        
+        /**
+         * @brief A request which rows are delivered in batches, while the query is still running.
+         *
+         * @remarks Each batch is published, as an \link ev::Result \link, to the task stream callback. The final
+         *          reply, as usual, is delivered to the next task step and it contains no rows.
+         */
+        class StreamRequest final : public Request
+        {
+            
+        public: // Const Data
+            
+            const size_t rows_per_batch_;        //!< Maximum number of rows per batch.
+            const size_t max_batches_in_flight_; //!< Maximum number of published batches not yet consumed, before socket reads are paused.
+            
+        public: // Constructor(s) / Destructor
+            
+            StreamRequest(const Loggable::Data& a_loggable_data, const std::string& a_payload,
+                          const size_t a_rows_per_batch = 500, const size_t a_max_batches_in_flight = 4);
+            virtual ~StreamRequest();
+            
+        }; // end of class 'StreamRequest'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_STREAM_REQUEST_H_
@@ -0,0 +1,309 @@
+/**
+ * @file manager.cc - PostgreSQL subscriptions Manager
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/subscriptions/manager.h"
+
+#include "ev/exception.h"
+
+#include <algorithm> // std::find_if, std::min
+
+::ev::postgresql::subscriptions::Request* ev::postgresql::subscriptions::Manager::postgresql_subscription_      = nullptr;
+bool                                      ev::postgresql::subscriptions::Manager::postgresql_subscription_used_ = false;
+::ev::Bridge*                             ev::postgresql::subscriptions::Manager::bridge_                       = nullptr;
+int64_t                                   ev::postgresql::subscriptions::Manager::reconnect_timeout_            = 2000;  // 2s
+bool                                      ev::postgresql::subscriptions::Manager::connection_lost_              = false;
+
+const int64_t                             ev::postgresql::subscriptions::Manager::k_min_reconnect_timeout_      = 2000;  // 2s
+const int64_t                             ev::postgresql::subscriptions::Manager::k_max_reconnect_timeout_      = 32000; // 32s
+
+/**
+ * @brief One-shot initializer.
+ *
+ * @param a_loggable_data
+ * @param a_bridge
+ */
+void ev::postgresql::subscriptions::Manager::Startup (const ::ev::Loggable::Data& a_loggable_data, ev::Bridge* a_bridge)
+{
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "~> Startup(...)");
+    
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr != postgresql_subscription_ ) {
+        throw ev::Exception("PostgreSQL subscriptions already configured!");
+    }
+    
+    ::ev::scheduler::Scheduler::GetInstance().Register(this);
+    
+    // ... create new subscription ...
+    postgresql_subscription_ = new ::ev::postgresql::subscriptions::Request(a_loggable_data,
+                                                                            [this](::ev::scheduler::Subscription* a_subscription) {
+                                                                                ::ev::scheduler::Scheduler::GetInstance().Push(this, a_subscription);
+                                                                                if ( postgresql_subscription_ == a_subscription && false == postgresql_subscription_used_ ) {
+                                                                                    postgresql_subscription_used_ = true;
+                                                                                }
+                                                                            },
+                                                                            std::bind(&ev::postgresql::subscriptions::Manager::OnPostgreSQLNotificationReceived, this, std::placeholders::_1),
+                                                                            std::bind(&ev::postgresql::subscriptions::Manager::OnPostgreSQLListening           , this, std::placeholders::_1),
+                                                                            std::bind(&ev::postgresql::subscriptions::Manager::OnPostgreSQLDisconnected        , this, std::placeholders::_1)
+    );
+    
+    // ... keep track of shared handler ...
+    bridge_ = a_bridge;
+    
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ Startup(...)");
+}
+
+/**
+ * @brief Call this to dealloc previously allocated memory.
+ */
+void ev::postgresql::subscriptions::Manager::Shutdown ()
+{
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "~> Shutdown()");
+    
+    ::ev::scheduler::Scheduler::GetInstance().Unregister(this);
+    if ( nullptr != postgresql_subscription_ ) {
+        if ( false == postgresql_subscription_used_ ) {
+            delete postgresql_subscription_;
+        }
+        postgresql_subscription_      = nullptr;
+        postgresql_subscription_used_ = false;
+    }
+    for ( auto it : channel_to_clients_map_ ) {
+        delete it.second;
+    }
+    channel_to_clients_map_.clear();
+    reconnect_timeout_ = k_min_reconnect_timeout_;
+    connection_lost_   = false;
+    
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ Shutdown()");
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Listen to a set of channels, a client can only have one callback per channel.
+ *
+ * @param a_channels
+ * @param a_data_callback
+ * @param a_client
+ */
+void ev::postgresql::subscriptions::Manager::Listen (const std::set<std::string>& a_channels,
+                                                     EV_POSTGRESQL_SUBSCRIPTIONS_DATA_CALLBACK a_data_callback,
+                                                     ev::postgresql::subscriptions::Manager::Client* a_client)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr == postgresql_subscription_ ) {
+        throw ev::Exception("PostgreSQL subscriptions NOT configured!");
+    }
+    
+    for ( auto channel : a_channels ) {
+        auto it = channel_to_clients_map_.find(channel);
+        if ( channel_to_clients_map_.end() == it ) {
+            it = channel_to_clients_map_.insert(std::make_pair(channel, new ev::postgresql::subscriptions::Manager::ClientsVector())).first;
+        }
+        const auto c_it = std::find(it->second->begin(), it->second->end(), a_client);
+        if ( it->second->end() == c_it ) {
+            it->second->push_back(a_client);
+        }
+        a_client->callbacks_[channel] = a_data_callback;
+    }
+    
+    // ... only new channels will be listened to ...
+    postgresql_subscription_->Listen(a_channels);
+}
+
+/**
+ * @brief Stop listening to a set of channels, channels are only 'unlistened' when they have no clients.
+ *
+ * @param a_channels
+ * @param a_client
+ */
+void ev::postgresql::subscriptions::Manager::Unlisten (const std::set<std::string>& a_channels,
+                                                       ev::postgresql::subscriptions::Manager::Client* a_client)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr == postgresql_subscription_ ) {
+        throw ev::Exception("PostgreSQL subscriptions NOT configured!");
+    }
+    
+    std::set<std::string> channels_to_unlisten;
+    for ( auto channel : a_channels ) {
+        a_client->callbacks_.erase(channel);
+        const auto it = channel_to_clients_map_.find(channel);
+        if ( channel_to_clients_map_.end() == it ) {
+            continue;
+        }
+        const auto c_it = std::find(it->second->begin(), it->second->end(), a_client);
+        if ( it->second->end() != c_it ) {
+            it->second->erase(c_it);
+        }
+        // ... no more clients?
+        if ( 0 == it->second->size() ) {
+            delete it->second;
+            channel_to_clients_map_.erase(it);
+            channels_to_unlisten.insert(channel);
+        }
+    }
+    
+    if ( channels_to_unlisten.size() > 0 ) {
+        postgresql_subscription_->Unlisten(channels_to_unlisten);
+    }
+}
+
+/**
+ * @brief Stop listening to all channels of a client.
+ *
+ * @param a_client
+ */
+void ev::postgresql::subscriptions::Manager::Unlisten (ev::postgresql::subscriptions::Manager::Client* a_client)
+{
+    std::set<std::string> channels;
+    for ( auto it : a_client->callbacks_ ) {
+        channels.insert(it.first);
+    }
+    Unlisten(channels, a_client);
+}
+
+/**
+ * @brief Check if a channel is being listened to, it's 'LISTEN' command must have succeeded on current connection.
+ *
+ * @param a_channel
+ *
+ * @return True if notifications for this channel are being received, false if pending or connection was lost.
+ */
+bool ev::postgresql::subscriptions::Manager::IsListening (const std::string& a_channel) const
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    return ( nullptr != postgresql_subscription_ && true == postgresql_subscription_->IsConfirmed(a_channel) );
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief This method will be called when a PostgreSQL notification was received.
+ *
+ * @param a_notification
+ */
+void ev::postgresql::subscriptions::Manager::OnPostgreSQLNotificationReceived (const ::ev::postgresql::Notification* a_notification)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    OSALITE_DEBUG_TRACE("ev_subscriptions","[%s] %d says %s",
+                        a_notification->channel_.c_str(), a_notification->pid_, a_notification->payload_.c_str());
+    
+    // ... still tracking channel?
+    const auto it = channel_to_clients_map_.find(a_notification->channel_);
+    if ( channel_to_clients_map_.end() == it ) {
+        // ... no ...
+        return;
+    }
+    // ... a callback might change clients list ...
+    const ClientsVector clients = *it->second;
+    // ... notify all clients ...
+    for ( auto client : clients ) {
+        const auto callback_it = client->callbacks_.find(a_notification->channel_);
+        if ( client->callbacks_.end() == callback_it || nullptr == callback_it->second ) {
+            continue;
+        }
+        callback_it->second(a_notification->channel_, a_notification->payload_);
+    }
+}
+
+/**
+ * @brief This method will be called when 'LISTEN' / 'UNLISTEN' commands were executed, connection is up.
+ *
+ * @param a_request
+ */
+void ev::postgresql::subscriptions::Manager::OnPostgreSQLListening (::ev::postgresql::subscriptions::Request* a_request)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( a_request != postgresql_subscription_ ) {
+        return;
+    }
+    // ... recovered ( or never lost ) ...
+    reconnect_timeout_ = k_min_reconnect_timeout_;
+    connection_lost_   = false;
+}
+
+/**
+ * @brief This method will be called when a PostgreSQL subscription was disconnected.
+ *
+ * @param a_request
+ *
+ * @return \li True if this subscription should be kept alive.
+ *         \li False when this subscription should be released.
+ */
+bool ev::postgresql::subscriptions::Manager::OnPostgreSQLDisconnected (::ev::postgresql::subscriptions::Request* a_request)
+{
+    // ...
+    if ( a_request != postgresql_subscription_ || nullptr == postgresql_subscription_ ) {
+        return false;
+    }
+    
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "~> PostgreSQL Disconnected...");
+    
+    // ... notifications sent while disconnected will be missed, notify all clients now ( once per outage ) ...
+    if ( false == connection_lost_ ) {
+        connection_lost_ = true;
+        std::set<ev::postgresql::subscriptions::Manager::Client*> clients_to_notify;
+        for ( auto it : channel_to_clients_map_ ) {
+            for ( auto client : *it.second ) {
+                clients_to_notify.insert(client);
+            }
+        }
+        for ( auto client : clients_to_notify ) {
+            client->OnPostgreSQLConnectionLost();
+        }
+    }
+    
+    bridge_->CallOnMainThread([this]() {
+        
+        OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+        
+        // ... already shutdown?
+        if ( nullptr == postgresql_subscription_ ) {
+            return;
+        }
+        
+        // ... retry, a new connection will be established and all channels listened to again ...
+        try {
+            postgresql_subscription_->Resubscribe();
+        } catch (ev::Exception& a_ev_exception) {
+            bridge_->ThrowFatalException(a_ev_exception);
+        }
+        
+        OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ PostgreSQL Disconnected: timeout in " INT64_FMT, reconnect_timeout_);
+        
+        // ... never give up, back off up to the maximum interval ...
+        reconnect_timeout_ = std::min(reconnect_timeout_ * 2, k_max_reconnect_timeout_);
+        
+    }, reconnect_timeout_);
+    
+    return true;
+}
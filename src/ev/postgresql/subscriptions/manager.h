@@ -0,0 +1,134 @@
+/**
+ * @file manager.h - PostgreSQL subscriptions Manager
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_SUBSCRIPTIONS_MANAGER_H_
+#define NRS_EV_POSTGRESQL_SUBSCRIPTIONS_MANAGER_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/scheduler/scheduler.h"
+
+#include "ev/postgresql/subscriptions/request.h"
+
+#include <string> // std::string
+#include <set>    // std::set
+#include <vector> // std::vector
+#include <map>    // std::map
+
+namespace ev
+{
+    
+    namespace postgresql
+    {
+        
+        namespace subscriptions
+        {
+            
+            class Manager final : public osal::Singleton<Manager>, public ::ev::scheduler::Scheduler::Client
+            {
+                
+            public: // Data Type(s)
+                
+#ifndef EV_POSTGRESQL_SUBSCRIPTIONS_DATA_CALLBACK
+    #define EV_POSTGRESQL_SUBSCRIPTIONS_DATA_CALLBACK std::function<void(const std::string& a_channel, const std::string& a_payload)>
+#endif
+                
+                class Client
+                {
+                    
+                    friend class Manager;
+                    
+                private: // Data Type(s)
+                    
+                    typedef std::map<std::string, EV_POSTGRESQL_SUBSCRIPTIONS_DATA_CALLBACK> CallbacksMap;
+                    
+                private: // Data
+                    
+                    CallbacksMap callbacks_;
+                    
+                public: // Constructor(s) / Destructor
+                    
+                    /**
+                     * @brief Destructor.
+                     */
+                    virtual ~Client ()
+                    {
+                        /* empty */
+                    }
+                    
+                public: // Method(s) / Function(s)
+                    
+                    virtual void OnPostgreSQLConnectionLost () = 0;
+                    
+                }; // end of class 'Client'
+                
+            private: // Static Data
+                
+                static ::ev::postgresql::subscriptions::Request* postgresql_subscription_;
+                static bool                                      postgresql_subscription_used_;
+                static ::ev::Bridge*                             bridge_;
+                static int64_t                                   reconnect_timeout_;
+                static bool                                      connection_lost_;
+                
+            private: // Static Const Data
+                
+                static const int64_t                             k_min_reconnect_timeout_;
+                static const int64_t                             k_max_reconnect_timeout_;
+                
+            private: // Data Type(s)
+                
+                typedef std::vector<Client*>                  ClientsVector;
+                typedef std::map<std::string, ClientsVector*> ChannelsToClientsMap;
+                
+            private: // Data
+                
+                ChannelsToClientsMap channel_to_clients_map_;
+                
+            public: // Method(s) / Function(s)
+                
+                void Startup  (const ::ev::Loggable::Data& a_loggable_data, ev::Bridge* a_bridge);
+                void Shutdown ();
+                
+            public: // Method(s) / Function(s)
+                
+                void Listen   (const std::set<std::string>& a_channels,
+                               EV_POSTGRESQL_SUBSCRIPTIONS_DATA_CALLBACK a_data_callback,
+                               Client* a_client);
+                void Unlisten (const std::set<std::string>& a_channels, Client* a_client);
+                void Unlisten (Client* a_client);
+                
+                bool IsListening (const std::string& a_channel) const;
+                
+            private: // Method(s) / Function(s)
+                
+                void OnPostgreSQLNotificationReceived (const ::ev::postgresql::Notification* a_notification);
+                void OnPostgreSQLListening            (::ev::postgresql::subscriptions::Request* a_request);
+                bool OnPostgreSQLDisconnected         (::ev::postgresql::subscriptions::Request* a_request);
+                
+            }; // end of class 'Manager'
+            
+        } // end of namespace 'subscriptions'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_SUBSCRIPTIONS_MANAGER_H_
@@ -0,0 +1,289 @@
+/**
+ * @file request.cc - PostgreSQL subscriptions Request
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/subscriptions/request.h"
+
+#include "ev/postgresql/reply.h"
+#include "ev/postgresql/error.h"
+
+#include "ev/exception.h"
+
+#include "ev/logger.h"
+
+#include "osal/osalite.h"
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_loggable_data
+ * @param a_commit_callback
+ * @param a_notification_callback
+ * @param a_listening_callback    Called when commands were successfully executed, connection is up.
+ * @param a_disconnected_callback
+ */
+ev::postgresql::subscriptions::Request::Request (const ::ev::Loggable::Data& a_loggable_data,
+                                                 EV_SUBSCRIPTION_COMMIT_CALLBACK a_commit_callback, EV_POSTGRESQL_NOTIFICATION_CALLBACK a_notification_callback,
+                                                 EV_POSTGRESQL_LISTENING_CALLBACK a_listening_callback, EV_POSTGRESQL_DISCONNECTED_CALLBACK a_disconnected_callback)
+    : ev::scheduler::Subscription(a_commit_callback),
+      notification_callback_(a_notification_callback), listening_callback_(a_listening_callback), disconnected_callback_(a_disconnected_callback),
+      loggable_data_(a_loggable_data)
+{
+    busy_        = false;
+    request_ptr_ = nullptr;
+}
+
+/**
+ * @brief Destructor.
+ */
+ev::postgresql::subscriptions::Request::~Request ()
+{
+    // ... hub is no longer running, it's safe to release it now ...
+    if ( nullptr != request_ptr_ ) {
+        delete request_ptr_;
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Perform next action in sequence.
+ *
+ * @param a_object  Previous step result.
+ * @param o_request The next request to be performed, nullptr if none.
+ *
+ * @return True if this object can be release, false otherwise.
+ */
+bool ev::postgresql::subscriptions::Request::Step (ev::Object* a_object, ev::Request** o_request)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... get rid of previous step result object ( if any ) ...
+    if ( nullptr != a_object ) {
+        delete a_object;
+    }
+    
+    // ... check if we've pending commands and if we're ready to 'step' them now ...
+    if ( false == busy_ && pending_.size() > 0 ) {
+        if ( nullptr == request_ptr_ ) {
+            request_ptr_ = new ev::postgresql::Request(loggable_data_, ev::Request::Mode::KeepAlive, "");
+        }
+        // ... all pending commands, in a single round trip ...
+        std::string payload;
+        while ( pending_.size() > 0 ) {
+            payload += pending_.front() + "; ";
+            pending_.pop_front();
+        }
+        sent_.insert(queued_.begin(), queued_.end());
+        queued_.clear();
+        request_ptr_->SetPayload(payload);
+        busy_ = true;
+        // ... request_ptr_ is reused, it's memory is still managed by this object ...
+        (*o_request) = request_ptr_;
+    } else {
+        // ... nothing to do or busy ...
+        (*o_request) = nullptr;
+    }
+    
+    // ... this object can't be released unless it was canceled first ...
+    return false;
+}
+
+/**
+ * @brief Deliver results for current listeners.
+ *
+ * @param a_results
+ */
+void ev::postgresql::subscriptions::Request::Publish (std::vector<ev::Result*>& a_results)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    for ( auto result : a_results ) {
+        
+        bool command_reply = false;
+        bool command_error = false;
+        
+        for ( size_t idx = 0 ; idx < result->DataObjectsCount() ; ++idx ) {
+            
+            const ev::Object* data_object = result->DataObject(idx);
+            
+            // ... notification?
+            const ev::postgresql::Notification* notification = dynamic_cast<const ev::postgresql::Notification*>(data_object);
+            if ( nullptr != notification ) {
+                // ... still listening?
+                if ( true == IsListening(notification->channel_) && nullptr != notification_callback_ ) {
+                    // ... no need to delete notification ...
+                    // ... uncollected results will be deleted ...
+                    notification_callback_(notification);
+                }
+                continue;
+            }
+            
+            // ... reply to a 'LISTEN' / 'UNLISTEN' command ...
+            command_reply = true;
+            
+            const ev::postgresql::Reply* reply = dynamic_cast<const ev::postgresql::Reply*>(data_object);
+            const ev::postgresql::Error* error = dynamic_cast<const ev::postgresql::Error*>(data_object);
+            if ( nullptr != error ) {
+                command_error = true;
+                ev::Logger::GetInstance().Log("postgresql_trace", loggable_data_,
+                                              "[%-30s] ::: ERROR ::: %s ::: ERROR :::",
+                                              __FUNCTION__, error->message().c_str()
+                );
+            } else if ( nullptr != reply && true == reply->value().is_error() ) {
+                command_error = true;
+                ev::Logger::GetInstance().Log("postgresql_trace", loggable_data_,
+                                              "[%-30s] ::: ERROR ::: %s ::: ERROR :::",
+                                              __FUNCTION__, nullptr != reply->value().error_message() ? reply->value().error_message() : "nullptr"
+                );
+            }
+        }
+        
+        // ... command finished?
+        if ( true == command_reply || 0 == result->DataObjectsCount() ) {
+            busy_ = false;
+            // ... commands sent in a single round trip succeed or fail together ...
+            for ( auto channel : sent_ ) {
+                if ( true == command_error ) {
+                    // ... not listening, it will be listened to again when requested ...
+                    channels_.erase(channel);
+                } else if ( true == IsListening(channel) ) {
+                    confirmed_.insert(channel);
+                }
+            }
+            sent_.clear();
+            // ... notify owner?
+            if ( false == command_error && nullptr != listening_callback_ ) {
+                listening_callback_(this);
+            }
+        }
+    }
+    
+    // ... schedule next?
+    Schedule();
+}
+
+/**
+ * @brief Called when a connection to a subscription was closed.
+ *
+ * @return \li True if this object is no longer required.
+ *         \li False if this object must be kept alive.
+ */
+bool ev::postgresql::subscriptions::Request::Disconnected ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... for debug proposes only ...
+    ev::Logger::GetInstance().Log("postgresql_trace", loggable_data_,
+                                  "[%-30s] ::: WARNING ::: subscriptions connection is down ::: WARNING :::",
+                                  __FUNCTION__
+    );
+    
+    // ... pending command will never be delivered, all channels must be listened to again ...
+    pending_.clear();
+    queued_.clear();
+    sent_.clear();
+    confirmed_.clear();
+    busy_ = false;
+    
+    // ... notify owner?
+    if ( nullptr != disconnected_callback_ ) {
+        return ( true == disconnected_callback_(this) ) ? false : true;
+    } else {
+        return false;
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Listen to a set of channels.
+ *
+ * @param a_channels
+ */
+void ev::postgresql::subscriptions::Request::Listen (const std::set<std::string>& a_channels)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    for ( auto channel : a_channels ) {
+        if ( true == IsListening(channel) ) {
+            continue;
+        }
+        channels_.insert(channel);
+        queued_.insert(channel);
+        pending_.push_back("LISTEN " + Identifier(channel));
+    }
+    Schedule();
+}
+
+/**
+ * @brief Stop listening to a set of channels.
+ *
+ * @param a_channels
+ */
+void ev::postgresql::subscriptions::Request::Unlisten (const std::set<std::string>& a_channels)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    for ( auto channel : a_channels ) {
+        if ( false == IsListening(channel) ) {
+            continue;
+        }
+        channels_.erase(channel);
+        queued_.erase(channel);
+        sent_.erase(channel);
+        confirmed_.erase(channel);
+        pending_.push_back("UNLISTEN " + Identifier(channel));
+    }
+    Schedule();
+}
+
+/**
+ * @brief Listen again to all channels, after a connection was lost.
+ */
+void ev::postgresql::subscriptions::Request::Resubscribe ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    pending_.clear();
+    queued_.clear();
+    confirmed_.clear();
+    for ( auto channel : channels_ ) {
+        queued_.insert(channel);
+        pending_.push_back("LISTEN " + Identifier(channel));
+    }
+    // ... even without channels, connection must be restored ...
+    if ( 0 == pending_.size() ) {
+        pending_.push_back("SELECT 1");
+    }
+    Schedule();
+}
+
+/**
+ * @brief Schedule pending commands, if not busy.
+ */
+void ev::postgresql::subscriptions::Request::Schedule ()
+{
+    if ( false == busy_ && pending_.size() > 0 ) {
+        // ... using commit callback ...
+        commit_callback_(this);
+    }
+}
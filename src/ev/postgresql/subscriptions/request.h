@@ -0,0 +1,151 @@
+/**
+ * @file request.h - PostgreSQL subscriptions Request
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_SUBSCRIPTIONS_REQUEST_H_
+#define NRS_EV_POSTGRESQL_SUBSCRIPTIONS_REQUEST_H_
+
+#include "ev/scheduler/subscription.h"
+
+#include "ev/postgresql/request.h"
+#include "ev/postgresql/notification.h"
+
+#include <set>    // std::set
+#include <deque>  // std::deque
+#include <string> // std::string
+
+namespace ev
+{
+    
+    namespace postgresql
+    {
+        
+        namespace subscriptions
+        {
+            
+            //
+            // A single connection, kept alive, that issues 'LISTEN' / 'UNLISTEN' commands and receives asynchronous notifications.
+            //
+            
+            class Request final : public ev::scheduler::Subscription
+            {
+                
+            public: // Data Type(s)
+                
+#ifndef EV_POSTGRESQL_NOTIFICATION_CALLBACK
+    #define EV_POSTGRESQL_NOTIFICATION_CALLBACK std::function<void(const ev::postgresql::Notification* a_notification)>
+#endif
+                
+#ifndef EV_POSTGRESQL_LISTENING_CALLBACK
+    #define EV_POSTGRESQL_LISTENING_CALLBACK std::function<void(ev::postgresql::subscriptions::Request* a_request)>
+#endif
+                
+#ifndef EV_POSTGRESQL_DISCONNECTED_CALLBACK
+    #define EV_POSTGRESQL_DISCONNECTED_CALLBACK std::function<bool(ev::postgresql::subscriptions::Request* a_request)>
+#endif
+                
+            private: // Callbacks
+                
+                EV_POSTGRESQL_NOTIFICATION_CALLBACK notification_callback_;
+                EV_POSTGRESQL_LISTENING_CALLBACK    listening_callback_;
+                EV_POSTGRESQL_DISCONNECTED_CALLBACK disconnected_callback_;
+                
+            private: // Const Data
+                
+                const Loggable::Data                loggable_data_;
+                
+            private: // Data
+                
+                std::set<std::string>               channels_;    //!< Channels to listen to, listening or pending.
+                std::set<std::string>               queued_;      //!< Channels whose 'LISTEN' command is pending, not yet sent.
+                std::set<std::string>               sent_;        //!< Channels whose 'LISTEN' command is running.
+                std::set<std::string>               confirmed_;   //!< Channels whose 'LISTEN' command succeeded, on current connection.
+                std::deque<std::string>             pending_;     //!< Pending commands.
+                bool                                busy_;        //!< True while a command is running.
+                ev::postgresql::Request*            request_ptr_; //!< Pointer to the request that will be kept alive, for notifications delivery.
+                
+            public: // Constructor(s) / Destructor
+                
+                Request (const Loggable::Data& a_loggable_data,
+                         EV_SUBSCRIPTION_COMMIT_CALLBACK a_commit_callback, EV_POSTGRESQL_NOTIFICATION_CALLBACK a_notification_callback,
+                         EV_POSTGRESQL_LISTENING_CALLBACK a_listening_callback, EV_POSTGRESQL_DISCONNECTED_CALLBACK a_disconnected_callback);
+                virtual ~Request ();
+                
+            public: // Inherited Method(s) / Function(s)
+                
+                virtual bool Step         (ev::Object* a_object, ev::Request** o_request);
+                virtual void Publish      (std::vector<ev::Result*>& a_results);
+                virtual bool Disconnected ();
+                
+            public: // Method(s) / Function(s)
+                
+                void Listen      (const std::set<std::string>& a_channels);
+                void Unlisten    (const std::set<std::string>& a_channels);
+                bool IsListening (const std::string& a_channel) const;
+                bool IsConfirmed (const std::string& a_channel) const;
+                void Resubscribe ();
+                
+            private: // Method(s) / Function(s)
+                
+                void Schedule ();
+                
+            private: // Inline Method(s) / Function(s)
+                
+                std::string Identifier (const std::string& a_name) const;
+                
+            }; // end of class 'Request'
+            
+            /**
+             * @brief Check if a channel is being listened to, or if it's pending.
+             *
+             * @param a_channel
+             */
+            inline bool Request::IsListening (const std::string& a_channel) const
+            {
+                return ( channels_.end() != channels_.find(a_channel) );
+            }
+            
+            /**
+             * @brief Check if a channel 'LISTEN' command succeeded on current connection, notifications are being received.
+             *
+             * @param a_channel
+             */
+            inline bool Request::IsConfirmed (const std::string& a_channel) const
+            {
+                return ( confirmed_.end() != confirmed_.find(a_channel) );
+            }
+            
+            /**
+             * @return A quoted identifier, channel names are case sensitive.
+             *
+             * @param a_name
+             */
+            inline std::string Request::Identifier (const std::string& a_name) const
+            {
+                return ::ev::postgresql::Request::Identifier(a_name);
+            }
+            
+        } // end of namespace 'subscriptions'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_SUBSCRIPTIONS_REQUEST_H_
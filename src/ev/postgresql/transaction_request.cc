@@ -0,0 +1,108 @@
+/**
+ * @file transaction_request.cc - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/postgresql/transaction_request.h"
+
+#include "ev/exception.h"
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_loggable_data
+ * @param a_step           One of \link Step \link.
+ * @param a_argument       Statement for 'Begin' ( optional ) and 'Statement', savepoint name for savepoint steps, ignored otherwise.
+ */
+ev::postgresql::TransactionRequest::TransactionRequest (const ::ev::Loggable::Data& a_loggable_data, const ev::postgresql::TransactionRequest::Step a_step,
+                                                        const std::string& a_argument)
+    : ev::postgresql::Request(a_loggable_data,
+                              Query(a_step, a_argument),
+                              ( ev::postgresql::TransactionRequest::Step::Commit == a_step || ev::postgresql::TransactionRequest::Step::Rollback == a_step
+                                    ? ev::Request::Control::Unpin
+                                    : ev::Request::Control::Pin
+                              )
+      ),
+      step_(a_step)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor
+ */
+ev::postgresql::TransactionRequest::~TransactionRequest ()
+{
+    /* empty */
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @return A new 'ROLLBACK' request, to be issued if the task is released before 'Commit' or 'Rollback'.
+ *
+ * @remarks It's dropped by the hub if the device is no longer pinned, so it won't be executed by an unrelated device.
+ */
+ev::Request* ev::postgresql::TransactionRequest::AbortRequest () const
+{
+    return new ev::postgresql::Request(loggable_data_, std::string("ROLLBACK;"), ev::Request::Control::Abort);
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Build a step query.
+ *
+ * @param a_step     One of \link Step \link.
+ * @param a_argument See constructor.
+ *
+ * @return The query to execute.
+ */
+std::string ev::postgresql::TransactionRequest::Query (const ev::postgresql::TransactionRequest::Step a_step, const std::string& a_argument)
+{
+    switch (a_step) {
+        case ev::postgresql::TransactionRequest::Step::Begin:
+            return ( 0 == a_argument.length() ? "BEGIN;" : "BEGIN; " + a_argument );
+        case ev::postgresql::TransactionRequest::Step::Commit:
+            return "COMMIT;";
+        case ev::postgresql::TransactionRequest::Step::Rollback:
+            return "ROLLBACK;";
+        default:
+            break;
+    }
+    if ( 0 == a_argument.length() ) {
+        throw ev::Exception("A %s is required for this transaction step!",
+                            ev::postgresql::TransactionRequest::Step::Statement == a_step ? "statement" : "savepoint name"
+        );
+    }
+    switch (a_step) {
+        case ev::postgresql::TransactionRequest::Step::Savepoint:
+            return "SAVEPOINT " + ev::postgresql::Request::Identifier(a_argument) + ";";
+        case ev::postgresql::TransactionRequest::Step::RollbackTo:
+            return "ROLLBACK TO SAVEPOINT " + ev::postgresql::Request::Identifier(a_argument) + ";";
+        case ev::postgresql::TransactionRequest::Step::Release:
+            return "RELEASE SAVEPOINT " + ev::postgresql::Request::Identifier(a_argument) + ";";
+        default:
+            return a_argument;
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file transaction_request.h - PostgreSQL
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_POSTGRESQL_TRANSACTION_REQUEST_H_
+#define NRS_EV_POSTGRESQL_TRANSACTION_REQUEST_H_
+
+#include "ev/postgresql/request.h"
+
+#include <string> // std::string
+
+namespace ev
+{
+    namespace postgresql
+    {
+        
+        /**
+         * @brief A transaction step, a task should issue a 'Begin', followed by zero or more 'Statement' or savepoint steps
+         *        and a 'Commit' or 'Rollback' step.
+         *
+         * @remarks The same device is pinned to the task from 'Begin' until 'Commit' or 'Rollback'. A failed statement
+         *          keeps the device pinned, so the task can 'RollbackTo' a savepoint. If the task is released before
+         *          'Commit' or 'Rollback' ( 'Catch', unregistered client ) a 'ROLLBACK' is issued on it's behalf, if it
+         *          stops issuing steps the device is destroyed and the server rolls back the transaction.
+         *          Each step reply is delivered to the next task step, the statement result is the last data object.
+         */
+        class TransactionRequest final : public Request
+        {
+            
+        public: // Data Type(s)
+            
+            enum class Step : uint8_t
+            {
+                Begin,      //!< 'BEGIN' and, optionally, execute first statement.
+                Statement,  //!< Execute statement.
+                Savepoint,  //!< 'SAVEPOINT'.
+                RollbackTo, //!< 'ROLLBACK TO SAVEPOINT'.
+                Release,    //!< 'RELEASE SAVEPOINT'.
+                Commit,     //!< 'COMMIT'.
+                Rollback    //!< 'ROLLBACK'.
+            };
+            
+        public: // Const Data
+            
+            const Step step_; //!< One of \link Step \link.
+            
+        public: // Constructor(s) / Destructor
+            
+            TransactionRequest(const Loggable::Data& a_loggable_data, const Step a_step, const std::string& a_argument = "");
+            virtual ~TransactionRequest();
+            
+        public: // Inherited Virtual Method(s) / Function(s)
+            
+            virtual ev::Request* AbortRequest () const;
+            
+        private: // Static Method(s) / Function(s)
+            
+            static std::string Query (const Step a_step, const std::string& a_argument);
+            
+        }; // end of class 'TransactionRequest'
+        
+    } // end of namespace 'postgresql'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_POSTGRESQL_TRANSACTION_REQUEST_H_
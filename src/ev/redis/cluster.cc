@@ -0,0 +1,494 @@
+/**
+ * @file cluster.cc - REDIS Cluster
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/cluster.h"
+
+#include "ev/redis/request.h"
+
+#include "ev/exception.h"
+
+#include "osal/osalite.h"
+
+#include <algorithm> // std::max
+#include <cstdlib>   // std::strtol
+
+std::vector<ev::redis::Cluster::Node> ev::redis::Cluster::seeds_               = {};
+std::vector<ev::redis::Cluster::Node> ev::redis::Cluster::nodes_               = {};
+std::vector<int>                      ev::redis::Cluster::slots_               = {};
+size_t                                ev::redis::Cluster::next_                = 0;
+int64_t                               ev::redis::Cluster::refresh_interval_ms_ = 0;
+bool                                  ev::redis::Cluster::refresh_             = false;
+bool                                  ev::redis::Cluster::aborted_             = false;
+std::thread*                          ev::redis::Cluster::thread_              = nullptr;
+std::mutex                            ev::redis::Cluster::mutex_;
+std::condition_variable               ev::redis::Cluster::cv_;
+
+const int                             ev::redis::Cluster::k_slots_count_                 = 16384;
+const int64_t                         ev::redis::Cluster::k_default_refresh_interval_ms_ = 30000; // 30s
+
+// ... CRC16-CCITT ( XMODEM ), as used by REDIS Cluster to compute key slots ...
+const uint16_t                        ev::redis::Cluster::k_crc16_table_[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+};
+
+/**
+ * @brief One-shot initializer, starts background topology loading.
+ *
+ * @param a_nodes               Seed nodes, as '<ip address>:<port number>', any cluster node can be used.
+ * @param a_refresh_interval_ms Topology refresh interval, in milliseconds, a refresh is also requested by 'MOVED' redirects.
+ */
+void ev::redis::Cluster::Startup (const std::vector<std::string>& a_nodes, const int64_t a_refresh_interval_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr != thread_ ) {
+        throw ev::Exception("REDIS cluster already configured!");
+    }
+    
+    // ... nothing to do?
+    if ( 0 == a_nodes.size() ) {
+        return;
+    }
+    
+    std::vector<Node> seeds;
+    for ( auto endpoint : a_nodes ) {
+        Node node;
+        if ( false == Split(endpoint, node.ip_address_, node.port_number_) ) {
+            throw ev::Exception("Invalid REDIS cluster node '%s' - expected <ip address>:<port number>!", endpoint.c_str());
+        }
+        seeds.push_back(node);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        seeds_               = seeds;
+        nodes_.clear();
+        slots_.assign(static_cast<size_t>(k_slots_count_), -1);
+        next_                = 0;
+        refresh_interval_ms_ = std::max(a_refresh_interval_ms, static_cast<int64_t>(1000));
+        refresh_             = false;
+        aborted_             = false;
+    }
+    
+    thread_ = new std::thread(&ev::redis::Cluster::Loop, this);
+}
+
+/**
+ * @brief Call this to stop background topology loading and release previously allocated memory.
+ */
+void ev::redis::Cluster::Shutdown ()
+{
+    if ( nullptr != thread_ ) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            aborted_ = true;
+        }
+        cv_.notify_all();
+        thread_->join();
+        delete thread_;
+        thread_ = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    seeds_.clear();
+    nodes_.clear();
+    slots_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @return True if cluster mode was configured, false otherwise.
+ */
+bool ev::redis::Cluster::Enabled ()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ( 0 != seeds_.size() );
+}
+
+/**
+ * @brief Select the node a new device, that will execute a request, should connect to.
+ *
+ * @param a_request
+ * @param o_ip_address  Node IP address, untouched if topology is not known yet.
+ * @param o_port_number Node port number, untouched if topology is not known yet.
+ *
+ * @return True if a node was selected, false if device should connect to the configured endpoint.
+ *
+ * @remarks Requests without a key, or for a slot with an unknown owner, are spread over all nodes, round-robin.
+ */
+bool ev::redis::Cluster::Route (const ev::Request* a_request, std::string& o_ip_address, int& o_port_number)
+{
+    const ev::redis::Request* request = dynamic_cast<const ev::redis::Request*>(a_request);
+    const int                 slot    = ( nullptr != request ? request->Slot() : -1 );
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if ( 0 == nodes_.size() ) {
+        return false;
+    }
+    
+    size_t index;
+    if ( slot >= 0 && slot < static_cast<int>(slots_.size()) && slots_[static_cast<size_t>(slot)] >= 0 ) {
+        index = static_cast<size_t>(slots_[static_cast<size_t>(slot)]);
+    } else {
+        index = next_ % nodes_.size();
+        next_ = ( index + 1 ) % nodes_.size();
+    }
+    
+    o_ip_address  = nodes_[index].ip_address_;
+    o_port_number = nodes_[index].port_number_;
+    
+    return true;
+}
+
+/**
+ * @brief Check if a node owns a slot.
+ *
+ * @param a_ip_address
+ * @param a_port_number
+ * @param a_slot        Key slot, -1 if request has no key.
+ *
+ * @return True if so or if owner is unknown, false if slot is known to be served by another node.
+ */
+bool ev::redis::Cluster::Owns (const std::string& a_ip_address, const int a_port_number, const int a_slot)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if ( a_slot < 0 || a_slot >= static_cast<int>(slots_.size()) || slots_[static_cast<size_t>(a_slot)] < 0 ) {
+        return true;
+    }
+    
+    const Node& node = nodes_[static_cast<size_t>(slots_[static_cast<size_t>(a_slot)])];
+    return ( a_port_number == node.port_number_ && a_ip_address == node.ip_address_ );
+}
+
+/**
+ * @brief Record a slot owner learned from a 'MOVED' redirect and request a topology refresh.
+ *
+ * @param a_slot
+ * @param a_ip_address
+ * @param a_port_number
+ */
+void ev::redis::Cluster::Moved (const int a_slot, const std::string& a_ip_address, const int a_port_number)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ( a_slot >= 0 && a_slot < static_cast<int>(slots_.size()) ) {
+            slots_[static_cast<size_t>(a_slot)] = static_cast<int>(Index(a_ip_address, a_port_number));
+        }
+        // ... other slots were probably moved too ...
+        refresh_ = true;
+    }
+    cv_.notify_all();
+}
+
+/**
+ * @brief Request a topology refresh, it will be performed in background.
+ */
+void ev::redis::Cluster::Refresh ()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refresh_ = true;
+    }
+    cv_.notify_all();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Compute a key slot.
+ *
+ * @param a_key
+ * @param a_length
+ *
+ * @return Key slot, only the first non-empty '{...}' hash tag is hashed, if any.
+ */
+int ev::redis::Cluster::Slot (const char* const a_key, const size_t a_length)
+{
+    size_t start = 0;
+    size_t end   = a_length;
+    for ( size_t idx = 0 ; idx < a_length ; ++idx ) {
+        if ( '{' == a_key[idx] ) {
+            size_t close = idx + 1;
+            while ( close < a_length && '}' != a_key[close] ) {
+                ++close;
+            }
+            if ( close < a_length && close > idx + 1 ) {
+                start = idx + 1;
+                end   = close;
+            }
+            break;
+        }
+    }
+    
+    uint16_t crc = 0;
+    for ( size_t idx = start ; idx < end ; ++idx ) {
+        crc = static_cast<uint16_t>(( crc << 8 ) ^ k_crc16_table_[( ( crc >> 8 ) ^ static_cast<uint8_t>(a_key[idx]) ) & 0xFF]);
+    }
+    
+    return static_cast<int>(crc & ( k_slots_count_ - 1 ));
+}
+
+/**
+ * @brief Parse a '-MOVED <slot> <ip>:<port>' or '-ASK <slot> <ip>:<port>' error reply.
+ *
+ * @param a_reply
+ * @param o_ask         True if it's a one-time 'ASK' redirect.
+ * @param o_slot
+ * @param o_ip_address
+ * @param o_port_number
+ *
+ * @return True if reply is a redirect, false otherwise.
+ */
+bool ev::redis::Cluster::Redirection (const struct redisReply* a_reply,
+                                      bool& o_ask, int& o_slot, std::string& o_ip_address, int& o_port_number)
+{
+    if ( nullptr == a_reply || REDIS_REPLY_ERROR != a_reply->type || nullptr == a_reply->str ) {
+        return false;
+    }
+    
+    const std::string error(a_reply->str, a_reply->len);
+    
+    size_t offset;
+    if ( 0 == error.compare(0, 6, "MOVED ") ) {
+        o_ask  = false;
+        offset = 6;
+    } else if ( 0 == error.compare(0, 4, "ASK ") ) {
+        o_ask  = true;
+        offset = 4;
+    } else {
+        return false;
+    }
+    
+    const size_t separator = error.find(' ', offset);
+    if ( std::string::npos == separator || separator == offset ) {
+        return false;
+    }
+    
+    char* end = nullptr;
+    const long slot = std::strtol(error.c_str() + offset, &end, 10);
+    if ( end != error.c_str() + separator || slot < 0 || slot >= k_slots_count_ ) {
+        return false;
+    }
+    
+    o_slot = static_cast<int>(slot);
+    
+    return Split(error.substr(separator + 1), o_ip_address, o_port_number);
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Background thread loop, periodically, or when requested, reloads the slot map.
+ */
+void ev::redis::Cluster::Loop ()
+{
+    while ( true ) {
+        
+        // ... known nodes first, seeds are the last resort ...
+        std::vector<Node> candidates;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            candidates = nodes_;
+            candidates.insert(candidates.end(), seeds_.begin(), seeds_.end());
+            refresh_ = false;
+        }
+        
+        // ... load, without holding the lock, it may block ...
+        for ( auto& candidate : candidates ) {
+            if ( true == Load(candidate) ) {
+                break;
+            }
+        }
+        
+        // ... wait for next refresh or shutdown ...
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::milliseconds(refresh_interval_ms_), [] { return aborted_ || refresh_; });
+        if ( true == aborted_ ) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Synchronously load the slot map from a node, using 'CLUSTER SLOTS'.
+ *
+ * @param a_node
+ *
+ * @return True if slot map was loaded and replaced, false if node is unreachable or reply is unexpected.
+ */
+bool ev::redis::Cluster::Load (const ev::redis::Cluster::Node& a_node)
+{
+    const struct timeval timeout = { 1, 0 };
+    
+    redisContext* context = redisConnectWithTimeout(a_node.ip_address_.c_str(), a_node.port_number_, timeout);
+    if ( nullptr == context ) {
+        return false;
+    }
+    if ( 0 != context->err ) {
+        redisFree(context);
+        return false;
+    }
+    (void) redisSetTimeout(context, timeout);
+    
+    std::vector<Node> nodes;
+    std::vector<int>  slots(static_cast<size_t>(k_slots_count_), -1);
+    
+    // ... [ [ <start>, <end>, [ <ip>, <port>, ... ], <replicas> ... ], ... ] ...
+    redisReply* reply = static_cast<redisReply*>(redisCommand(context, "CLUSTER SLOTS"));
+    if ( nullptr != reply && REDIS_REPLY_ARRAY == reply->type ) {
+        for ( size_t idx = 0 ; idx < reply->elements ; ++idx ) {
+            const redisReply* range = reply->element[idx];
+            if ( REDIS_REPLY_ARRAY != range->type || range->elements < 3
+                ||
+                REDIS_REPLY_INTEGER != range->element[0]->type || REDIS_REPLY_INTEGER != range->element[1]->type
+                ||
+                REDIS_REPLY_ARRAY != range->element[2]->type || range->element[2]->elements < 2
+            ) {
+                continue;
+            }
+            const redisReply* master = range->element[2];
+            if ( REDIS_REPLY_STRING != master->element[0]->type || REDIS_REPLY_INTEGER != master->element[1]->type ) {
+                continue;
+            }
+            Node node = { std::string(master->element[0]->str, master->element[0]->len), static_cast<int>(master->element[1]->integer) };
+            // ... an empty endpoint means 'same as the node that replied', '?' means unknown ...
+            if ( 0 == node.ip_address_.length() ) {
+                node.ip_address_ = a_node.ip_address_;
+            } else if ( 0 == node.ip_address_.compare("?") ) {
+                continue;
+            }
+            size_t index = 0;
+            while ( index < nodes.size() && ( node.port_number_ != nodes[index].port_number_ || node.ip_address_ != nodes[index].ip_address_ ) ) {
+                ++index;
+            }
+            if ( nodes.size() == index ) {
+                nodes.push_back(node);
+            }
+            const long long last = std::min(range->element[1]->integer, static_cast<long long>(k_slots_count_ - 1));
+            for ( long long slot = std::max(range->element[0]->integer, 0LL) ; slot <= last ; ++slot ) {
+                slots[static_cast<size_t>(slot)] = static_cast<int>(index);
+            }
+        }
+    }
+    if ( nullptr != reply ) {
+        freeReplyObject(reply);
+    }
+    redisFree(context);
+    
+    if ( 0 == nodes.size() ) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    nodes_.swap(nodes);
+    slots_.swap(slots);
+    next_ = 0;
+    
+    return true;
+}
+
+/**
+ * @brief Find, or add, a node.
+ *
+ * @param a_ip_address
+ * @param a_port_number
+ *
+ * @return Node index.
+ *
+ * @remarks Mutex must be locked by caller.
+ */
+size_t ev::redis::Cluster::Index (const std::string& a_ip_address, const int a_port_number)
+{
+    for ( size_t index = 0 ; index < nodes_.size() ; ++index ) {
+        if ( a_port_number == nodes_[index].port_number_ && a_ip_address == nodes_[index].ip_address_ ) {
+            return index;
+        }
+    }
+    nodes_.push_back({ a_ip_address, a_port_number });
+    return nodes_.size() - 1;
+}
+
+/**
+ * @brief Split a '<ip address>:<port number>' endpoint.
+ *
+ * @param a_endpoint
+ * @param o_ip_address
+ * @param o_port_number
+ *
+ * @return True on success, false if endpoint is invalid.
+ */
+bool ev::redis::Cluster::Split (const std::string& a_endpoint, std::string& o_ip_address, int& o_port_number)
+{
+    const size_t separator = a_endpoint.rfind(':');
+    if ( std::string::npos == separator || 0 == separator || a_endpoint.length() - 1 == separator ) {
+        return false;
+    }
+    
+    char* end = nullptr;
+    const long port = std::strtol(a_endpoint.c_str() + separator + 1, &end, 10);
+    if ( '\0' != *end || port <= 0 || port > 65535 ) {
+        return false;
+    }
+    
+    o_ip_address  = a_endpoint.substr(0, separator);
+    o_port_number = static_cast<int>(port);
+    
+    return true;
+}
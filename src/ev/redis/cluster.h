@@ -0,0 +1,117 @@
+/**
+ * @file cluster.h - REDIS Cluster
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_CLUSTER_H_
+#define NRS_EV_REDIS_CLUSTER_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/request.h"
+
+#include "ev/redis/includes.h"
+
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex
+#include <condition_variable> // std::condition_variable
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        /**
+         * @brief Keeps track of a REDIS Cluster slot map, topology is ( re )loaded in background by a dedicated thread.
+         *
+         * @remarks Each \link ev::redis::Device \link connects to a single node, requests are routed to devices connected
+         *          to the node that owns their key slot, see \link Route \link and \link Owns \link.
+         */
+        class Cluster final : public osal::Singleton<Cluster>
+        {
+            
+        private: // Data Type(s)
+            
+            typedef struct {
+                std::string ip_address_;  //!< Node IP address.
+                int         port_number_; //!< Node port number.
+            } Node;
+            
+        public: // Static Const Data
+            
+            static const int              k_slots_count_;
+            static const int64_t          k_default_refresh_interval_ms_;
+            
+        private: // Static Const Data
+            
+            static const uint16_t         k_crc16_table_[256];
+            
+        private: // Static Data
+            
+            static std::vector<Node>        seeds_;
+            static std::vector<Node>        nodes_;
+            static std::vector<int>         slots_;
+            static size_t                   next_;
+            static int64_t                  refresh_interval_ms_;
+            static bool                     refresh_;
+            static bool                     aborted_;
+            static std::thread*             thread_;
+            static std::mutex               mutex_;
+            static std::condition_variable  cv_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const std::vector<std::string>& a_nodes,
+                           const int64_t a_refresh_interval_ms = k_default_refresh_interval_ms_);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool Enabled ();
+            bool Route   (const ev::Request* a_request, std::string& o_ip_address, int& o_port_number);
+            bool Owns    (const std::string& a_ip_address, const int a_port_number, const int a_slot);
+            void Moved   (const int a_slot, const std::string& a_ip_address, const int a_port_number);
+            void Refresh ();
+            
+        public: // Static Method(s) / Function(s)
+            
+            static int  Slot        (const char* const a_key, const size_t a_length);
+            static bool Redirection (const struct redisReply* a_reply,
+                                     bool& o_ask, int& o_slot, std::string& o_ip_address, int& o_port_number);
+            
+        private: // Method(s) / Function(s)
+            
+            void   Loop  ();
+            bool   Load  (const Node& a_node);
+            size_t Index (const std::string& a_ip_address, const int a_port_number);
+            
+        private: // Static Method(s) / Function(s)
+            
+            static bool Split (const std::string& a_endpoint, std::string& o_ip_address, int& o_port_number);
+            
+        }; // end of class 'Cluster'
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_CLUSTER_H_
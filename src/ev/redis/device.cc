@@ -24,11 +24,18 @@
 #include "ev/redis/error.h"
 
 #include "ev/redis/subscriptions/reply.h"
+#include "ev/redis/tracking_cache.h"
+#include "ev/redis/cluster.h"
+#include "ev/redis/sentinel.h"
 
 #include "ev/logger.h"
 
 #include "osal/osalite.h"
 
+#include <algorithm> // std::max
+
+const size_t ev::redis::Device::k_max_redirects_ = 5;
+
 /**
  * @brief Default constructor.
  *
@@ -36,16 +43,26 @@
  * @param a_ip_address
  * @param a_port_number
  * @param a_database_index
+ * @param a_pipeline_depth Maximum number of requests sent and waiting for a reply, see \link PipelineDepth \link.
+ * @param a_replica        True when \p a_ip_address and \p a_port_number are a replica endpoint, see \link ev::redis::Sentinel::Route \link.
  */
 ev::redis::Device::Device (const Loggable::Data& a_loggable_data,
-                           const char* const a_ip_address, const int a_port_number, const int a_database_index)
+                           const char* const a_ip_address, const int a_port_number, const int a_database_index,
+                           const size_t a_pipeline_depth, const bool a_replica)
     : ev::Device(a_loggable_data),
-      ip_address_(a_ip_address), port_number_(a_port_number), database_index_(a_database_index)
+      ip_address_(a_ip_address), port_number_(a_port_number), database_index_(a_database_index),
+      pipeline_depth_(std::max(a_pipeline_depth, static_cast<size_t>(1)))
 {
-    request_ptr_       = nullptr;
-    hiredis_context_   = nullptr;
-    database_request_  = nullptr;
-    database_selected_ = false;
+    request_ptr_         = nullptr;
+    hiredis_context_     = nullptr;
+    database_request_    = nullptr;
+    database_selected_   = false;
+    ping_request_        = nullptr;
+    tracking_id_         = -1;
+    tracking_pending_id_ = -1;
+    cluster_             = ::ev::redis::Cluster::GetInstance().Enabled();
+    sentinel_            = ::ev::redis::Sentinel::GetInstance().Enabled();
+    replica_             = a_replica;
 }
 
 /**
@@ -63,6 +80,16 @@ ev::redis::Device::~Device ()
     if ( nullptr != database_request_ ) {
         delete database_request_;
     }
+    if ( nullptr != ping_request_ ) {
+        delete ping_request_;
+    }
+    // ... pending redirected replies will be discarded by their callbacks ...
+    const RedirectsMap redirects = redirects_;
+    for ( auto it : redirects ) {
+        it.second->data = nullptr;
+        redisAsyncDisconnect(it.second);
+    }
+    redirects_.clear();
 }
 
 #ifdef __APPLE__
@@ -90,12 +117,19 @@ ev::redis::Device::Status ev::redis::Device::Connect (ev::redis::Device::Connect
 
     connected_callback_ = a_callback;
 
-    hiredis_context_ = redisAsyncConnect(ip_address_.c_str(), port_number_);
+    hiredis_context_     = redisAsyncConnect(ip_address_.c_str(), port_number_);
+    tracking_id_         = -1;
+    tracking_pending_id_ = -1;
     if ( nullptr == hiredis_context_ ) {
         connected_callback_ = nullptr;
         return ev::redis::Device::Status::OutOfMemory;
     }
 
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+    // ... replies are adopted by \link ReplyHandle \link instead of being copied ...
+    hiredis_context_->c.flags |= REDIS_NO_AUTO_FREE_REPLIES;
+#endif
+
     if ( REDIS_OK != redisLibeventAttach(hiredis_context_, event_base_ptr_) ) {
         connected_callback_ = nullptr;
         return ev::redis::Device::Status::Error;
@@ -133,6 +167,12 @@ ev::redis::Device::Status ev::redis::Device::Disconnect (ev::redis::Device::Disc
     
     disconnected_callback_ = a_callback;
 
+    // ... connections used to follow redirects are closed after their pending replies are delivered ...
+    const RedirectsMap redirects = redirects_;
+    for ( auto it : redirects ) {
+        redisAsyncDisconnect(it.second);
+    }
+    
     redisAsyncDisconnect(hiredis_context_);
 
     // ... asynchronous disconnect ...
@@ -162,18 +202,38 @@ ev::redis::Device::Status ev::redis::Device::Execute (ev::redis::Device::Execute
         return ev::redis::Device::Status::Error;
     }
     
+    // ... connected to a former master or replica?
+    if ( true == Stale() ) {
+        // ... it will be released after this request ...
+        InvalidateReuse();
+    }
+    
     ev::redis::Device::Status rv;
+    
+    // ... client side caching: enable tracking, redirected to the subscriptions connection, before reading ...
+    ::ev::redis::TrackingCache& tracking_cache = ::ev::redis::TrackingCache::GetInstance();
+    uint64_t                    generation     = 0;
+    if ( true == tracking_cache.Enabled() && ev::redis::Request::Kind::Subscription != redis_request->kind() ) {
+        generation = tracking_cache.Generation();
+        const long long redirect_id = tracking_cache.RedirectID();
+        if ( -1 != redirect_id && redirect_id != tracking_id_ && redirect_id != tracking_pending_id_ ) {
+            if ( REDIS_OK == redisAsyncCommand(hiredis_context_, HiredisTrackingCallback, nullptr, "CLIENT TRACKING on REDIRECT %lld", redirect_id) ) {
+                tracking_pending_id_ = redirect_id;
+            }
+        }
+    }
 
-    execute_callback_ = a_callback;
-    request_ptr_      = redis_request;
+    // ... replies are delivered in the same order commands were sent, request is also it's reply private data ...
+    in_flight_.push_back({ redis_request, a_callback, generation, false });
+    request_ptr_ = redis_request;
     
-    const std::string& payload = redis_request->AsString();
+    const std::string& payload = redis_request->Payload();
 
     int async_rv;
-    if ( REDIS_OK != ( async_rv = redisAsyncFormattedCommand(hiredis_context_, HiredisDataCallback, nullptr, payload.c_str(), payload.length()) ) ) {
-        rv                = ev::redis::Device::Status::Error;
-        execute_callback_ = nullptr;
-        request_ptr_      = nullptr;
+    if ( REDIS_OK != ( async_rv = redisAsyncFormattedCommand(hiredis_context_, HiredisDataCallback, const_cast<ev::redis::Request*>(redis_request), payload.c_str(), payload.length()) ) ) {
+        rv           = ev::redis::Device::Status::Error;
+        request_ptr_ = nullptr;
+        in_flight_.pop_back();
     } else {
         rv = ev::redis::Device::Status::Async;
     }
@@ -185,6 +245,140 @@ ev::redis::Device::Status ev::redis::Device::Execute (ev::redis::Device::Execute
     return rv;    
 }
 
+/**
+ * @brief Probe the current REDIS connection by sending a PING command.
+ *
+ * @param a_callback
+ *
+ * @return One of \link ev::redis::Device::Status \link.
+ */
+ev::redis::Device::Status ev::redis::Device::Ping (ev::redis::Device::ExecuteCallback a_callback)
+{
+    // ... no connection, already probing or connected to a former master or replica ( it must be replaced )?
+    if ( nullptr == hiredis_context_ || nullptr != ping_request_ || true == Stale() ) {
+        // ... can't probe connection ...
+        return ev::redis::Device::Status::Error;
+    }
+    
+    // ... create a 'special' request ...
+    ping_request_ = new ev::redis::Request(loggable_data_, "PING", {});
+    
+    // ... it will be released when reply is received ...
+    const ev::redis::Device::Status rv = Execute([this, a_callback] (const ev::Device::ExecutionStatus& a_status, ev::Result* a_result) {
+        if ( request_ptr_ == ping_request_ ) {
+            request_ptr_ = nullptr;
+        }
+        delete ping_request_;
+        ping_request_ = nullptr;
+        a_callback(a_status, a_result);
+    }, ping_request_);
+    
+    if ( ev::redis::Device::Status::Async != rv ) {
+        delete ping_request_;
+        ping_request_ = nullptr;
+    }
+    
+    return rv;
+}
+
+/**
+ * @return Maximum number of requests this device can execute at the same time, right now.
+ *
+ * @remarks Requests are only pipelined after database is selected and never while subscribed to channels.
+ */
+size_t ev::redis::Device::PipelineDepth () const
+{
+    if ( nullptr == hiredis_context_ || ev::Device::ConnectionStatus::Connected != connection_status_
+        ||
+        ( -1 != database_index_ && false == cluster_ && false == database_selected_ )
+        ||
+        ( nullptr != request_ptr_ && ev::redis::Request::Kind::Subscription == request_ptr_->kind() )
+    ) {
+        return 1;
+    }
+    return pipeline_depth_;
+}
+
+/**
+ * @brief Check how well suited this device is to execute a request.
+ *
+ * @param a_request
+ *
+ * @return One of \link ev::Device::Affinity \link.
+ *
+ * @remarks In cluster mode, a device only executes requests for slots owned by the node it's connected to.
+ *          With sentinel, replicas only execute read only requests, master executes read only requests only as a
+ *          fallback while there's a healthy replica and devices connected to a former master execute nothing.
+ */
+ev::Device::Affinity ev::redis::Device::AffinityFor (const ev::Request* a_request) const
+{
+    const ev::redis::Request* request = dynamic_cast<const ev::redis::Request*>(a_request);
+    if ( true == cluster_ ) {
+        if ( nullptr != request && false == ::ev::redis::Cluster::GetInstance().Owns(ip_address_, port_number_, request->Slot()) ) {
+            return ev::Device::Affinity::None;
+        }
+    } else if ( true == sentinel_ ) {
+        const bool read_only = ( nullptr != request && true == request->ReadOnly() );
+        if ( true == Stale() || ( true == replica_ && false == read_only ) ) {
+            return ev::Device::Affinity::None;
+        }
+        if ( false == replica_ && true == read_only && true == ::ev::redis::Sentinel::GetInstance().HasReplicas() ) {
+            return ev::Device::Affinity::Fallback;
+        }
+    }
+    return ev::Device::Affinity::Preferred;
+}
+
+/**
+ * @brief Load a script, with 'SCRIPT LOAD', and retry a request that failed with a 'NOSCRIPT' error on this connection.
+ *
+ * @param a_in_flight Request that failed.
+ * @param a_reply     Reply received for that request.
+ *
+ * @return True if request was re-sent, false if reply is not a 'NOSCRIPT' error or request was already retried.
+ *
+ * @remarks Retry is queued after all requests already sent, caller must remove \p a_in_flight from \link in_flight_ \link.
+ */
+bool ev::redis::Device::Reload (const ev::redis::Device::InFlight& a_in_flight, const struct redisReply* a_reply)
+{
+    const ev::redis::Script* script = a_in_flight.request_->script();
+    if ( nullptr == script || true == a_in_flight.reloaded_
+        ||
+        nullptr == a_reply || REDIS_REPLY_ERROR != a_reply->type || nullptr == a_reply->str || 0 != strncmp(a_reply->str, "NOSCRIPT", 8)
+    ) {
+        return false;
+    }
+    
+    // ... load reply is not relevant, retry reply will tell ...
+    if ( REDIS_OK != redisAsyncCommand(hiredis_context_, nullptr, nullptr, "SCRIPT LOAD %b", script->source().c_str(), script->source().length()) ) {
+        return false;
+    }
+    
+    in_flight_.push_back({ a_in_flight.request_, a_in_flight.callback_, a_in_flight.generation_, true });
+    
+    const std::string& payload = a_in_flight.request_->Payload();
+    if ( REDIS_OK != redisAsyncFormattedCommand(hiredis_context_, HiredisDataCallback, const_cast<ev::redis::Request*>(a_in_flight.request_), payload.c_str(), payload.length()) ) {
+        in_flight_.pop_back();
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @return True when discovered through sentinel and connected to a server that's no longer the master, or a healthy replica.
+ */
+bool ev::redis::Device::Stale () const
+{
+    if ( false == sentinel_ ) {
+        return false;
+    }
+    if ( true == replica_ ) {
+        return ( false == ::ev::redis::Sentinel::GetInstance().IsReplica(ip_address_, port_number_) );
+    }
+    return ( false == ::ev::redis::Sentinel::GetInstance().IsMaster(ip_address_, port_number_) );
+}
+
 /**
  * @return The last set error object, nullptr if none.
  */
@@ -331,6 +525,88 @@ void ev::redis::Device::DatabaseIndexSelectionCallback (const ev::redis::Device:
     delete a_result;
 }
 
+/**
+ * @brief Follow a REDIS Cluster 'MOVED' or 'ASK' redirect, by re-sending a request to the node that serves it's slot.
+ *
+ * @param a_in_flight Request that was redirected.
+ * @param a_reply     Reply received for that request.
+ * @param a_hops      Number of redirects already followed for that request.
+ *
+ * @return True if request was re-sent, false if reply is not a redirect or it can't be followed.
+ */
+bool ev::redis::Device::Forward (const ev::redis::Device::InFlight& a_in_flight, const struct redisReply* a_reply, const size_t a_hops)
+{
+    bool        ask;
+    int         slot;
+    std::string ip_address;
+    int         port_number;
+    if ( false == ::ev::redis::Cluster::Redirection(a_reply, ask, slot, ip_address, port_number) ) {
+        return false;
+    }
+    
+    // ... 'MOVED' is permanent, 'ASK' only applies to this request ( slot is being migrated ) ...
+    if ( false == ask ) {
+        ::ev::redis::Cluster::GetInstance().Moved(slot, ip_address, port_number);
+    }
+    
+    if ( a_hops >= k_max_redirects_ || nullptr == event_base_ptr_ ) {
+        return false;
+    }
+    
+    // ... reuse, or open, a connection to that node ...
+    const std::string  endpoint = ip_address + ':' + std::to_string(port_number);
+    redisAsyncContext* context  = nullptr;
+    const auto it = redirects_.find(endpoint);
+    if ( redirects_.end() != it ) {
+        context = it->second;
+    } else {
+        context = redisAsyncConnect(ip_address.c_str(), port_number);
+        if ( nullptr == context ) {
+            return false;
+        }
+        if ( 0 != context->err ) {
+            redisAsyncFree(context);
+            return false;
+        }
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+        context->c.flags |= REDIS_NO_AUTO_FREE_REPLIES;
+#endif
+        if ( REDIS_OK != redisLibeventAttach(context, event_base_ptr_) ) {
+            redisAsyncFree(context);
+            return false;
+        }
+        redisAsyncSetConnectCallback(context, HiredisRedirectConnectCallback);
+        redisAsyncSetDisconnectCallback(context, HiredisRedirectDisconnectCallback);
+        context->data = this;
+        redirects_[endpoint] = context;
+    }
+    
+    // ... commands are queued by HIREDIS until connection is established ...
+    if ( true == ask && REDIS_OK != redisAsyncCommand(context, nullptr, nullptr, "ASKING") ) {
+        return false;
+    }
+    
+    Redirect* redirect = new Redirect({ a_in_flight, a_hops + 1 });
+    
+    const std::string& payload = a_in_flight.request_->Payload();
+    if ( REDIS_OK != redisAsyncFormattedCommand(context, HiredisRedirectCallback, redirect, payload.c_str(), payload.length()) ) {
+        delete redirect;
+        return false;
+    }
+    
+    // ... for debug proposes only ...
+    ev::Logger::GetInstance().Log("redis_trace", a_in_flight.request_->loggable_data_,
+                                  "[%-30s] : %s slot %d to %s, hops = %zu",
+                                  __FUNCTION__,
+                                  true == ask ? "ASK" : "MOVED",
+                                  slot,
+                                  endpoint.c_str(),
+                                  redirect->hops_
+    );
+    
+    return true;
+}
+
 #ifdef __APPLE__
 #pragma mark - STATIC
 #endif
@@ -386,7 +662,7 @@ void ev::redis::Device::HiredisConnectCallback (const struct redisAsyncContext*
         );
         
         // ... should select a REDIS database before allowing to run any other command(s) ?
-        if ( ev::Device::ConnectionStatus::Connected == device->connection_status_ && -1 != device->database_index_ && false == device->database_selected_ ) {
+        if ( ev::Device::ConnectionStatus::Connected == device->connection_status_ && -1 != device->database_index_ && false == device->cluster_ && false == device->database_selected_ ) {
             
             // ... for debug proposes only ...
             ev::Logger::GetInstance().Log("redis_trace", loggable_data,
@@ -399,7 +675,7 @@ void ev::redis::Device::HiredisConnectCallback (const struct redisAsyncContext*
             
             // ... yes, create a 'special' request ...
             device->database_request_ = new ev::redis::Request(loggable_data,
-                                                               "SELECT", { std::to_string(device->database_index_) }
+                                                               "SELECT", { device->database_index_ }
             );
             
             // ... callbacks are now differ, it will be called when this 'special' request is done ...
@@ -611,6 +887,43 @@ void ev::redis::Device::HiredisDisconnectCallback (const struct redisAsyncContex
     }
 }
 
+/**
+ * @brief This method is called by HIREDIS deliver a 'CLIENT TRACKING' command reply.
+ *
+ * @param a_context
+ * @param a_reply
+ * @param a_priv_data
+ */
+void ev::redis::Device::HiredisTrackingCallback (struct redisAsyncContext* a_context, void* a_reply, void* /* a_priv_data */)
+{
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+    // ... reply tree is ours ...
+    const ev::redis::ReplyHandle handle = ev::redis::ReplyHandle::Adopt(static_cast<struct redisReply*>(a_reply));
+#endif
+    
+    if ( nullptr == a_context || nullptr == a_context->data ) {
+        // ... no context or device already released ...
+        return;
+    }
+    
+    ev::redis::Device*       device = static_cast<ev::redis::Device*>(a_context->data);
+    const struct redisReply* reply  = static_cast<const struct redisReply*>(a_reply);
+    
+    // ... '+OK' expected, otherwise replies read from this connection won't be cached ...
+    device->tracking_id_         = ( nullptr != reply && REDIS_REPLY_STATUS == reply->type ? device->tracking_pending_id_ : -1 );
+    device->tracking_pending_id_ = -1;
+    
+    // ... for debug proposes only ...
+    ev::Logger::GetInstance().Log("redis_trace_extended", device->loggable_data_,
+                                  "[%-30s] : a_context = %p, a_reply = %p, device = %p, tracking_id_ = %lld",
+                                  __FUNCTION__,
+                                  a_context,
+                                  a_reply,
+                                  device,
+                                  device->tracking_id_
+    );
+}
+
 /**
  * @brief This method is called by HIREDIS deliver a command reply.
  *
@@ -618,31 +931,40 @@ void ev::redis::Device::HiredisDisconnectCallback (const struct redisAsyncContex
  * @param a_reply
  * @param a_priv_data
  */
-void ev::redis::Device::HiredisDataCallback (struct redisAsyncContext* a_context, void* a_reply, void* /* a_priv_data */)
+void ev::redis::Device::HiredisDataCallback (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data)
 {
-    if ( nullptr == a_context ) {
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+    // ... reply tree is ours, it's released when the last handle referencing it goes away ...
+    const ev::redis::ReplyHandle handle = ev::redis::ReplyHandle::Adopt(static_cast<struct redisReply*>(a_reply));
+#endif
+    
+    if ( nullptr == a_context || nullptr == a_context->data ) {
+        // ... no context or device already released ...
         return;
     }
 
     ev::redis::Device* device = static_cast<ev::redis::Device*>(a_context->data);
 
-    const ev::Loggable::Data loggable_data = ( nullptr != device->request_ptr_ ? device->request_ptr_->loggable_data_ : device->loggable_data_ );
+    // ... reply to the oldest request sent? ( subscription messages are delivered with the subscribe request private data ) ...
+    const bool in_flight = ( false == device->in_flight_.empty() && a_priv_data == device->in_flight_.front().request_ );
+    
+    const ev::Loggable::Data loggable_data = ( true == in_flight ? device->in_flight_.front().request_->loggable_data_ : nullptr != device->request_ptr_ ? device->request_ptr_->loggable_data_ : device->loggable_data_ );
     
     try {
 
         // ... for debug proposes only ...
         ev::Logger::GetInstance().Log("redis_trace_extended", loggable_data,
-                                      "[%-30s] : a_context = %p, a_reply = %p, device = %p, execute_callback_ = %s, handler_ptr_= %p",
+                                      "[%-30s] : a_context = %p, a_reply = %p, device = %p, in_flight_ = %zu, handler_ptr_= %p",
                                       __FUNCTION__,
                                       a_context,
                                       a_reply,
                                       device,
-                                      nullptr != device->execute_callback_ ? "<set>" : "<not set>",
+                                      device->in_flight_.size(),
                                       device->handler_ptr_
         );
 
         // ... if no one is waiting for a reply ...
-        if ( nullptr == device->execute_callback_ && nullptr == device->handler_ptr_ ) {
+        if ( false == in_flight && ( nullptr == device->handler_ptr_ || nullptr == device->request_ptr_ ) ) {
             // ... we're done ...
             return;
         }
@@ -665,12 +987,35 @@ void ev::redis::Device::HiredisDataCallback (struct redisAsyncContext* a_context
         ev::Result*                   result       = nullptr;
         ev::redis::Reply*             reply_object = nullptr;
         const struct redisReply*      reply        = static_cast<const struct redisReply*>(a_reply);
+        const ev::redis::Request*     request      = ( true == in_flight ? device->in_flight_.front().request_ : device->request_ptr_ );
+        
+        // ... cluster: slot served by another node?
+        if ( true == in_flight && true == device->cluster_ && true == device->Forward(device->in_flight_.front(), reply, 0) ) {
+            // ... reply will be delivered by \link HiredisRedirectCallback \link ...
+            device->in_flight_.pop_front();
+            if ( device->request_ptr_ == request && 0 == device->in_flight_.size() ) {
+                device->request_ptr_ = nullptr;
+            }
+            return;
+        }
+        
+        // ... script not known by server ( e.g. restarted or flushed )?
+        if ( true == in_flight && true == device->Reload(device->in_flight_.front(), reply) ) {
+            // ... reply will be delivered when the retried request reply is received ...
+            device->in_flight_.pop_front();
+            return;
+        }
+        
         if ( nullptr != reply ) {
             result = new ev::Result(ev::Object::Target::Redis);
-            if ( ev::redis::Request::Kind::Subscription == device->request_ptr_->kind() ) {
-                reply_object = new ev::redis::subscriptions::Reply(device->request_ptr_->loggable_data_, reply);
+            if ( ev::redis::Request::Kind::Subscription == request->kind() ) {
+                reply_object = new ev::redis::subscriptions::Reply(request->loggable_data_, reply);
             } else {
-                reply_object = new ev::redis::Reply(reply);
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+                reply_object = new ev::redis::Reply(handle);
+#else
+                reply_object = new ev::redis::Reply(ev::redis::ReplyHandle::Copy(reply));
+#endif
             }
             result->AttachDataObject(reply_object);
         } else {
@@ -679,22 +1024,32 @@ void ev::redis::Device::HiredisDataCallback (struct redisAsyncContext* a_context
         
         // ... for debug proposes only ...
         ev::Logger::GetInstance().Log("redis_trace_extended", loggable_data,
-                                      "[%-30s] : a_context = %p, a_reply = %p, device = %p, result = %p, execute_callback_ = %s, last_error_msg_ = %s",
+                                      "[%-30s] : a_context = %p, a_reply = %p, device = %p, result = %p, in_flight = %s, last_error_msg_ = %s",
                                       __FUNCTION__,
                                       a_context,
                                       a_reply,
                                       device,
                                       result,
-                                      nullptr != device->execute_callback_ ? "<set>" : "<not set>",
+                                      true == in_flight ? "true" : "false",
                                       device->last_error_msg_.c_str()
         );
         
+        // ... cache reply, only if invalidations for it will be received ...
+        if ( true == in_flight && nullptr != reply_object && true == request->Cacheable()
+            &&
+            -1 != device->tracking_id_ && ::ev::redis::TrackingCache::GetInstance().RedirectID() == device->tracking_id_ ) {
+            (void) ::ev::redis::TrackingCache::GetInstance().Set(request, reply_object->handle(), device->in_flight_.front().generation_);
+        }
+        
         // ... notify caller ...
         bool ownership_transfered = false;
         // ...
-        if ( nullptr != device->execute_callback_ ) {            
-            auto       callback            = device->execute_callback_;
-            device->execute_callback_      = nullptr;
+        if ( true == in_flight ) {
+            auto callback = device->in_flight_.front().callback_;
+            device->in_flight_.pop_front();
+            if ( device->request_ptr_ == request && 0 == device->in_flight_.size() && ev::redis::Request::Kind::Subscription != request->kind() ) {
+                device->request_ptr_ = nullptr;
+            }
             callback(device->last_error_msg_.length() > 0 ? ev::Device::ExecutionStatus::Error : ev::Device::ExecutionStatus::Ok, result);
             ownership_transfered = true;
         } else if ( nullptr != result && nullptr != device->handler_ptr_ ) {
@@ -792,3 +1147,112 @@ void ev::redis::Device::HiredisDataCallback (struct redisAsyncContext* a_context
         device->exception_callback_(ev::Exception(device->last_error_msg_));
     }
 }
+
+/**
+ * @brief This method is called by HIREDIS to deliver a redirected command reply.
+ *
+ * @param a_context
+ * @param a_reply
+ * @param a_priv_data
+ */
+void ev::redis::Device::HiredisRedirectCallback (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data)
+{
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+    // ... reply tree is ours ...
+    const ev::redis::ReplyHandle handle = ev::redis::ReplyHandle::Adopt(static_cast<struct redisReply*>(a_reply));
+#endif
+    
+    ev::redis::Device::Redirect* redirect = static_cast<ev::redis::Device::Redirect*>(a_priv_data);
+    
+    if ( nullptr == a_context || nullptr == a_context->data ) {
+        // ... no context or device already released ...
+        delete redirect;
+        return;
+    }
+    
+    ev::redis::Device*       device = static_cast<ev::redis::Device*>(a_context->data);
+    const struct redisReply* reply  = static_cast<const struct redisReply*>(a_reply);
+    
+    try {
+        
+        // ... redirected again?
+        if ( true == device->Forward(redirect->in_flight_, reply, redirect->hops_) ) {
+            delete redirect;
+            return;
+        }
+        
+        ev::Result* result = nullptr;
+        if ( nullptr != reply ) {
+            device->last_error_msg_ = "";
+            result = new ev::Result(ev::Object::Target::Redis);
+#ifdef REDIS_NO_AUTO_FREE_REPLIES
+            result->AttachDataObject(new ev::redis::Reply(handle));
+#else
+            result->AttachDataObject(new ev::redis::Reply(ev::redis::ReplyHandle::Copy(reply)));
+#endif
+        } else {
+            device->last_error_msg_ = ( nullptr != a_context->errstr ? a_context->errstr : "REDIS Reply: 'nullptr'!" );
+        }
+        
+        const auto callback = redirect->in_flight_.callback_;
+        delete redirect;
+        redirect = nullptr;
+        
+        // ... notify caller, result ownership is transferred ...
+        callback(device->last_error_msg_.length() > 0 ? ev::Device::ExecutionStatus::Error : ev::Device::ExecutionStatus::Ok, result);
+        
+    } catch (const ev::Exception& a_ev_exception) {
+        OSALITE_BACKTRACE();
+        delete redirect;
+        device->last_error_msg_ = a_ev_exception.what();
+        device->exception_callback_(a_ev_exception);
+    } catch (const std::exception& a_std_exception) {
+        OSALITE_BACKTRACE();
+        delete redirect;
+        device->last_error_msg_ = a_std_exception.what();
+        device->exception_callback_(ev::Exception("C++ Standard Exception: %s\n", a_std_exception.what()));
+    } catch (...) {
+        OSALITE_BACKTRACE();
+        delete redirect;
+        device->last_error_msg_ = STD_CPP_GENERIC_EXCEPTION_TRACE();
+        device->exception_callback_(ev::Exception(device->last_error_msg_));
+    }
+}
+
+/**
+ * @brief This method is called by HIREDIS to notify a 'connect' event of a connection used to follow redirects.
+ *
+ * @param a_context
+ * @param a_status
+ */
+void ev::redis::Device::HiredisRedirectConnectCallback (const struct redisAsyncContext* a_context, int a_status)
+{
+    if ( nullptr == a_context || nullptr == a_context->data || REDIS_OK == a_status ) {
+        return;
+    }
+    // ... HIREDIS releases context, pending commands are replied with 'nullptr' ...
+    HiredisRedirectDisconnectCallback(a_context, a_status);
+}
+
+/**
+ * @brief This method is called by HIREDIS to notify a 'disconnect' event of a connection used to follow redirects.
+ *
+ * @param a_context
+ * @param a_status
+ */
+void ev::redis::Device::HiredisRedirectDisconnectCallback (const struct redisAsyncContext* a_context, int /* a_status */)
+{
+    if ( nullptr == a_context || nullptr == a_context->data ) {
+        return;
+    }
+    
+    ev::redis::Device* device = static_cast<ev::redis::Device*>(a_context->data);
+    
+    // ... forget context ...
+    for ( auto it = device->redirects_.begin() ; device->redirects_.end() != it ; ++it ) {
+        if ( a_context == it->second ) {
+            device->redirects_.erase(it);
+            break;
+        }
+    }
+}
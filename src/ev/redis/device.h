@@ -26,6 +26,8 @@
 
 #include <string>     // std::string
 #include <functional> // std::function
+#include <deque>      // std::deque
+#include <map>        // std::map
 
 #include <stdlib.h>
 
@@ -43,23 +45,53 @@ namespace ev
         class Device final : public ev::Device
         {
             
+        private: // Data Type(s)
+            
+            typedef struct {
+                const Request*  request_;    //!< Request sent, also passed to HIREDIS as reply private data.
+                ExecuteCallback callback_;   //!< Function to call when it's reply is received.
+                uint64_t        generation_; //!< \link TrackingCache \link generation when request was sent.
+                bool            reloaded_;   //!< True when request was re-sent after loading it's script.
+            } InFlight;
+            
+            typedef struct {
+                InFlight        in_flight_;  //!< Request being redirected.
+                size_t          hops_;       //!< Number of redirects followed so far.
+            } Redirect;
+            
+            typedef std::map<std::string, redisAsyncContext*> RedirectsMap;
+            
+        public: // Static Const Data
+            
+            static const size_t  k_max_redirects_;
+            
         protected: // Const Data
             
-            const std::string  ip_address_;        //!< REDIS server IP address.
-            const int          port_number_;       //!< REDIS server port number address.
-            const int          database_index_;    //!< REDIS database.
+            const std::string    ip_address_;          //!< REDIS server IP address.
+            const int            port_number_;         //!< REDIS server port number address.
+            const int            database_index_;      //!< REDIS database.
+            const size_t         pipeline_depth_;      //!< Maximum number of requests sent and waiting for a reply.
             
         private: // Data
             
-            const Request*     request_ptr_;       //!< Pointer to the current request.
-            redisAsyncContext* hiredis_context_;   //!< HIREDIS context.
-            Request*           database_request_;  //!<
-            bool               database_selected_; //!<
+            const Request*       request_ptr_;         //!< Pointer to the last sent request.
+            std::deque<InFlight> in_flight_;           //!< Requests waiting for a reply, in the order they were sent.
+            redisAsyncContext*   hiredis_context_;     //!< HIREDIS context.
+            Request*             database_request_;    //!<
+            bool                 database_selected_;   //!<
+            Request*             ping_request_;        //!< Health check request, nullptr if none.
+            long long            tracking_id_;         //!< Client id invalidations are redirected to, -1 if tracking is not enabled.
+            long long            tracking_pending_id_; //!< Client id of a 'CLIENT TRACKING' command waiting for a reply, -1 if none.
+            bool                 cluster_;             //!< True when connected to a REDIS Cluster node, no database is selected.
+            RedirectsMap         redirects_;           //!< Connections to other cluster nodes, by endpoint, only used to follow redirects.
+            bool                 sentinel_;            //!< True when master and replicas are discovered through \link Sentinel \link.
+            bool                 replica_;             //!< True when connected to a replica, see \link Sentinel::Route \link.
             
         public: // Constructor(s) / Destructor
             
             Device (const Loggable::Data& a_loggable_data,
-                    const char* const a_ip_address, const int a_port_number, const int a_database_index = -1);
+                    const char* const a_ip_address, const int a_port_number, const int a_database_index = -1,
+                    const size_t a_pipeline_depth = 1, const bool a_replica = false);
             virtual ~Device ();
                     
         public: // Inherited Pure Virtual Method(s) / Function(s)
@@ -69,15 +101,28 @@ namespace ev
             virtual Status Execute         (ExecuteCallback a_callback, const ev::Request* a_request);
             virtual Error* DetachLastError ();
 
+        public: // Inherited Virtual Method(s) / Function(s)
+            
+            virtual Status   Ping          (ExecuteCallback a_callback);
+            virtual size_t   PipelineDepth () const;
+            virtual Affinity AffinityFor   (const ev::Request* a_request) const;
+
         private:
             
             void DatabaseIndexSelectionCallback (const ExecutionStatus& a_status,  ev::Result* a_result);
+            bool Forward                        (const InFlight& a_in_flight, const struct redisReply* a_reply, const size_t a_hops);
+            bool Stale                          () const;
+            bool Reload                         (const InFlight& a_in_flight, const struct redisReply* a_reply);
 
         private: // Static Callbacks
             
-            static void HiredisConnectCallback    (const struct redisAsyncContext* a_context, int a_status);
-            static void HiredisDisconnectCallback (const struct redisAsyncContext* a_context, int a_status);
-            static void HiredisDataCallback       (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data);
+            static void HiredisConnectCallback            (const struct redisAsyncContext* a_context, int a_status);
+            static void HiredisDisconnectCallback         (const struct redisAsyncContext* a_context, int a_status);
+            static void HiredisDataCallback               (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data);
+            static void HiredisTrackingCallback           (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data);
+            static void HiredisRedirectCallback           (struct redisAsyncContext* a_context, void* a_reply, void* a_priv_data);
+            static void HiredisRedirectConnectCallback    (const struct redisAsyncContext* a_context, int a_status);
+            static void HiredisRedirectDisconnectCallback (const struct redisAsyncContext* a_context, int a_status);
 
         }; // end of class 'Device'
         
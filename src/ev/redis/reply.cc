@@ -32,11 +32,24 @@
  * @brief Default constructor.
  */
 ev::redis::Reply::Reply (const struct redisReply* a_reply)
-    : ev::redis::Object(ev::redis::Object::Type::Reply)
+    : ev::redis::Object(ev::redis::Object::Type::Reply),
+      translated_(true)
 {
     value_ = a_reply;
 }
 
+/**
+ * @brief Handle constructor, value is only translated if requested.
+ *
+ * @param a_handle Reply tree, shared with caller.
+ */
+ev::redis::Reply::Reply (const ev::redis::ReplyHandle& a_handle)
+    : ev::redis::Object(ev::redis::Object::Type::Reply),
+      handle_(a_handle), translated_(false)
+{
+    /* empty */
+}
+
 /**
  * @brief Destructor.
  */
@@ -57,6 +70,18 @@ ev::redis::Reply::~Reply ()
  * @return The command reply value object.
  */
 const ev::redis::Value& ev::redis::Reply::GetCommandReplyValue (const ::ev::Object* a_object)
+{
+    return GetCommandReply(a_object)->value();
+}
+
+/**
+ * @brief Insure object is a result object and its data object is a reply object.
+ *
+ * @param a_object
+ *
+ * @return The command reply object.
+ */
+const ev::redis::Reply* ev::redis::Reply::GetCommandReply (const ::ev::Object* a_object)
 {
     const ::ev::Result* result = dynamic_cast<const ::ev::Result*>(a_object);
     if ( nullptr == result ) {
@@ -82,7 +107,7 @@ const ev::redis::Value& ev::redis::Reply::GetCommandReplyValue (const ::ev::Obje
         );
     }
     
-    return reply->value();
+    return reply;
 }
 
 /**
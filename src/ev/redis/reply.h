@@ -27,6 +27,7 @@
 
 #include "ev/redis/object.h"
 #include "ev/redis/value.h"
+#include "ev/redis/reply_handle.h"
 
 namespace ev
 {
@@ -39,20 +40,28 @@ namespace ev
             
         protected:
             
-            Value value_; //!< Translate value from a \link redisReply \link.
+            mutable Value value_;      //!< Translate value from a \link redisReply \link.
+            
+        private:
+            
+            ReplyHandle   handle_;     //!< Reply tree, when set \link value_ \link is only translated on demand.
+            mutable bool  translated_; //!< True when \link value_ \link is up to date.
             
         public: // Constructor(s) / Destructor
             
             Reply(const struct redisReply* a_reply);
+            Reply(const ReplyHandle& a_handle);
             virtual ~Reply();
             
         public: // Method(s) / Function(s)
 
-            const Value& value () const;
+            const Value&       value  () const;
+            const ReplyHandle& handle () const;
             
         public: // Static Method(s) / Function(s)
             
             static const ::ev::redis::Value& GetCommandReplyValue        (const ::ev::Object* a_object);
+            static const Reply*              GetCommandReply             (const ::ev::Object* a_object);
             
             static void                      EnsureIsStatusReply  (const ::ev::Object* a_object, const char* const a_value);
             
@@ -73,10 +82,25 @@ namespace ev
                                                                      const std::function<bool(const long long a_lhs, const long long a_rhs)> a_comparator);
         };
 
+        /**
+         * @return The translated value, translated on first call when built from a \link ReplyHandle \link.
+         */
         inline const Value& Reply::value () const
         {
+            if ( false == translated_ ) {
+                value_      = handle_.reply();
+                translated_ = true;
+            }
             return value_;
         }
+        
+        /**
+         * @return The reply tree, only valid when built from a \link ReplyHandle \link.
+         */
+        inline const ReplyHandle& Reply::handle () const
+        {
+            return handle_;
+        }
 
     }
     
@@ -0,0 +1,203 @@
+/**
+ * @file reply_handle.cc - REDIS Reply Handle
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/reply_handle.h"
+
+#include <stdlib.h> // malloc, calloc, free
+#include <new>      // std::bad_alloc
+
+/**
+ * @brief Default constructor.
+ */
+ev::redis::ReplyHandle::ReplyHandle ()
+    : node_(nullptr)
+{
+    /* empty */
+}
+
+/**
+ * @brief Copy constructor, both handles share the same tree.
+ *
+ * @param a_handle
+ */
+ev::redis::ReplyHandle::ReplyHandle (const ev::redis::ReplyHandle& a_handle)
+    : root_(a_handle.root_), node_(a_handle.node_)
+{
+    /* empty */
+}
+
+/**
+ * @brief Element constructor.
+ *
+ * @param a_root
+ * @param a_node
+ */
+ev::redis::ReplyHandle::ReplyHandle (const std::shared_ptr<const struct redisReply>& a_root, const struct redisReply* a_node)
+    : root_(a_root), node_(a_node)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+ev::redis::ReplyHandle::~ReplyHandle ()
+{
+    // ... tree is released by last handle referencing it ...
+}
+
+/**
+ * @brief Operator '=' overload, both handles share the same tree.
+ *
+ * @param a_handle
+ */
+ev::redis::ReplyHandle& ev::redis::ReplyHandle::operator= (const ev::redis::ReplyHandle& a_handle)
+{
+    root_ = a_handle.root_;
+    node_ = a_handle.node_;
+    return *this;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief This method can be called to iterate an array as an hash.
+ *
+ * @param a_callback
+ */
+void ev::redis::ReplyHandle::IterateHash (const std::function<void(const ev::redis::ReplyHandle& a_key, const ev::redis::ReplyHandle& a_value)>& a_callback) const
+{
+    const size_t size = Size();
+    if ( 0 != ( size % 2 ) ) {
+        throw ev::Exception("Data object is not an hash!");
+    }
+    for ( size_t idx = 0 ; idx < size ; idx += 2 ) {
+        a_callback(ReplyHandle(root_, node_->element[idx]), ReplyHandle(root_, node_->element[idx + 1]));
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Take ownership of a \link redisReply \link tree allocated by hiredis.
+ *
+ * @param a_reply Tree to adopt, it will be released with \link freeReplyObject \link.
+ */
+ev::redis::ReplyHandle ev::redis::ReplyHandle::Adopt (struct redisReply* a_reply)
+{
+    if ( nullptr == a_reply ) {
+        return ev::redis::ReplyHandle();
+    }
+    const std::shared_ptr<const struct redisReply> root(a_reply, [] (const struct redisReply* a_root) {
+        freeReplyObject(const_cast<struct redisReply*>(a_root));
+    });
+    return ev::redis::ReplyHandle(root, a_reply);
+}
+
+/**
+ * @brief Copy a \link redisReply \link tree that is still owned by hiredis.
+ *
+ * @param a_reply Tree to copy.
+ */
+ev::redis::ReplyHandle ev::redis::ReplyHandle::Copy (const struct redisReply* a_reply)
+{
+    if ( nullptr == a_reply ) {
+        return ev::redis::ReplyHandle();
+    }
+    struct redisReply* clone = Clone(a_reply);
+    const std::shared_ptr<const struct redisReply> root(clone, ev::redis::ReplyHandle::Release);
+    return ev::redis::ReplyHandle(root, clone);
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Deep copy a \link redisReply \link tree.
+ *
+ * @param a_reply
+ *
+ * @return The new tree, to be released with \link Release \link.
+ */
+struct redisReply* ev::redis::ReplyHandle::Clone (const struct redisReply* a_reply)
+{
+    struct redisReply* clone = static_cast<struct redisReply*>(calloc(1, sizeof(struct redisReply)));
+    if ( nullptr == clone ) {
+        throw std::bad_alloc();
+    }
+    clone->type    = a_reply->type;
+    clone->integer = a_reply->integer;
+    try {
+        if ( nullptr != a_reply->str ) {
+            clone->str = static_cast<char*>(malloc(a_reply->len + 1));
+            if ( nullptr == clone->str ) {
+                throw std::bad_alloc();
+            }
+            memcpy(clone->str, a_reply->str, a_reply->len);
+            clone->str[a_reply->len] = '\0';
+            clone->len = a_reply->len;
+        }
+        if ( a_reply->elements > 0 ) {
+            clone->element = static_cast<struct redisReply**>(calloc(a_reply->elements, sizeof(struct redisReply*)));
+            if ( nullptr == clone->element ) {
+                throw std::bad_alloc();
+            }
+            clone->elements = a_reply->elements;
+            for ( size_t idx = 0 ; idx < a_reply->elements ; ++idx ) {
+                if ( nullptr != a_reply->element[idx] ) {
+                    clone->element[idx] = Clone(a_reply->element[idx]);
+                }
+            }
+        }
+    } catch (const std::bad_alloc& a_bad_alloc) {
+        Release(clone);
+        throw a_bad_alloc;
+    }
+    return clone;
+}
+
+/**
+ * @brief Release a tree created by \link Clone \link.
+ *
+ * @param a_reply
+ */
+void ev::redis::ReplyHandle::Release (const struct redisReply* a_reply)
+{
+    if ( nullptr == a_reply ) {
+        return;
+    }
+    struct redisReply* reply = const_cast<struct redisReply*>(a_reply);
+    if ( nullptr != reply->element ) {
+        for ( size_t idx = 0 ; idx < reply->elements ; ++idx ) {
+            Release(reply->element[idx]);
+        }
+        free(reply->element);
+    }
+    if ( nullptr != reply->str ) {
+        free(reply->str);
+    }
+    free(reply);
+}
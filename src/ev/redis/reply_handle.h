@@ -0,0 +1,339 @@
+/**
+ * @file reply_handle.h - REDIS Reply Handle
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_REPLY_HANDLE_H_
+#define NRS_EV_REDIS_REPLY_HANDLE_H_
+
+#include <sys/types.h> // size_t
+#include <string.h>    // strlen, memcmp
+#include <string>      // std::string
+#include <memory>      // std::shared_ptr
+#include <functional>  // std::function
+
+#include "ev/exception.h"
+
+#include "ev/redis/includes.h"
+#include "ev/redis/value.h"
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        /**
+         * @brief A read-only view over a \link redisReply \link tree, it keeps the whole tree alive while referenced.
+         *
+         *        Strings are exposed as pointer + length, no data is copied unless explicitly requested.
+         */
+        class ReplyHandle final
+        {
+            
+        public: // Data Type(s)
+            
+            /**
+             * @brief Forward iterator over 'array' elements.
+             */
+            class Iterator
+            {
+                
+            private: // Data
+                
+                const ReplyHandle* owner_;
+                size_t             index_;
+                
+            public: // Constructor(s) / Destructor
+                
+                Iterator (const ReplyHandle* a_owner, const size_t a_index);
+                
+            public: // Overloaded Operator(s)
+                
+                ReplyHandle operator*  () const;
+                Iterator&   operator++ ();
+                bool        operator!= (const Iterator& a_iterator) const;
+                
+            };
+            
+        private: // Data
+            
+            std::shared_ptr<const struct redisReply> root_; //!< Reply tree owner.
+            const struct redisReply*                 node_; //!< Node of the tree this handle is looking at, nullptr if none.
+            
+        public: // Constructor(s) / Destructor
+            
+            ReplyHandle ();
+            ReplyHandle (const ReplyHandle& a_handle);
+            virtual ~ReplyHandle ();
+            
+        private: // Constructor(s) / Destructor
+            
+            ReplyHandle (const std::shared_ptr<const struct redisReply>& a_root, const struct redisReply* a_node);
+            
+        public: // Overloaded Operator(s)
+            
+            ReplyHandle& operator=  (const ReplyHandle& a_handle);
+            ReplyHandle  operator[] (const size_t a_index) const;
+            
+        public: // Inline Method(s) / Function(s)
+            
+            const bool               Valid        () const;
+            const struct redisReply* reply        () const;
+            
+            Value::ContentType       content_type () const;
+            
+            const bool               IsNil        () const;
+            const bool               IsString     () const;
+            const bool               IsInteger    () const;
+            const bool               IsArray      () const;
+            const bool               IsError      () const;
+            const bool               IsStatus     () const;
+            
+            const char*              Data         () const;
+            const size_t             Length       () const;
+            const long long          Integer      () const;
+            const size_t             Size         () const;
+            
+            bool                     Equals       (const char* const a_value) const;
+            std::string              String       () const;
+            
+            Iterator                 begin        () const;
+            Iterator                 end          () const;
+            
+        public: // Method(s) / Function(s)
+            
+            void                     IterateHash  (const std::function<void(const ReplyHandle& a_key, const ReplyHandle& a_value)>& a_callback) const;
+            
+        public: // Static Method(s) / Function(s)
+            
+            static ReplyHandle Adopt (struct redisReply* a_reply);
+            static ReplyHandle Copy  (const struct redisReply* a_reply);
+            
+        private: // Static Method(s) / Function(s)
+            
+            static struct redisReply* Clone   (const struct redisReply* a_reply);
+            static void               Release (const struct redisReply* a_reply);
+            
+        }; // end of class 'ReplyHandle'
+        
+        /**
+         * @brief Default constructor.
+         *
+         * @param a_owner
+         * @param a_index
+         */
+        inline ReplyHandle::Iterator::Iterator (const ReplyHandle* a_owner, const size_t a_index)
+            : owner_(a_owner), index_(a_index)
+        {
+            /* empty */
+        }
+        
+        /**
+         * @return A handle for the current element.
+         */
+        inline ReplyHandle ReplyHandle::Iterator::operator* () const
+        {
+            return (*owner_)[index_];
+        }
+        
+        /**
+         * @brief Move to next element.
+         */
+        inline ReplyHandle::Iterator& ReplyHandle::Iterator::operator++ ()
+        {
+            ++index_;
+            return *this;
+        }
+        
+        /**
+         * @brief Operator '!=' overload.
+         *
+         * @param a_iterator
+         */
+        inline bool ReplyHandle::Iterator::operator!= (const ReplyHandle::Iterator& a_iterator) const
+        {
+            return ( owner_ != a_iterator.owner_ || index_ != a_iterator.index_ );
+        }
+        
+        /**
+         * @brief Operator '[]' overload.
+         *
+         * @param a_index
+         *
+         * @return A handle for the element at the provided index, sharing this handle tree.
+         */
+        inline ReplyHandle ReplyHandle::operator[] (const size_t a_index) const
+        {
+            if ( false == IsArray() ) {
+                throw ev::Exception("Data object is not an array!");
+            }
+            if ( a_index >= node_->elements ) {
+                throw ev::Exception("Index out of bounds!");
+            }
+            return ReplyHandle(root_, node_->element[a_index]);
+        }
+        
+        /**
+         * @return True when this handle is looking at a reply.
+         */
+        inline const bool ReplyHandle::Valid () const
+        {
+            return ( nullptr != node_ );
+        }
+        
+        /**
+         * @return The \link redisReply \link this handle is looking at, nullptr if none.
+         */
+        inline const struct redisReply* ReplyHandle::reply () const
+        {
+            return node_;
+        }
+        
+        /**
+         * @return The reply content type, one of \link Value::ContentType \link.
+         */
+        inline Value::ContentType ReplyHandle::content_type () const
+        {
+            return ( nullptr != node_ ? static_cast<Value::ContentType>(node_->type) : Value::ContentType::Nil );
+        }
+        
+        /**
+         * @return True when the object is 'nil'.
+         */
+        inline const bool ReplyHandle::IsNil () const
+        {
+            return ( Value::ContentType::Nil == content_type() );
+        }
+        
+        /**
+         * @return True when the object is a 'string'.
+         */
+        inline const bool ReplyHandle::IsString () const
+        {
+            return ( Value::ContentType::String == content_type() );
+        }
+        
+        /**
+         * @return True when the object is an 'integer'.
+         */
+        inline const bool ReplyHandle::IsInteger () const
+        {
+            return ( Value::ContentType::Integer == content_type() );
+        }
+        
+        /**
+         * @return True when the object is an 'array'.
+         */
+        inline const bool ReplyHandle::IsArray () const
+        {
+            return ( Value::ContentType::Array == content_type() );
+        }
+        
+        /**
+         * @return True when the object is an 'error'.
+         */
+        inline const bool ReplyHandle::IsError () const
+        {
+            return ( Value::ContentType::Error == content_type() );
+        }
+        
+        /**
+         * @return True when the object is a 'status'.
+         */
+        inline const bool ReplyHandle::IsStatus () const
+        {
+            return ( Value::ContentType::Status == content_type() );
+        }
+        
+        /**
+         * @return 'string', 'status' or 'error' data, not NULL terminated - see \link Length \link.
+         */
+        inline const char* ReplyHandle::Data () const
+        {
+            return ( nullptr != node_ && nullptr != node_->str ? node_->str : "" );
+        }
+        
+        /**
+         * @return 'string', 'status' or 'error' data length.
+         */
+        inline const size_t ReplyHandle::Length () const
+        {
+            return ( nullptr != node_ && nullptr != node_->str ? node_->len : 0 );
+        }
+        
+        /**
+         * @return Integer value.
+         */
+        inline const long long ReplyHandle::Integer () const
+        {
+            return ( nullptr != node_ ? node_->integer : 0 );
+        }
+        
+        /**
+         * @return The 'array' object size.
+         */
+        inline const size_t ReplyHandle::Size () const
+        {
+            if ( false == IsArray() ) {
+                throw ev::Exception("Data object is not an array!");
+            }
+            return node_->elements;
+        }
+        
+        /**
+         * @brief Compare data with a NULL terminated string, without copying it.
+         *
+         * @param a_value
+         */
+        inline bool ReplyHandle::Equals (const char* const a_value) const
+        {
+            const size_t length = strlen(a_value);
+            return ( length == Length() && 0 == memcmp(Data(), a_value, length) );
+        }
+        
+        /**
+         * @return A copy of 'string', 'status' or 'error' data.
+         */
+        inline std::string ReplyHandle::String () const
+        {
+            return std::string(Data(), Length());
+        }
+        
+        /**
+         * @return An iterator to the first 'array' element.
+         */
+        inline ReplyHandle::Iterator ReplyHandle::begin () const
+        {
+            return Iterator(this, 0);
+        }
+        
+        /**
+         * @return An iterator past the last 'array' element.
+         */
+        inline ReplyHandle::Iterator ReplyHandle::end () const
+        {
+            return Iterator(this, true == IsArray() ? node_->elements : 0);
+        }
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_REPLY_HANDLE_H_
@@ -21,6 +21,9 @@
 
 #include "ev/redis/request.h"
 
+#include "ev/redis/tracking_cache.h"
+#include "ev/redis/cluster.h"
+
 /**
  * @brief Default constructor.
  *
@@ -30,7 +33,21 @@
  */
 ev::redis::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const char* const a_command, const std::vector<std::string>& a_args)
     : ev::Request(a_loggable_data, ev::Object::Target::Redis, ev::Request::Mode::OneShot),
-      kind_(ev::redis::Request::Kind::Other)
+      kind_(ev::redis::Request::Kind::Other), cacheable_(false), slot_(-1), read_only_(false), script_(nullptr)
+{
+    SetPayload(a_command, a_args);
+}
+
+/**
+ * @brief Constructor, arguments are encoded without intermediate copies.
+ *
+ * @param a_loggable_data
+ * @param a_command
+ * @param a_args
+ */
+ev::redis::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const char* const a_command, std::initializer_list<ev::redis::Request::Argument> a_args)
+    : ev::Request(a_loggable_data, ev::Object::Target::Redis, ev::Request::Mode::OneShot),
+      kind_(ev::redis::Request::Kind::Other), cacheable_(false), slot_(-1), read_only_(false), script_(nullptr)
 {
     SetPayload(a_command, a_args);
 }
@@ -44,11 +61,38 @@ ev::redis::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const
  */
 ev::redis::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const ev::Request::Mode a_mode, const ev::redis::Request::Kind a_kind)
     : ev::Request(a_loggable_data, ev::Object::Target::Redis, a_mode),
-      kind_(a_kind)
+      kind_(a_kind), cacheable_(false), slot_(-1), read_only_(false), script_(nullptr)
 {
     /* empty */
 }
 
+/**
+ * @brief Constructor, for an 'EVALSHA' request.
+ *
+ * @param a_loggable_data
+ * @param a_script        Registered script, see \link ev::redis::Script::Register \link.
+ * @param a_keys          Keys, available to the script as KEYS.
+ * @param a_args          Additional arguments, available to the script as ARGV.
+ */
+ev::redis::Request::Request (const ::ev::Loggable::Data& a_loggable_data, const ev::redis::Script& a_script,
+                             std::initializer_list<ev::redis::Request::Argument> a_keys, std::initializer_list<ev::redis::Request::Argument> a_args)
+    : ev::Request(a_loggable_data, ev::Object::Target::Redis, ev::Request::Mode::OneShot),
+      kind_(ev::redis::Request::Kind::Other), cacheable_(false), slot_(-1), read_only_(false), script_(&a_script)
+{
+    // ... EVALSHA <sha1> <numkeys> [ key ... ] [ arg ... ] ...
+    std::vector<ev::redis::Request::Argument> arguments;
+    arguments.reserve(2 + a_keys.size() + a_args.size());
+    arguments.push_back(ev::redis::Request::Argument(a_script.sha1()));
+    arguments.push_back(ev::redis::Request::Argument(static_cast<unsigned long>(a_keys.size())));
+    for ( const ev::redis::Request::Argument& key : a_keys ) {
+        arguments.push_back(key);
+    }
+    for ( const ev::redis::Request::Argument& arg : a_args ) {
+        arguments.push_back(arg);
+    }
+    Encode(ev::redis::Request::Argument("EVALSHA"), arguments);
+}
+
 /**
  * @brief Destructor
  */
@@ -76,3 +120,78 @@ const std::string& ev::redis::Request::AsString () const
 {
     return payload_;
 }
+
+/**
+ * @return A result sharing a cached reply or nullptr if this request is not cacheable or not cached.
+ */
+ev::Result* ev::redis::Request::CachedResult () const
+{
+    if ( false == cacheable_ ) {
+        return nullptr;
+    }
+    return ::ev::redis::TrackingCache::GetInstance().Get(this);
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Opt-in to \link TrackingCache \link, only 'GET', 'HGET' and 'HGETALL' commands can be cached.
+ */
+void ev::redis::Request::SetCacheable ()
+{
+    if ( 0 == tracked_key_.length() ) {
+        throw ev::Exception("Only 'GET', 'HGET' and 'HGETALL' requests can be cached!");
+    }
+    cacheable_ = true;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Find which argument is a command first key.
+ *
+ * @param a_command
+ *
+ * @return Index of the first key in the arguments list, -1 if command has no key.
+ *
+ * @remarks For 'EVAL' and 'EVALSHA' it's the first key only if 'numkeys' is not 0.
+ */
+int ev::redis::Request::KeyIndex (const ev::redis::Request::Argument& a_command)
+{
+    static const char* const k_keyless_commands[] = {
+        "PING", "ECHO", "SELECT", "AUTH", "CLIENT", "CLUSTER", "INFO", "CONFIG", "TIME", "DBSIZE",
+        "SUBSCRIBE", "UNSUBSCRIBE", "PSUBSCRIBE", "PUNSUBSCRIBE", "PUBLISH",
+        "MULTI", "EXEC", "DISCARD", "SCRIPT", "KEYS", "SCAN", "FLUSHDB", "FLUSHALL",
+        "ASKING", "READONLY", "READWRITE", "WAIT", "QUIT"
+    };
+    if ( ( 4 == a_command.length_ && 0 == strncasecmp(a_command.data_, "EVAL", 4) )
+        ||
+        ( 7 == a_command.length_ && 0 == strncasecmp(a_command.data_, "EVALSHA", 7) )
+    ) {
+        return 2;
+    }
+    for ( auto command : k_keyless_commands ) {
+        if ( a_command.length_ == strlen(command) && 0 == strncasecmp(a_command.data_, command, a_command.length_) ) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @return REDIS Cluster slot of a key.
+ *
+ * @param a_key
+ */
+int ev::redis::Request::KeySlot (const ev::redis::Request::Argument& a_key)
+{
+    if ( nullptr != a_key.data_ ) {
+        return ::ev::redis::Cluster::Slot(a_key.data_, a_key.length_);
+    }
+    const std::string key = std::to_string(a_key.integer_);
+    return ::ev::redis::Cluster::Slot(key.c_str(), key.length());
+}
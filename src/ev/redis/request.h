@@ -25,9 +25,13 @@
 #include "ev/request.h"
 
 #include "ev/redis/includes.h"
+#include "ev/redis/script.h"
 
-#include <string> // std::string
-#include <vector>  // std::vector
+#include <string.h>         // strlen
+#include <strings.h>        // strncasecmp
+#include <string>           // std::string
+#include <vector>           // std::vector
+#include <initializer_list> // std::initializer_list
 
 namespace ev
 {
@@ -45,6 +49,33 @@ namespace ev
                 Subscription,
                 Other
             };
+            
+        public: // Data Type(s)
+            
+            /**
+             * @brief A command argument, a view over a string or a number, it's only valid while the referenced data is.
+             */
+            class Argument
+            {
+                
+            public: // Const Data
+                
+                const char* const data_;    //!< String data, nullptr when numeric.
+                const size_t      length_;  //!< String data length.
+                const long long   integer_; //!< Numeric value.
+                
+            public: // Constructor(s) / Destructor
+                
+                Argument (const std::string& a_value);
+                Argument (const char* const a_value);
+                Argument (const char* const a_value, const size_t a_length);
+                Argument (const int a_value);
+                Argument (const long a_value);
+                Argument (const long long a_value);
+                Argument (const unsigned int a_value);
+                Argument (const unsigned long a_value);
+                
+            };
 
         protected: // Const Data
 
@@ -52,28 +83,147 @@ namespace ev
 
         protected: // Data
 
-            std::string payload_; //!< Request payload
+            std::string payload_;     //!< Request payload, RESP encoded, buffer is reused when payload is replaced.
+            std::string tracked_key_; //!< Key read by a 'GET', 'HGET' or 'HGETALL' command, empty otherwise.
+            bool        cacheable_;   //!< True when reply can be served by \link TrackingCache \link.
+            int         slot_;        //!< REDIS Cluster slot of the first key, -1 if command has no key.
+            bool        read_only_;   //!< True when this request doesn't write, it can be routed to a replica.
+            const Script* script_;    //!< Script executed by 'EVALSHA', nullptr if none.
 
         public: // Constructor(s) / Destructor
 
             Request(const Loggable::Data& a_loggable_data, const char* const a_command, const std::vector<std::string>& a_args);
+            Request(const Loggable::Data& a_loggable_data, const char* const a_command, std::initializer_list<Argument> a_args);
             Request(const Loggable::Data& a_loggable_data, const ev::Request::Mode a_mode, const Kind a_kind);
+            Request(const Loggable::Data& a_loggable_data, const Script& a_script, std::initializer_list<Argument> a_keys, std::initializer_list<Argument> a_args);
             virtual ~Request();
 
         public: // Inherited Virtual Method(s) / Function(s)
 
-            virtual const char* const  AsCString () const;
-            virtual const std::string& AsString  () const;
+            virtual const char* const  AsCString    () const;
+            virtual const std::string& AsString     () const;
+            virtual ev::Result*        CachedResult () const;
 
         public: // Method(s) / Function(s)
 
             Kind               kind       () const;
 
             void               SetPayload (const std::string& a_command, const std::vector<std::string>& a_args);
+            void               SetPayload (const char* const a_command, std::initializer_list<Argument> a_args);
             const std::string& Payload    () const;
             const char* const  PayloadCStr() const;
             
+            void               SetCacheable ();
+            bool               Cacheable    () const;
+            const std::string& TrackedKey   () const;
+            int                Slot         () const;
+            void               SetReadOnly  (const bool a_read_only);
+            bool               ReadOnly     () const;
+            const Script*      script       () const;
+            
+        private: // Method(s) / Function(s)
+            
+            template <typename C>
+            void                Encode     (const Argument& a_command, const C& a_args);
+            
+        private: // Static Method(s) / Function(s)
+            
+            static size_t       Length     (const Argument& a_argument);
+            static size_t       Digits     (const long long a_value);
+            static void         Append     (std::string& o_buffer, const char a_prefix, const long long a_value);
+            static int          KeyIndex   (const Argument& a_command);
+            static int          KeySlot    (const Argument& a_key);
+            
         }; // end of class 'Request'
+        
+        /**
+         * @brief String constructor.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const std::string& a_value)
+            : data_(a_value.c_str()), length_(a_value.length()), integer_(0)
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief C string constructor.
+         *
+         * @param a_value NULL terminated string.
+         */
+        inline Request::Argument::Argument (const char* const a_value)
+            : data_(a_value), length_(strlen(a_value)), integer_(0)
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Binary string constructor.
+         *
+         * @param a_value
+         * @param a_length
+         */
+        inline Request::Argument::Argument (const char* const a_value, const size_t a_length)
+            : data_(a_value), length_(a_length), integer_(0)
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Numeric constructor, value is only formatted while encoding.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const int a_value)
+            : data_(nullptr), length_(0), integer_(static_cast<long long>(a_value))
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Numeric constructor, value is only formatted while encoding.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const long a_value)
+            : data_(nullptr), length_(0), integer_(static_cast<long long>(a_value))
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Numeric constructor, value is only formatted while encoding.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const long long a_value)
+            : data_(nullptr), length_(0), integer_(a_value)
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Numeric constructor, value is only formatted while encoding.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const unsigned int a_value)
+            : data_(nullptr), length_(0), integer_(static_cast<long long>(a_value))
+        {
+            /* empty */
+        }
+        
+        /**
+         * @brief Numeric constructor, value is only formatted while encoding.
+         *
+         * @param a_value
+         */
+        inline Request::Argument::Argument (const unsigned long a_value)
+            : data_(nullptr), length_(0), integer_(static_cast<long long>(a_value))
+        {
+            /* empty */
+        }
 
         /**
          * @return This request kind, one of \link Kind \link.
@@ -91,19 +241,18 @@ namespace ev
          */
         inline void Request::SetPayload (const std::string& a_command, const std::vector<std::string>& a_args)
         {
-            const size_t args_count = a_args.size() + 1;
-            
-            const char** args_values = new const char* [args_count];
-            args_values[0] = a_command.c_str();
-            for ( size_t idx = 0 ; idx < a_args.size() ; ++idx ) {
-                args_values[ idx + 1 ] = a_args[idx].c_str();
-            }
-            
-            sds cmd;
-            if ( -1 != redisFormatSdsCommandArgv(&cmd, (int)args_count, args_values, nullptr) ) {
-                payload_ = cmd;
-            }
-            sdsfree(cmd);
+            Encode(Argument(a_command), a_args);
+        }
+        
+        /**
+         * @brief Set request payload ( REDIS command string ).
+         *
+         * @param a_command
+         * @param a_args
+         */
+        inline void Request::SetPayload (const char* const a_command, std::initializer_list<Argument> a_args)
+        {
+            Encode(Argument(a_command), a_args);
         }
         
         /**
@@ -122,6 +271,186 @@ namespace ev
             return payload_.c_str();
         }
 
+        /**
+         * @return True when reply can be served by, and stored at, \link TrackingCache \link.
+         */
+        inline bool Request::Cacheable () const
+        {
+            return cacheable_;
+        }
+        
+        /**
+         * @return Key read by this request command, empty if it's not a cacheable command.
+         */
+        inline const std::string& Request::TrackedKey () const
+        {
+            return tracked_key_;
+        }
+        
+        /**
+         * @return REDIS Cluster slot of the first key, -1 if command has no key.
+         */
+        inline int Request::Slot () const
+        {
+            return slot_;
+        }
+        
+        /**
+         * @brief Flag this request as read only, so it can be executed by a replica.
+         *
+         * @param a_read_only
+         */
+        inline void Request::SetReadOnly (const bool a_read_only)
+        {
+            read_only_ = a_read_only;
+        }
+        
+        /**
+         * @return True if this request can be executed by a replica, false if it must be executed by the master.
+         */
+        inline bool Request::ReadOnly () const
+        {
+            return read_only_;
+        }
+        
+        /**
+         * @return Script executed by this request, nullptr if it's not an 'EVALSHA' request.
+         */
+        inline const Script* Request::script () const
+        {
+            return script_;
+        }
+        
+        /**
+         * @brief Encode a command, using RESP, directly into the payload buffer.
+         *
+         * @param a_command
+         * @param a_args
+         */
+        template <typename C>
+        inline void Request::Encode (const Argument& a_command, const C& a_args)
+        {
+            // ... first pass: compute exact size, so buffer is allocated at most once ...
+            size_t count = 1;
+            size_t size  = Length(a_command);
+            for ( const Argument argument : a_args ) {
+                size += Length(argument);
+                ++count;
+            }
+            size += 3 + Digits(static_cast<long long>(count));
+            // ... second pass: write, buffer capacity is kept between payloads ...
+            payload_.clear();
+            payload_.reserve(size);
+            Append(payload_, '*', static_cast<long long>(count));
+            const auto write = [this] (const Argument& a_argument) {
+                if ( nullptr != a_argument.data_ ) {
+                    Append(payload_, '$', static_cast<long long>(a_argument.length_));
+                    payload_.append(a_argument.data_, a_argument.length_);
+                    payload_.append("\r\n", 2);
+                } else {
+                    Append(payload_, '$', static_cast<long long>(Digits(a_argument.integer_)));
+                    Append(payload_, '\0', a_argument.integer_);
+                }
+            };
+            write(a_command);
+            for ( const Argument argument : a_args ) {
+                write(argument);
+            }
+            // ... only single key read commands can be tracked ...
+            tracked_key_.clear();
+            cacheable_ = false;
+            slot_      = -1;
+            if ( 1 == count || nullptr == a_command.data_ ) {
+                return;
+            }
+            // ... cluster: slot of the first key, scripts keys follow 'numkeys' ...
+            const int key_index = KeyIndex(a_command);
+            if ( key_index >= 0 && static_cast<size_t>(key_index) + 1 < count ) {
+                int idx = 0;
+                for ( const Argument argument : a_args ) {
+                    if ( key_index == idx ) {
+                        slot_ = KeySlot(argument);
+                        break;
+                    }
+                    if ( 1 == idx && ( nullptr != argument.data_ ? ( 1 == argument.length_ && '0' == argument.data_[0] ) : 0 == argument.integer_ ) ) {
+                        break;
+                    }
+                    ++idx;
+                }
+            }
+            if (
+                ( 3 == a_command.length_ && 0 == strncasecmp(a_command.data_, "GET"    , 3) && 2 == count )
+                ||
+                ( 4 == a_command.length_ && 0 == strncasecmp(a_command.data_, "HGET"   , 4) && 3 == count )
+                ||
+                ( 7 == a_command.length_ && 0 == strncasecmp(a_command.data_, "HGETALL", 7) && 2 == count )
+            ) {
+                const Argument key = *a_args.begin();
+                if ( nullptr != key.data_ ) {
+                    tracked_key_.assign(key.data_, key.length_);
+                }
+            }
+        }
+        
+        /**
+         * @return Number of bytes needed to encode an argument as a RESP bulk string.
+         *
+         * @param a_argument
+         */
+        inline size_t Request::Length (const Argument& a_argument)
+        {
+            size_t length;
+            if ( nullptr != a_argument.data_ ) {
+                length = a_argument.length_;
+            } else {
+                length = Digits(a_argument.integer_);
+            }
+            // ... '$' <length> CRLF <data> CRLF ...
+            return 1 + Digits(static_cast<long long>(length)) + 2 + length + 2;
+        }
+        
+        /**
+         * @return Number of characters needed to write a value in decimal, including sign.
+         *
+         * @param a_value
+         */
+        inline size_t Request::Digits (const long long a_value)
+        {
+            size_t             digits = ( a_value < 0 ? 2 : 1 );
+            unsigned long long value  = ( a_value < 0 ? static_cast<unsigned long long>(-(a_value + 1)) + 1 : static_cast<unsigned long long>(a_value) );
+            for ( ; value >= 10 ; value /= 10 ) {
+                ++digits;
+            }
+            return digits;
+        }
+        
+        /**
+         * @brief Append an optional prefix, a decimal value and CRLF.
+         *
+         * @param o_buffer
+         * @param a_prefix Prefix, '\0' if none.
+         * @param a_value
+         */
+        inline void Request::Append (std::string& o_buffer, const char a_prefix, const long long a_value)
+        {
+            char  digits[24];
+            char* ptr = digits + sizeof(digits);
+            *(--ptr) = '\n';
+            *(--ptr) = '\r';
+            unsigned long long value = ( a_value < 0 ? static_cast<unsigned long long>(-(a_value + 1)) + 1 : static_cast<unsigned long long>(a_value) );
+            do {
+                *(--ptr) = static_cast<char>('0' + ( value % 10 ));
+                value   /= 10;
+            } while ( 0 != value );
+            if ( a_value < 0 ) {
+                *(--ptr) = '-';
+            }
+            if ( '\0' != a_prefix ) {
+                o_buffer.push_back(a_prefix);
+            }
+            o_buffer.append(ptr, static_cast<size_t>(digits + sizeof(digits) - ptr));
+        }
+
     } // end of namespace 'redis'
 
 } // end of namespace 'ev'
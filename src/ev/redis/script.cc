@@ -0,0 +1,164 @@
+/**
+ * @file script.cc - REDIS Lua Script
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/script.h"
+
+#include "ev/exception.h"
+
+#include "osal/osalite.h"
+
+#include <stdint.h> // uint32_t
+
+std::map<std::string, ev::redis::Script> ev::redis::Script::scripts_;
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_source Lua source code.
+ */
+ev::redis::Script::Script (const std::string& a_source)
+    : source_(a_source), sha1_(SHA1(a_source))
+{
+    /* empty */
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Register a script, only at startup.
+ *
+ * @param a_name   Unique name.
+ * @param a_source Lua source code.
+ *
+ * @return Registered script, it remains valid until the process exits.
+ */
+const ev::redis::Script& ev::redis::Script::Register (const std::string& a_name, const std::string& a_source)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    const auto it = scripts_.find(a_name);
+    if ( scripts_.end() != it ) {
+        if ( it->second.source_ != a_source ) {
+            throw ev::Exception("REDIS script '%s' already registered with a different source!", a_name.c_str());
+        }
+        return it->second;
+    }
+    
+    return scripts_.insert(std::make_pair(a_name, Script(a_source))).first->second;
+}
+
+/**
+ * @brief Obtain a previously registered script.
+ *
+ * @param a_name
+ *
+ * @return Registered script.
+ */
+const ev::redis::Script& ev::redis::Script::Get (const std::string& a_name)
+{
+    const auto it = scripts_.find(a_name);
+    if ( scripts_.end() == it ) {
+        throw ev::Exception("REDIS script '%s' is not registered!", a_name.c_str());
+    }
+    return it->second;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Compute a SHA1 digest ( FIPS 180-4 ).
+ *
+ * @param a_data
+ *
+ * @return Lower case hex string.
+ */
+std::string ev::redis::Script::SHA1 (const std::string& a_data)
+{
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    
+    // ... message, 0x80, zero padding and 64 bit big endian length in bits ...
+    std::string message = a_data;
+    message.push_back(static_cast<char>(0x80));
+    while ( 56 != ( message.length() % 64 ) ) {
+        message.push_back('\0');
+    }
+    const uint64_t bits = static_cast<uint64_t>(a_data.length()) * 8;
+    for ( int shift = 56 ; shift >= 0 ; shift -= 8 ) {
+        message.push_back(static_cast<char>(( bits >> shift ) & 0xFF));
+    }
+    
+    const auto rotl = [] (const uint32_t a_value, const int a_bits) -> uint32_t {
+        return ( a_value << a_bits ) | ( a_value >> ( 32 - a_bits ) );
+    };
+    
+    uint32_t w[80];
+    for ( size_t offset = 0 ; offset < message.length() ; offset += 64 ) {
+        for ( size_t idx = 0 ; idx < 16 ; ++idx ) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(message.data() + offset + idx * 4);
+            w[idx] = ( static_cast<uint32_t>(p[0]) << 24 ) | ( static_cast<uint32_t>(p[1]) << 16 ) | ( static_cast<uint32_t>(p[2]) << 8 ) | static_cast<uint32_t>(p[3]);
+        }
+        for ( size_t idx = 16 ; idx < 80 ; ++idx ) {
+            w[idx] = rotl(w[idx - 3] ^ w[idx - 8] ^ w[idx - 14] ^ w[idx - 16], 1);
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for ( size_t idx = 0 ; idx < 80 ; ++idx ) {
+            uint32_t f, k;
+            if ( idx < 20 ) {
+                f = ( b & c ) | ( ~b & d );
+                k = 0x5A827999;
+            } else if ( idx < 40 ) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if ( idx < 60 ) {
+                f = ( b & c ) | ( b & d ) | ( c & d );
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const uint32_t t = rotl(a, 5) + f + e + k + w[idx];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    
+    static const char* const k_hex = "0123456789abcdef";
+    std::string digest;
+    digest.reserve(40);
+    for ( auto value : h ) {
+        for ( int shift = 28 ; shift >= 0 ; shift -= 4 ) {
+            digest.push_back(k_hex[( value >> shift ) & 0xF]);
+        }
+    }
+    return digest;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file script.h - REDIS Lua Script
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_SCRIPT_H_
+#define NRS_EV_REDIS_SCRIPT_H_
+
+#include <string> // std::string
+#include <map>    // std::map
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        /**
+         * @brief A Lua script, executed by it's SHA1 digest with 'EVALSHA'.
+         *
+         * @remarks Scripts are registered at startup, by the main thread, and are read-only afterwards.
+         *          When a server doesn't know a script ( 'NOSCRIPT' ), \link ev::redis::Device \link loads it
+         *          with 'SCRIPT LOAD' and retries the request on the same connection.
+         */
+        class Script final
+        {
+            
+        private: // Static Data
+            
+            static std::map<std::string, Script> scripts_;
+            
+        private: // Const Data
+            
+            const std::string source_; //!< Lua source code.
+            const std::string sha1_;   //!< Source SHA1 digest, lower case hex string.
+            
+        public: // Constructor(s) / Destructor
+            
+            Script (const std::string& a_source);
+            
+        public: // Method(s) / Function(s)
+            
+            const std::string& source () const;
+            const std::string& sha1   () const;
+            
+        public: // Static Method(s) / Function(s)
+            
+            static const Script& Register (const std::string& a_name, const std::string& a_source);
+            static const Script& Get      (const std::string& a_name);
+            
+        private: // Static Method(s) / Function(s)
+            
+            static std::string SHA1 (const std::string& a_data);
+            
+        }; // end of class 'Script'
+        
+        /**
+         * @return Lua source code.
+         */
+        inline const std::string& Script::source () const
+        {
+            return source_;
+        }
+        
+        /**
+         * @return Source SHA1 digest, as expected by 'EVALSHA'.
+         */
+        inline const std::string& Script::sha1 () const
+        {
+            return sha1_;
+        }
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_SCRIPT_H_
@@ -0,0 +1,452 @@
+/**
+ * @file sentinel.cc - REDIS Sentinel
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/sentinel.h"
+
+#include "ev/redis/request.h"
+
+#include "ev/exception.h"
+
+#include "osal/osalite.h"
+
+#include <algorithm> // std::max
+#include <cstdlib>   // std::strtol
+#include <chrono>    // std::chrono::steady_clock
+
+#include <poll.h>
+#include <errno.h>
+
+std::vector<ev::redis::Sentinel::Node> ev::redis::Sentinel::sentinels_           = {};
+std::string                            ev::redis::Sentinel::master_name_         = "";
+ev::redis::Sentinel::Node              ev::redis::Sentinel::master_              = { "", 0 };
+std::vector<ev::redis::Sentinel::Node> ev::redis::Sentinel::replicas_            = {};
+size_t                                 ev::redis::Sentinel::next_                = 0;
+int64_t                                ev::redis::Sentinel::refresh_interval_ms_ = 0;
+bool                                   ev::redis::Sentinel::aborted_             = false;
+std::thread*                           ev::redis::Sentinel::thread_              = nullptr;
+std::mutex                             ev::redis::Sentinel::mutex_;
+std::condition_variable                ev::redis::Sentinel::cv_;
+
+const char* const                      ev::redis::Sentinel::k_switch_master_channel_       = "+switch-master";
+const int64_t                          ev::redis::Sentinel::k_default_refresh_interval_ms_ = 10000; // 10s
+
+/**
+ * @brief One-shot initializer, starts background topology discovery.
+ *
+ * @param a_sentinels           Sentinels, as '<ip address>:<port number>'.
+ * @param a_master_name         Name of the master monitored by sentinels.
+ * @param a_refresh_interval_ms Master and replicas discovery interval, in milliseconds, failovers are
+ *                              also notified by sentinels through '+switch-master' events.
+ */
+void ev::redis::Sentinel::Startup (const std::vector<std::string>& a_sentinels, const std::string& a_master_name,
+                                   const int64_t a_refresh_interval_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr != thread_ ) {
+        throw ev::Exception("REDIS sentinel already configured!");
+    }
+    
+    // ... nothing to do?
+    if ( 0 == a_sentinels.size() ) {
+        return;
+    }
+    
+    if ( 0 == a_master_name.length() ) {
+        throw ev::Exception("Invalid REDIS sentinel configuration - master name is not set!");
+    }
+    
+    std::vector<Node> sentinels;
+    for ( auto endpoint : a_sentinels ) {
+        Node node;
+        if ( false == Split(endpoint, node.ip_address_, node.port_number_) ) {
+            throw ev::Exception("Invalid REDIS sentinel '%s' - expected <ip address>:<port number>!", endpoint.c_str());
+        }
+        sentinels.push_back(node);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sentinels_           = sentinels;
+        master_name_         = a_master_name;
+        master_              = { "", 0 };
+        replicas_.clear();
+        next_                = 0;
+        refresh_interval_ms_ = std::max(a_refresh_interval_ms, static_cast<int64_t>(1000));
+        aborted_             = false;
+    }
+    
+    thread_ = new std::thread(&ev::redis::Sentinel::Loop, this);
+}
+
+/**
+ * @brief Call this to stop background topology discovery and release previously allocated memory.
+ */
+void ev::redis::Sentinel::Shutdown ()
+{
+    if ( nullptr != thread_ ) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            aborted_ = true;
+        }
+        cv_.notify_all();
+        thread_->join();
+        delete thread_;
+        thread_ = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    sentinels_.clear();
+    master_ = { "", 0 };
+    replicas_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @return True if sentinel mode was configured, false otherwise.
+ */
+bool ev::redis::Sentinel::Enabled ()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ( 0 != sentinels_.size() );
+}
+
+/**
+ * @brief Select the server a new device, that will execute a request, should connect to.
+ *
+ * @param a_request
+ * @param o_ip_address  Server IP address, untouched if master is not known yet.
+ * @param o_port_number Server port number, untouched if master is not known yet.
+ * @param o_replica     True if a replica was selected, false if it's the master.
+ *
+ * @return True if a server was selected, false if device should connect to the configured endpoint.
+ *
+ * @remarks Only read only \link ev::redis::Request \link are routed to replicas, round-robin.
+ */
+bool ev::redis::Sentinel::Route (const ev::Request* a_request, std::string& o_ip_address, int& o_port_number, bool& o_replica)
+{
+    const ev::redis::Request* request   = dynamic_cast<const ev::redis::Request*>(a_request);
+    const bool                read_only = ( nullptr != request && true == request->ReadOnly() );
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if ( 0 == master_.ip_address_.length() ) {
+        return false;
+    }
+    
+    if ( true == read_only && 0 != replicas_.size() ) {
+        const Node& replica = replicas_[next_ % replicas_.size()];
+        next_         = ( next_ + 1 ) % replicas_.size();
+        o_ip_address  = replica.ip_address_;
+        o_port_number = replica.port_number_;
+        o_replica     = true;
+    } else {
+        o_ip_address  = master_.ip_address_;
+        o_port_number = master_.port_number_;
+        o_replica     = false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Check if a server is the current master.
+ *
+ * @param a_ip_address
+ * @param a_port_number
+ *
+ * @return True if so or if master is not known yet, false otherwise.
+ */
+bool ev::redis::Sentinel::IsMaster (const std::string& a_ip_address, const int a_port_number)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ( 0 == master_.ip_address_.length() || ( a_port_number == master_.port_number_ && a_ip_address == master_.ip_address_ ) );
+}
+
+/**
+ * @brief Check if a server is a healthy replica of the current master.
+ *
+ * @param a_ip_address
+ * @param a_port_number
+ *
+ * @return True if so, false otherwise.
+ */
+bool ev::redis::Sentinel::IsReplica (const std::string& a_ip_address, const int a_port_number)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for ( auto& replica : replicas_ ) {
+        if ( a_port_number == replica.port_number_ && a_ip_address == replica.ip_address_ ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return True if at least one healthy replica is known, false otherwise.
+ */
+bool ev::redis::Sentinel::HasReplicas ()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ( 0 != replicas_.size() );
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Background thread loop, discovers topology and listens to failovers, using one sentinel at a time.
+ */
+void ev::redis::Sentinel::Loop ()
+{
+    const struct timeval timeout = { 1, 0 };
+    
+    size_t index = 0;
+    while ( true ) {
+        
+        Node sentinel;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ( true == aborted_ ) {
+                break;
+            }
+            sentinel = sentinels_[index % sentinels_.size()];
+        }
+        
+        // ... discover, then listen to failovers until next discovery is due ...
+        bool success = false;
+        redisContext* context = redisConnectWithTimeout(sentinel.ip_address_.c_str(), sentinel.port_number_, timeout);
+        if ( nullptr != context && 0 == context->err ) {
+            (void) redisSetTimeout(context, timeout);
+            success = ( true == Discover(context) && true == Watch(context) );
+        }
+        if ( nullptr != context ) {
+            redisFree(context);
+        }
+        
+        if ( true == success ) {
+            continue;
+        }
+        
+        // ... try next sentinel, after all were tried wait a bit ...
+        index = ( index + 1 ) % sentinels_.size();
+        if ( 0 == index ) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if ( true == cv_.wait_for(lock, std::chrono::milliseconds(1000), [] { return aborted_; }) ) {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Synchronously ask a sentinel for the current master and it's healthy replicas.
+ *
+ * @param a_context Sentinel connection.
+ *
+ * @return True if master address was obtained, false otherwise.
+ */
+bool ev::redis::Sentinel::Discover (redisContext* a_context)
+{
+    Node              master = { "", 0 };
+    std::vector<Node> replicas;
+    
+    // ... [ <ip>, <port> ] ...
+    redisReply* reply = static_cast<redisReply*>(redisCommand(a_context, "SENTINEL get-master-addr-by-name %s", master_name_.c_str()));
+    if ( nullptr != reply && REDIS_REPLY_ARRAY == reply->type && 2 == reply->elements
+        &&
+        REDIS_REPLY_STRING == reply->element[0]->type && REDIS_REPLY_STRING == reply->element[1]->type
+    ) {
+        master.ip_address_  = std::string(reply->element[0]->str, reply->element[0]->len);
+        master.port_number_ = static_cast<int>(std::strtol(reply->element[1]->str, nullptr, 10));
+    }
+    if ( nullptr != reply ) {
+        freeReplyObject(reply);
+    }
+    if ( 0 == master.ip_address_.length() || master.port_number_ <= 0 ) {
+        return false;
+    }
+    
+    // ... [ [ <field>, <value>, ... ], ... ], 'SENTINEL slaves' before REDIS 5.0 ...
+    reply = static_cast<redisReply*>(redisCommand(a_context, "SENTINEL replicas %s", master_name_.c_str()));
+    if ( nullptr != reply && REDIS_REPLY_ERROR == reply->type ) {
+        freeReplyObject(reply);
+        reply = static_cast<redisReply*>(redisCommand(a_context, "SENTINEL slaves %s", master_name_.c_str()));
+    }
+    if ( nullptr != reply && REDIS_REPLY_ARRAY == reply->type ) {
+        for ( size_t idx = 0 ; idx < reply->elements ; ++idx ) {
+            const redisReply* fields = reply->element[idx];
+            if ( REDIS_REPLY_ARRAY != fields->type ) {
+                continue;
+            }
+            Node        replica = { "", 0 };
+            std::string flags;
+            std::string link_status;
+            for ( size_t field = 0 ; field + 1 < fields->elements ; field += 2 ) {
+                const redisReply* name  = fields->element[field];
+                const redisReply* value = fields->element[field + 1];
+                if ( REDIS_REPLY_STRING != name->type || REDIS_REPLY_STRING != value->type ) {
+                    continue;
+                }
+                const std::string n(name->str, name->len);
+                if ( 0 == n.compare("ip") ) {
+                    replica.ip_address_ = std::string(value->str, value->len);
+                } else if ( 0 == n.compare("port") ) {
+                    replica.port_number_ = static_cast<int>(std::strtol(value->str, nullptr, 10));
+                } else if ( 0 == n.compare("flags") ) {
+                    flags = std::string(value->str, value->len);
+                } else if ( 0 == n.compare("master-link-status") ) {
+                    link_status = std::string(value->str, value->len);
+                }
+            }
+            // ... only replicas that are reachable and replicating ...
+            if ( 0 == replica.ip_address_.length() || replica.port_number_ <= 0
+                ||
+                std::string::npos != flags.find("s_down") || std::string::npos != flags.find("o_down") || std::string::npos != flags.find("disconnected")
+                ||
+                0 != link_status.compare("ok")
+            ) {
+                continue;
+            }
+            replicas.push_back(replica);
+        }
+    }
+    if ( nullptr != reply ) {
+        freeReplyObject(reply);
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    master_   = master;
+    replicas_ = replicas;
+    next_     = 0;
+    
+    return true;
+}
+
+/**
+ * @brief Listen to '+switch-master' events until next discovery is due.
+ *
+ * @param a_context Sentinel connection, it can't be used for other commands after this call.
+ *
+ * @return True if discovery is due, a failover was notified or shutdown was requested, false on connection error.
+ */
+bool ev::redis::Sentinel::Watch (redisContext* a_context)
+{
+    redisReply* reply = static_cast<redisReply*>(redisCommand(a_context, "SUBSCRIBE %s", k_switch_master_channel_));
+    if ( nullptr == reply ) {
+        return false;
+    }
+    freeReplyObject(reply);
+    
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(refresh_interval_ms_);
+    while ( std::chrono::steady_clock::now() < deadline ) {
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ( true == aborted_ ) {
+                return true;
+            }
+        }
+        
+        // ... wait for an event, without blocking shutdown ...
+        struct pollfd pfd = { a_context->fd, POLLIN, 0 };
+        const int poll_rv = poll(&pfd, 1, 250);
+        if ( 0 == poll_rv || ( poll_rv < 0 && EINTR == errno ) ) {
+            continue;
+        } else if ( poll_rv < 0 ) {
+            return false;
+        }
+        
+        void* message = nullptr;
+        if ( REDIS_OK != redisGetReply(a_context, &message) || nullptr == message ) {
+            return false;
+        }
+        
+        // ... [ "message", "+switch-master", "<name> <old ip> <old port> <new ip> <new port>" ] ...
+        bool              switched = false;
+        const redisReply* event    = static_cast<const redisReply*>(message);
+        if ( REDIS_REPLY_ARRAY == event->type && 3 == event->elements && REDIS_REPLY_STRING == event->element[2]->type ) {
+            std::vector<std::string> tokens;
+            const std::string payload(event->element[2]->str, event->element[2]->len);
+            size_t start = 0;
+            while ( start < payload.length() ) {
+                size_t end = payload.find(' ', start);
+                if ( std::string::npos == end ) {
+                    end = payload.length();
+                }
+                if ( end > start ) {
+                    tokens.push_back(payload.substr(start, end - start));
+                }
+                start = end + 1;
+            }
+            if ( 5 == tokens.size() && tokens[0] == master_name_ ) {
+                const int port_number = static_cast<int>(std::strtol(tokens[4].c_str(), nullptr, 10));
+                if ( port_number > 0 ) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    master_ = { tokens[3], port_number };
+                    // ... replicas will be re-discovered, promoted replica is no longer one ...
+                    replicas_.erase(std::remove_if(replicas_.begin(), replicas_.end(), [port_number, &tokens] (const Node& a_node) {
+                        return ( port_number == a_node.port_number_ && tokens[3] == a_node.ip_address_ );
+                    }), replicas_.end());
+                    switched = true;
+                }
+            }
+        }
+        freeReplyObject(message);
+        
+        if ( true == switched ) {
+            break;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Split a '<ip address>:<port number>' endpoint.
+ *
+ * @param a_endpoint
+ * @param o_ip_address
+ * @param o_port_number
+ *
+ * @return True on success, false if endpoint is invalid.
+ */
+bool ev::redis::Sentinel::Split (const std::string& a_endpoint, std::string& o_ip_address, int& o_port_number)
+{
+    const size_t separator = a_endpoint.rfind(':');
+    if ( std::string::npos == separator || 0 == separator || a_endpoint.length() - 1 == separator ) {
+        return false;
+    }
+    
+    char* end = nullptr;
+    const long port = std::strtol(a_endpoint.c_str() + separator + 1, &end, 10);
+    if ( '\0' != *end || port <= 0 || port > 65535 ) {
+        return false;
+    }
+    
+    o_ip_address  = a_endpoint.substr(0, separator);
+    o_port_number = static_cast<int>(port);
+    
+    return true;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file sentinel.h - REDIS Sentinel
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_SENTINEL_H_
+#define NRS_EV_REDIS_SENTINEL_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/request.h"
+
+#include "ev/redis/includes.h"
+
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex
+#include <condition_variable> // std::condition_variable
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        /**
+         * @brief Keeps track of a REDIS master, and it's replicas, monitored by REDIS Sentinel, topology is discovered
+         *        in background by a dedicated thread that also listens to '+switch-master' events.
+         *
+         * @remarks Devices connected to a former master are refused by \link ev::redis::Device::AffinityFor \link and
+         *          fail their health probes, so they are replaced by devices connected to the new master, see \link Route \link.
+         */
+        class Sentinel final : public osal::Singleton<Sentinel>
+        {
+            
+        private: // Data Type(s)
+            
+            typedef struct {
+                std::string ip_address_;  //!< IP address.
+                int         port_number_; //!< Port number.
+            } Node;
+            
+        public: // Static Const Data
+            
+            static const char* const        k_switch_master_channel_;
+            static const int64_t            k_default_refresh_interval_ms_;
+            
+        private: // Static Data
+            
+            static std::vector<Node>        sentinels_;
+            static std::string              master_name_;
+            static Node                     master_;
+            static std::vector<Node>        replicas_;
+            static size_t                   next_;
+            static int64_t                  refresh_interval_ms_;
+            static bool                     aborted_;
+            static std::thread*             thread_;
+            static std::mutex               mutex_;
+            static std::condition_variable  cv_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const std::vector<std::string>& a_sentinels, const std::string& a_master_name,
+                           const int64_t a_refresh_interval_ms = k_default_refresh_interval_ms_);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool Enabled     ();
+            bool Route       (const ev::Request* a_request, std::string& o_ip_address, int& o_port_number, bool& o_replica);
+            bool IsMaster    (const std::string& a_ip_address, const int a_port_number);
+            bool IsReplica   (const std::string& a_ip_address, const int a_port_number);
+            bool HasReplicas ();
+            
+        private: // Method(s) / Function(s)
+            
+            void Loop     ();
+            bool Discover (redisContext* a_context);
+            bool Watch    (redisContext* a_context);
+            
+        private: // Static Method(s) / Function(s)
+            
+            static bool Split (const std::string& a_endpoint, std::string& o_ip_address, int& o_port_number);
+            
+        }; // end of class 'Sentinel'
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_SENTINEL_H_
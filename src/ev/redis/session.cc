@@ -20,6 +20,7 @@
  */
 
 #include "ev/redis/session.h"
+#include "ev/redis/session_cache.h"
 
 #include "ev/redis/request.h"
 #include "ev/redis/error.h"
@@ -126,7 +127,7 @@ void ev::redis::Session::Set (const ev::redis::Session::DataT& a_data,
         //
         // Set expiration.
         //
-        return new ::ev::redis::Request(loggable_data_, "EXPIRE", { session_key, std::to_string(a_data.expires_in_) });
+        return new ::ev::redis::Request(loggable_data_, "EXPIRE", { session_key, a_data.expires_in_ });
         
     });
     
@@ -390,32 +391,39 @@ void ev::redis::Session::Fetch (const ev::redis::Session::SuccessCallback a_succ
                                 const ev::redis::Session::InvalidCallback a_invalid_session_callback,
                                 const ev::redis::Session::FailureCallback a_failure_callback)
 {
-    bool session_exists = false;
+    const std::string key = token_prefix_ + data_.token_;
     
-    NewTask([this] () -> ::ev::Object* {
-        
-        return new ::ev::redis::Request(loggable_data_, "EXISTS", { token_prefix_ + data_.token_ } );
-        
-    })->Then([this, &session_exists] (::ev::Object* a_object) -> ::ev::Object* {
+    // ... cached, and not invalidated, session?
+    ::ev::redis::SessionCache& cache = ::ev::redis::SessionCache::GetInstance();
+    if ( true == cache.Enabled() ) {
+        const ::ev::redis::SessionCache::EntryPtr entry = cache.Get(key);
+        if ( nullptr != entry ) {
+            // ... no round trip, but callback is still called asynchronously, as it would be if the session was fetched ...
+            ::ev::scheduler::Scheduler::GetInstance().SetClientTimeout(this, 0, [this, entry, a_success_callback] () {
+                data_.payload_        = entry->payload_;
+                data_.token_is_valid_ = true;
+                data_.verified_       = true;
+                data_.exists_         = true;
+                a_success_callback(data_);
+            });
+            return;
+        }
+    }
+    
+    const uint64_t generation = cache.Generation();
+    
+    NewTask([this, key] () -> ::ev::Object* {
         
         //
-        // EXISTS:
+        // HGETALL:
         //
-        // - Integer reply is expected:
+        // - Array reply is expected:
         //
-        //  - 1 the key exists
-        //  - 0 the key does not exists
+        //  - list of fields and their values, empty list when key does not exist.
         //
+        return new ::ev::redis::Request(loggable_data_, "HGETALL", { key });
         
-        const ev::redis::Value& value = ev::redis::Reply::EnsureIntegerReply(a_object);
-        if ( 1 != value.Integer() ) {
-            throw ev::Exception("Session does not exists!");
-        }
-        session_exists = true;
-        
-        return new ::ev::redis::Request(loggable_data_, "HGETALL", { token_prefix_ + data_.token_ });
-        
-    })->Finally([a_success_callback, a_invalid_session_callback, this] (::ev::Object* a_object) {
+    })->Finally([a_success_callback, a_invalid_session_callback, key, generation, this] (::ev::Object* a_object) {
         
         const ::ev::Result* result = dynamic_cast<const ::ev::Result*>(a_object);
         if ( nullptr == result ) {
@@ -434,14 +442,23 @@ void ev::redis::Session::Fetch (const ev::redis::Session::SuccessCallback a_succ
             throw ::ev::Exception("Unexpected reply object - nullptr!");
         }
         
-        const ::ev::redis::Value& value = reply->value();
+        // ... read directly from reply tree, when available, avoiding an intermediate copy ...
+        const ::ev::redis::ReplyHandle& handle = reply->handle();
         
-        switch (value.content_type()) {
+        switch (true == handle.Valid() ? handle.content_type() : reply->value().content_type()) {
             case ::ev::redis::Value::ContentType::Array:
-                data_.token_is_valid_ = value.Size() > 0;
-                value.IterateHash([this](const ::ev::redis::Value* a_key, const ::ev::redis::Value* a_value){
-                    data_.payload_[a_key->String()] = a_value->String();
-                });
+                if ( true == handle.Valid() ) {
+                    data_.token_is_valid_ = handle.Size() > 0;
+                    handle.IterateHash([this](const ::ev::redis::ReplyHandle& a_key, const ::ev::redis::ReplyHandle& a_value){
+                        data_.payload_[a_key.String()].assign(a_value.Data(), a_value.Length());
+                    });
+                } else {
+                    const ::ev::redis::Value& value = reply->value();
+                    data_.token_is_valid_ = value.Size() > 0;
+                    value.IterateHash([this](const ::ev::redis::Value* a_key, const ::ev::redis::Value* a_value){
+                        data_.payload_[a_key->String()] = a_value->String();
+                    });
+                }
                 break;
             case ::ev::redis::Value::ContentType::Integer:
                 throw ::ev::Exception("Logic error: expecting an hash got an integer!");
@@ -458,6 +475,7 @@ void ev::redis::Session::Fetch (const ev::redis::Session::SuccessCallback a_succ
         if ( true == data_.token_is_valid_ ) {
             data_.verified_ = true;
             data_.exists_   = true;
+            (void) ::ev::redis::SessionCache::GetInstance().Set(token_prefix_, key, data_.payload_, generation);
             a_success_callback(data_);
         } else {
             data_.verified_ = true;
@@ -465,13 +483,9 @@ void ev::redis::Session::Fetch (const ev::redis::Session::SuccessCallback a_succ
             a_invalid_session_callback(data_);
         }
 
-    })->Catch([this, a_failure_callback, a_invalid_session_callback, &session_exists] (const ::ev::Exception& a_ev_exception) {
-                
-        if ( false == session_exists ) {
-            a_invalid_session_callback(data_);
-        } else {
-            a_failure_callback(data_, a_ev_exception);
-        }
+    })->Catch([this, a_failure_callback] (const ::ev::Exception& a_ev_exception) {
+        
+        a_failure_callback(data_, a_ev_exception);
         
     });
 }
@@ -0,0 +1,269 @@
+/**
+ * @file session_cache.cc - REDIS Session Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/session_cache.h"
+
+#include "ev/exception.h"
+
+#include <algorithm> // std::max
+
+const char* const                      ev::redis::SessionCache::k_keyspace_pattern_prefix_ = "__keyspace@*__:";
+
+size_t                                 ev::redis::SessionCache::max_entries_ = 0;
+int64_t                                ev::redis::SessionCache::ttl_ms_      = 0;
+bool                                   ev::redis::SessionCache::enabled_     = false;
+ev::redis::SessionCache::EntriesMap    ev::redis::SessionCache::entries_;
+ev::redis::SessionCache::LRUList       ev::redis::SessionCache::lru_;
+ev::redis::SessionCache::PatternsMap   ev::redis::SessionCache::patterns_;
+uint64_t                               ev::redis::SessionCache::generation_  = 0;
+
+/**
+ * @brief One-shot initializer.
+ *
+ * @param a_max_entries Maximum number of cached sessions.
+ * @param a_ttl_ms      Entry TTL, in milliseconds, a safety net for lost notifications.
+ *
+ * @remarks REDIS subscriptions must be started, see \link ev::redis::subscriptions::Manager::Startup \link.
+ */
+void ev::redis::SessionCache::Startup (const size_t a_max_entries, const int64_t a_ttl_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( true == enabled_ ) {
+        throw ev::Exception("REDIS session cache already configured!");
+    }
+    
+    max_entries_ = a_max_entries;
+    ttl_ms_      = std::max(a_ttl_ms, static_cast<int64_t>(0));
+    generation_  = 0;
+    enabled_     = ( max_entries_ > 0 && ttl_ms_ > 0 );
+}
+
+/**
+ * @brief Call this to dealloc previously allocated memory.
+ */
+void ev::redis::SessionCache::Shutdown ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( true == enabled_ && patterns_.size() > 0 ) {
+        try {
+            ::ev::redis::subscriptions::Manager::GetInstance().Unubscribe(this);
+        } catch (const ev::Exception& a_ev_exception) {
+            // ... subscriptions already shutdown ...
+        }
+    }
+    
+    Clear();
+    patterns_.clear();
+    enabled_ = false;
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Lookup a cached session.
+ *
+ * @param a_key Session key.
+ *
+ * @return Shared, immutable, entry or nullptr if not cached or expired.
+ */
+ev::redis::SessionCache::EntryPtr ev::redis::SessionCache::Get (const std::string& a_key)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( false == enabled_ ) {
+        return nullptr;
+    }
+    
+    const auto it = entries_.find(a_key);
+    if ( entries_.end() == it ) {
+        return nullptr;
+    }
+    
+    // ... expired?
+    if ( std::chrono::steady_clock::now() >= it->second.entry_->expires_at_ ) {
+        Erase(it);
+        return nullptr;
+    }
+    
+    // ... most recently used ...
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it_);
+    
+    return it->second.entry_;
+}
+
+/**
+ * @brief Cache a session.
+ *
+ * @param a_prefix     Session key prefix, keys starting with it are watched.
+ * @param a_key        Session key.
+ * @param a_payload    Session payload.
+ * @param a_generation Value of \link Generation \link read before session was fetched.
+ *
+ * @return True if session was cached, false otherwise.
+ */
+bool ev::redis::SessionCache::Set (const std::string& a_prefix, const std::string& a_key,
+                                   const std::map<std::string, std::string>& a_payload, const uint64_t a_generation)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... an invalidation arrived while session was being fetched, payload might be stale ...
+    if ( false == enabled_ || a_generation != generation_ ) {
+        return false;
+    }
+    
+    // ... an entry that can't be invalidated won't be cached ...
+    if ( false == Watch(a_prefix) ) {
+        return false;
+    }
+    
+    // ... replace previous entry, if any ...
+    const auto it = entries_.find(a_key);
+    if ( entries_.end() != it ) {
+        Erase(it);
+    }
+    
+    lru_.push_front(a_key);
+    entries_[a_key] = {
+        /* entry_  */ EntryPtr(new Entry(a_payload, std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms_))),
+        /* lru_it_ */ lru_.begin()
+    };
+    
+    // ... evict least recently used entries ...
+    while ( entries_.size() > max_entries_ ) {
+        Erase(entries_.find(lru_.back()));
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Drop a cached session.
+ *
+ * @param a_key Session key.
+ */
+void ev::redis::SessionCache::Invalidate (const std::string& a_key)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    generation_++;
+    
+    const auto it = entries_.find(a_key);
+    if ( entries_.end() != it ) {
+        Erase(it);
+    }
+}
+
+/**
+ * @brief Drop all entries.
+ */
+void ev::redis::SessionCache::Clear ()
+{
+    generation_++;
+    entries_.clear();
+    lru_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief This method will be called when REDIS subscriptions connection is lost, notifications might have been missed.
+ */
+void ev::redis::SessionCache::OnREDISConnectionLost ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    // ... nothing is cached until patterns are subscribed again ...
+    for ( auto& it : patterns_ ) {
+        it.second = false;
+    }
+    Clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Ensure keyspace notifications for a key prefix are being received.
+ *
+ * @param a_prefix Session key prefix.
+ *
+ * @return True if pattern subscription is confirmed, false otherwise.
+ */
+bool ev::redis::SessionCache::Watch (const std::string& a_prefix)
+{
+    const std::string pattern = k_keyspace_pattern_prefix_ + a_prefix + "*";
+    
+    const auto it = patterns_.find(pattern);
+    if ( patterns_.end() != it ) {
+        return it->second;
+    }
+    
+    patterns_[pattern] = false;
+    try {
+        ::ev::redis::subscriptions::Manager::GetInstance().SubscribePatterns({ pattern },
+                                                                             [this] (const std::string& a_name, const ::ev::redis::subscriptions::Manager::Status& a_status) -> EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK {
+                                                                                 const auto pattern_it = patterns_.find(a_name);
+                                                                                 if ( patterns_.end() != pattern_it ) {
+                                                                                     pattern_it->second = ( ::ev::redis::subscriptions::Manager::Status::Subscribed == a_status );
+                                                                                     if ( false == pattern_it->second ) {
+                                                                                         Clear();
+                                                                                     }
+                                                                                 }
+                                                                                 return nullptr;
+                                                                             },
+                                                                             [this] (const std::string& a_channel, const ::ev::redis::subscriptions::MessagePtr& /* a_event */) -> EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK {
+                                                                                 // ... __keyspace@<db>__:<key> ...
+                                                                                 const size_t separator = a_channel.find("__:");
+                                                                                 if ( std::string::npos != separator ) {
+                                                                                     Invalidate(a_channel.substr(separator + 3));
+                                                                                 } else {
+                                                                                     Clear();
+                                                                                 }
+                                                                                 return nullptr;
+                                                                             },
+                                                                             this
+        );
+    } catch (const ev::Exception& a_ev_exception) {
+        // ... subscriptions not available ...
+        patterns_.erase(pattern);
+        return false;
+    }
+    
+    return patterns_[pattern];
+}
+
+/**
+ * @brief Erase an entry.
+ *
+ * @param a_it
+ */
+void ev::redis::SessionCache::Erase (ev::redis::SessionCache::EntriesMap::iterator a_it)
+{
+    lru_.erase(a_it->second.lru_it_);
+    entries_.erase(a_it);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file session_cache.h - REDIS Session Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_SESSION_CACHE_H_
+#define NRS_EV_REDIS_SESSION_CACHE_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/redis/subscriptions/manager.h"
+
+#include <string> // std::string
+#include <map>    // std::map
+#include <list>   // std::list
+#include <memory> // std::shared_ptr
+#include <chrono> // std::chrono::steady_clock
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        /**
+         * @brief An opt-in, size and TTL bounded, LRU cache of decoded REDIS sessions.
+         *
+         * @remarks Entries are invalidated by REDIS keyspace notifications, server must be configured
+         *          with 'notify-keyspace-events' including at least 'K', 'g', 'h' and 'x' classes.
+         *          A token prefix is only cached after its keyspace pattern subscription is confirmed.
+         *          Must be used from the main thread only.
+         */
+        class SessionCache final : public osal::Singleton<SessionCache>, public ::ev::redis::subscriptions::Manager::Client
+        {
+            
+        public: // Data Type(s)
+            
+            class Entry
+            {
+                
+            public: // Const Data
+                
+                const std::map<std::string, std::string>    payload_;    //!< Cached session payload.
+                const std::chrono::steady_clock::time_point expires_at_; //!< When this entry is no longer valid.
+                
+            public: // Constructor(s) / Destructor
+                
+                /**
+                 * @brief Default constructor.
+                 *
+                 * @param a_payload
+                 * @param a_expires_at
+                 */
+                Entry (const std::map<std::string, std::string>& a_payload, const std::chrono::steady_clock::time_point& a_expires_at)
+                    : payload_(a_payload), expires_at_(a_expires_at)
+                {
+                    /* empty */
+                }
+                
+            }; // end of class 'Entry'
+            
+            typedef std::shared_ptr<const Entry> EntryPtr;
+            
+        private: // Data Type(s)
+            
+            typedef std::list<std::string> LRUList;
+            
+            typedef struct {
+                EntryPtr          entry_;  //!< Shared, immutable, entry.
+                LRUList::iterator lru_it_; //!< Position in LRU list.
+            } Slot;
+            
+            typedef std::map<std::string, Slot> EntriesMap;
+            typedef std::map<std::string, bool> PatternsMap;
+            
+        private: // Static Const Data
+            
+            static const char* const k_keyspace_pattern_prefix_;
+            
+        private: // Static Data
+            
+            static size_t      max_entries_;
+            static int64_t     ttl_ms_;
+            static bool        enabled_;
+            static EntriesMap  entries_;
+            static LRUList     lru_;
+            static PatternsMap patterns_;
+            static uint64_t    generation_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const size_t a_max_entries, const int64_t a_ttl_ms);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool     Enabled    () const;
+            uint64_t Generation () const;
+            EntryPtr Get        (const std::string& a_key);
+            bool     Set        (const std::string& a_prefix, const std::string& a_key,
+                                 const std::map<std::string, std::string>& a_payload, const uint64_t a_generation);
+            void     Invalidate (const std::string& a_key);
+            void     Clear      ();
+            
+        public: // Inherited Pure Virtual Method(s) / Function(s) - from ::ev::redis::subscriptions::Manager::Client
+            
+            virtual void OnREDISConnectionLost ();
+            
+        private: // Method(s) / Function(s)
+            
+            bool Watch (const std::string& a_prefix);
+            void Erase (EntriesMap::iterator a_it);
+            
+        }; // end of class 'SessionCache'
+        
+        /**
+         * @return True if cache was started, false otherwise.
+         */
+        inline bool SessionCache::Enabled () const
+        {
+            return enabled_;
+        }
+        
+        /**
+         * @return Invalidations counter, it must be read before a session is fetched and passed to \link Set \link.
+         */
+        inline uint64_t SessionCache::Generation () const
+        {
+            return generation_;
+        }
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_SESSION_CACHE_H_
@@ -23,16 +23,16 @@
 
 #include "ev/exception.h"
 
+#include "ev/redis/tracking_cache.h"
+#include "ev/redis/cluster.h"
+
 #include <algorithm> // std::find_if
 
-::ev::redis::subscriptions::Request* ev::redis::subscriptions::Manager::redis_subscription_      = nullptr;
-bool                                 ev::redis::subscriptions::Manager::redis_subscription_used_ = false;
-::ev::Bridge*                        ev::redis::subscriptions::Manager::bridge_                  = nullptr;
-int64_t                              ev::redis::subscriptions::Manager::reconnect_timeout_       = 2000;  // 2s
-bool                                 ev::redis::subscriptions::Manager::recovery_mode_           = false;
+ev::redis::subscriptions::Manager::ShardsVector ev::redis::subscriptions::Manager::shards_;
+::ev::Bridge*                                   ev::redis::subscriptions::Manager::bridge_                  = nullptr;
 
-const int64_t                        ev::redis::subscriptions::Manager::k_min_reconnect_timeout_ = 2000;  // 2s
-const int64_t                        ev::redis::subscriptions::Manager::k_max_reconnect_timeout_ = 32000; // 32s
+const int64_t                                   ev::redis::subscriptions::Manager::k_min_reconnect_timeout_ = 2000;  // 2s
+const int64_t                                   ev::redis::subscriptions::Manager::k_max_reconnect_timeout_ = 32000; // 32s
 
 /**
  * @brief One-shot initializer.
@@ -42,41 +42,55 @@ const int64_t                        ev::redis::subscriptions::Manager::k_max_re
  * @param a_channels       Set of channels to subscribe to.
  * @param a_patterns       Set of patterns to subscribe to.
  * @param a_timeout_config
+ * @param a_connections    Number of keep alive connections, channels and patterns are hashed across them by hash slot.
  */
 void ev::redis::subscriptions::Manager::Startup (const ::ev::Loggable::Data& a_loggable_data,
                                                  ev::Bridge* a_bridge,
                                                  const std::set<std::string>& a_channels, const std::set<std::string>& a_patterns,
-                                                 const EV_REDIS_SUBSCRIPTION_TIMEOUT_CONFIG& a_timeout_config)
+                                                 const EV_REDIS_SUBSCRIPTION_TIMEOUT_CONFIG& a_timeout_config,
+                                                 const size_t a_connections)
 {
     OSALITE_DEBUG_TRACE("ev_subscriptions", "~> Startup(...)");
     
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
-    if ( nullptr != redis_subscription_ ) {
+    if ( shards_.size() > 0 ) {
         throw ev::Exception("REDIS subscriptions already configured!");
     }
 
     ::ev::scheduler::Scheduler::GetInstance().Register(this);
     
-    // ... create new subscription ...
-    redis_subscription_ = new ::ev::redis::subscriptions::Request(a_loggable_data,
-                                                                  [this](::ev::scheduler::Subscription* a_subscription) {
-                                                                      ::ev::scheduler::Scheduler::GetInstance().Push(this, a_subscription);
-                                                                      if ( redis_subscription_ == a_subscription && false == redis_subscription_used_ ) {
-                                                                          redis_subscription_used_ = true;
-                                                                      }
-                                                                  },
-                                                                  std::bind(&ev::redis::subscriptions::Manager::OnREDISReplyReceived, this, std::placeholders::_1),
-                                                                  std::bind(&ev::redis::subscriptions::Manager::OnREDISDisconnected , this, std::placeholders::_1),
-                                                                  a_timeout_config
-    );
+    // ... create new subscription(s), one per keep alive connection ...
+    const size_t count = std::max(a_connections, static_cast<size_t>(1));
+    shards_.reserve(count);
+    for ( size_t idx = 0 ; idx < count ; ++idx ) {
+        ::ev::redis::subscriptions::Request* request = new ::ev::redis::subscriptions::Request(a_loggable_data,
+                                                                                              [this, idx](::ev::scheduler::Subscription* a_subscription) {
+                                                                                                  ::ev::scheduler::Scheduler::GetInstance().Push(this, a_subscription);
+                                                                                                  if ( shards_[idx].request_ == a_subscription && false == shards_[idx].used_ ) {
+                                                                                                      shards_[idx].used_ = true;
+                                                                                                  }
+                                                                                              },
+                                                                                              std::bind(&ev::redis::subscriptions::Manager::OnREDISReplyReceived, this, idx, std::placeholders::_1),
+                                                                                              std::bind(&ev::redis::subscriptions::Manager::OnREDISDisconnected , this, std::placeholders::_1),
+                                                                                              a_timeout_config
+        );
+        shards_.push_back({ request, /* used_ */ false, /* reconnect_timeout_ */ k_min_reconnect_timeout_, /* recovery_mode_ */ false });
+    }
     
     // ... keep track of shared handler ...
     bridge_ = a_bridge;
+    
+    // ... client side caching invalidations are redirected to the connection that subscribes them, its id must be known first ...
+    std::set<std::string> channels = a_channels;
+    if ( true == ::ev::redis::TrackingCache::GetInstance().Enabled() ) {
+        ShardFor(::ev::redis::TrackingCache::k_invalidate_channel_)->ClientID();
+        channels.insert(::ev::redis::TrackingCache::k_invalidate_channel_);
+    }
 
     // ... any channel(s) to subscribe to?
-    if ( a_channels.size() > 0 ) {
-        for ( auto channel : a_channels ) {
+    if ( channels.size() > 0 ) {
+        for ( auto channel : channels ) {
             default_channels_set_.insert(channel);
         }
         
@@ -101,13 +115,12 @@ void ev::redis::subscriptions::Manager::Shutdown ()
     OSALITE_DEBUG_TRACE("ev_subscriptions", "~> Shutdown()");
 
     ::ev::scheduler::Scheduler::GetInstance().Unregister(this);
-    if ( nullptr != redis_subscription_ ) {
-        if ( false == redis_subscription_used_ ) {
-            delete redis_subscription_;
+    for ( auto shard : shards_ ) {
+        if ( false == shard.used_ ) {
+            delete shard.request_;
         }
-        redis_subscription_      = nullptr;
-        redis_subscription_used_ = false;
     }
+    shards_.clear();
     
     OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ Shutdown()");
 }
@@ -161,7 +174,7 @@ void ev::redis::subscriptions::Manager::Unubscribe (ev::redis::subscriptions::Ma
     std::set<std::string> channels_to_unsubscribe;
     for ( auto it = channel_to_clients_map_.begin() ; channel_to_clients_map_.end() != it ; ++it ) {
         if ( 0 == it->second->size() ) {
-            channels_to_unsubscribe.insert(it->first);
+            channels_to_unsubscribe.insert(ids_to_names_[it->first]);
         }
     }
 
@@ -169,18 +182,20 @@ void ev::redis::subscriptions::Manager::Unubscribe (ev::redis::subscriptions::Ma
         
         Unsubscribe( { channel }, nullptr,
                     [](const std::string& a_name) -> bool {
-                        return redis_subscription_->IsSubscribedOrPending(a_name);
+                        return ShardFor(a_name)->IsSubscribedOrPending(a_name);
                     },
                     [](const std::string& a_name) -> bool {
-                        return redis_subscription_->IsUnsubscribedOrPending(a_name);
+                        return ShardFor(a_name)->IsUnsubscribedOrPending(a_name);
                     },
                     [](const std::set<std::string>& a_names) {
-                        redis_subscription_->Unsubscribe(a_names);
+                        Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                            a_request->Unsubscribe(a_shard_names);
+                        });
                     },
                     nullptr, channel_to_clients_map_
         );
 
-        const auto it = channel_to_clients_map_.find(channel);
+        const auto it = channel_to_clients_map_.find(Intern(channel));
         delete it->second;
         channel_to_clients_map_.erase(it);
         
@@ -191,7 +206,7 @@ void ev::redis::subscriptions::Manager::Unubscribe (ev::redis::subscriptions::Ma
     std::set<std::string> patterns_to_unsubscribe;
     for ( auto it = pattern_to_clients_map_.begin() ; pattern_to_clients_map_.end() != it ; ++it ) {
         if ( 0 == it->second->size() ) {
-            patterns_to_unsubscribe.insert(it->first);
+            patterns_to_unsubscribe.insert(ids_to_names_[it->first]);
         }
     }
     
@@ -199,18 +214,20 @@ void ev::redis::subscriptions::Manager::Unubscribe (ev::redis::subscriptions::Ma
         
         Unsubscribe( { pattern }, nullptr,
                     [](const std::string& a_name) -> bool {
-                        return redis_subscription_->IsPSubscribedOrPending(a_name);
+                        return ShardFor(a_name)->IsPSubscribedOrPending(a_name);
                     },
                     [](const std::string& a_name) -> bool {
-                        return redis_subscription_->IsPUnsubscribedOrPending(a_name);
+                        return ShardFor(a_name)->IsPUnsubscribedOrPending(a_name);
                     },
                     [](const std::set<std::string>& a_names) {
-                        redis_subscription_->PUnsubscribe(a_names);
+                        Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                            a_request->PUnsubscribe(a_shard_names);
+                        });
                     },
                     nullptr, pattern_to_clients_map_
         );
 
-        const auto it = pattern_to_clients_map_.find(pattern);
+        const auto it = pattern_to_clients_map_.find(Intern(pattern));
         delete it->second;
         pattern_to_clients_map_.erase(it);
         
@@ -233,10 +250,12 @@ void ev::redis::subscriptions::Manager::SubscribeChannels (const std::set<std::s
 {
     Subscribe(a_channels, a_status_callback, a_data_callback,
               [](const std::string& a_name) -> bool {
-                  return redis_subscription_->IsSubscribedOrPending(a_name);
+                  return ShardFor(a_name)->IsSubscribedOrPending(a_name);
               },
               [](const std::set<std::string>& a_names) {
-                  redis_subscription_->Subscribe(a_names);
+                  Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                      a_request->Subscribe(a_shard_names);
+                  });
               },
               a_client, channel_to_clients_map_
     );
@@ -255,13 +274,15 @@ void ev::redis::subscriptions::Manager::UnsubscribeChannels (const std::set<std:
 {
     Unsubscribe(a_channels, a_callback,
                 [](const std::string& a_name) -> bool {
-                    return redis_subscription_->IsSubscribedOrPending(a_name);
+                    return ShardFor(a_name)->IsSubscribedOrPending(a_name);
                 },
                 [](const std::string& a_name) -> bool {
-                    return redis_subscription_->IsUnsubscribedOrPending(a_name);
+                    return ShardFor(a_name)->IsUnsubscribedOrPending(a_name);
                 },
                 [](const std::set<std::string>& a_names) {
-                    redis_subscription_->Unsubscribe(a_names);
+                    Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                        a_request->Unsubscribe(a_shard_names);
+                    });
                 },
                 a_client, channel_to_clients_map_
     );
@@ -282,10 +303,12 @@ void ev::redis::subscriptions::Manager::SubscribePatterns (const std::set<std::s
 {
     Subscribe(a_patterns, a_status_callback, a_data_callback,
               [](const std::string& a_name) -> bool {
-                  return redis_subscription_->IsPSubscribedOrPending(a_name);
+                  return ShardFor(a_name)->IsPSubscribedOrPending(a_name);
               },
               [](const std::set<std::string>& a_names) {
-                  redis_subscription_->PSubscribe(a_names);
+                  Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                      a_request->PSubscribe(a_shard_names);
+                  });
               },
               a_client, pattern_to_clients_map_
     );
@@ -304,13 +327,15 @@ void ev::redis::subscriptions::Manager::UnsubscribePatterns (const std::set<std:
 {
     Unsubscribe(a_patterns, a_callback,
                 [](const std::string& a_name) -> bool {
-                    return redis_subscription_->IsPSubscribedOrPending(a_name);
+                    return ShardFor(a_name)->IsPSubscribedOrPending(a_name);
                 },
                 [](const std::string& a_name) -> bool {
-                    return redis_subscription_->IsPUnsubscribedOrPending(a_name);
+                    return ShardFor(a_name)->IsPUnsubscribedOrPending(a_name);
                 },
                 [](const std::set<std::string>& a_names) {
-                    redis_subscription_->PUnsubscribe(a_names);
+                    Dispatch(a_names, [](::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_shard_names) {
+                        a_request->PUnsubscribe(a_shard_names);
+                    });
                 },
                 a_client, pattern_to_clients_map_
     );
@@ -340,7 +365,7 @@ void ev::redis::subscriptions::Manager::Subscribe (const std::set<std::string>&
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
-    if ( nullptr == redis_subscription_ ) {
+    if ( 0 == shards_.size() ) {
         throw ev::Exception("REDIS subscriptions NOT configured!");
     }
     
@@ -351,7 +376,7 @@ void ev::redis::subscriptions::Manager::Subscribe (const std::set<std::string>&
     for ( auto name : a_names ) {
         Link(name, a_client, a_map);
         if ( true == a_is_subscribed(name) ) {
-            EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = a_status_callback(name, redis_subscription_->GetStatus(name));
+            EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = a_status_callback(name, ShardFor(name)->GetStatus(name));
             if ( nullptr != rv ) {
                 post_notify_callbacks.push_back(rv);
             }
@@ -359,7 +384,7 @@ void ev::redis::subscriptions::Manager::Subscribe (const std::set<std::string>&
             new_names.insert(name);
         }
         if ( nullptr != a_client ) {
-            a_client->callbacks_[name] = { a_status_callback, a_data_callback };
+            a_client->callbacks_[Intern(name)] = { a_status_callback, a_data_callback };
         }
     }
     
@@ -395,7 +420,7 @@ void ev::redis::subscriptions::Manager::Unsubscribe (const std::set<std::string>
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
     // ... not ready?
-    if ( nullptr == redis_subscription_ ) {
+    if ( 0 == shards_.size() ) {
         throw ev::Exception("REDIS subscriptions NOT configured!");
     }
     
@@ -418,16 +443,16 @@ void ev::redis::subscriptions::Manager::Unsubscribe (const std::set<std::string>
         } else if ( true == a_is_unsubscribed(name) ) {
             // ... notify 'in progress'?
             if ( nullptr != a_status_callback ) {
-                EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = a_status_callback(name, redis_subscription_->GetStatus(name));
+                EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = a_status_callback(name, ShardFor(name)->GetStatus(name));
                 if ( nullptr != rv ) {
                     post_notify_callbacks.push_back(rv);
                 }
             }
         } else {
             // ... one or less subscribers?
-            if ( a_map.find(name)->second->size() <= 1 ) {
+            if ( a_map.find(Intern(name))->second->size() <= 1 ) {
                 if ( nullptr != a_client ) {
-                    a_client->callbacks_[name] = { a_status_callback, nullptr };
+                    a_client->callbacks_[Intern(name)] = { a_status_callback, nullptr };
                 }
                 new_names.insert(name);
             } else {
@@ -460,6 +485,47 @@ void ev::redis::subscriptions::Manager::Unsubscribe (const std::set<std::string>
     a_unsubscribe(new_names);
 }
 
+/**
+ * @brief Intern a channel or pattern name.
+ *
+ * @param a_name
+ *
+ * @return The id assigned to the provided name.
+ */
+ev::redis::subscriptions::Manager::NameID ev::redis::subscriptions::Manager::Intern (const std::string& a_name)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    const auto it = names_to_ids_map_.find(a_name);
+    if ( names_to_ids_map_.end() != it ) {
+        return it->second;
+    }
+    
+    const ev::redis::subscriptions::Manager::NameID id = static_cast<ev::redis::subscriptions::Manager::NameID>(ids_to_names_.size());
+    ids_to_names_.push_back(a_name);
+    names_to_ids_map_[a_name] = id;
+    
+    return id;
+}
+
+/**
+ * @brief Lookup a previously interned channel or pattern name.
+ *
+ * @param a_name
+ * @param o_id
+ *
+ * @return True if the name was interned, false otherwise.
+ */
+bool ev::redis::subscriptions::Manager::Lookup (const std::string& a_name, ev::redis::subscriptions::Manager::NameID& o_id) const
+{
+    const auto it = names_to_ids_map_.find(a_name);
+    if ( names_to_ids_map_.end() == it ) {
+        return false;
+    }
+    o_id = it->second;
+    return true;
+}
+
 /**
  * @brief Link a channel or pattern name to a client and vice versa.
  *
@@ -474,12 +540,14 @@ void ev::redis::subscriptions::Manager::Link (const std::string& a_name, ev::red
     
     ev::redis::subscriptions::Manager::ClientsVector* clients_vector;
     
-    auto it = a_map.find(a_name);
+    const ev::redis::subscriptions::Manager::NameID id = Intern(a_name);
+    
+    auto it = a_map.find(id);
     if ( a_map.end() != it ) {
         clients_vector = it->second;
     } else {
         clients_vector = new ev::redis::subscriptions::Manager::ClientsVector();
-        a_map[a_name] = clients_vector;
+        a_map[id] = clients_vector;
     }
     
     if ( clients_vector->end() == std::find(clients_vector->begin(), clients_vector->end(), a_client) ) {
@@ -500,7 +568,13 @@ void ev::redis::subscriptions::Manager::Unlink (const std::string& a_name,
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
-    auto it = a_map.find(a_name);
+    ev::redis::subscriptions::Manager::NameID id;
+    if ( false == Lookup(a_name, id) ) {
+        // ... nothing to do ...
+        return;
+    }
+    
+    auto it = a_map.find(id);
     if ( a_map.end() == it ) {
         // ... nothing to do ...
         return;
@@ -527,7 +601,12 @@ void ev::redis::subscriptions::Manager::Notify (const std::string& a_name,
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
     // ... still tracking channel or pattern?
-    auto it = a_map.find(a_name);
+    ev::redis::subscriptions::Manager::NameID id;
+    if ( false == Lookup(a_name, id) ) {
+        // ... no ...
+        return;
+    }
+    auto it = a_map.find(id);
     if ( a_map.end() == it ) {
         // ... no ...
         return;
@@ -536,7 +615,7 @@ void ev::redis::subscriptions::Manager::Notify (const std::string& a_name,
     // ... notify all clients ...
     for ( auto client : *it->second ) {
         if ( nullptr != client ) {
-            auto callbacks_it = client->callbacks_.find(a_name);
+            auto callbacks_it = client->callbacks_.find(id);
             if ( not ( client->callbacks_.end() == callbacks_it || nullptr == callbacks_it->second.status_ ) ) {
                 EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = callbacks_it->second.status_(a_name, a_status);
                 if ( nullptr != rv ) {
@@ -557,18 +636,22 @@ void ev::redis::subscriptions::Manager::Notify (const std::string& a_name,
 /**
  * @brief Notify all clients that are linked to a specific channel or pattern about a received message.
  *
- * @param a_key
- * @param a_name
- * @param a_message
+ * @param a_key     Channel or pattern name.
+ * @param a_message Shared message, clients keep a reference instead of a copy.
  * @param a_map
  */
-void ev::redis::subscriptions::Manager::Notify (const std::string& a_key , const std::string& a_name, const std::string& a_message,
+void ev::redis::subscriptions::Manager::Notify (const std::string& a_key, const ev::redis::subscriptions::MessagePtr& a_message,
                                                 ev::redis::subscriptions::Manager::SubscriptionsToClientMap& a_map)
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
 
     // ... still tracking channel or pattern?
-    auto it = a_map.find(a_key);
+    ev::redis::subscriptions::Manager::NameID id;
+    if ( false == Lookup(a_key, id) ) {
+        // ... no ...
+        return;
+    }
+    auto it = a_map.find(id);
     if ( a_map.end() == it ) {
         // ... no ...
         return;
@@ -579,11 +662,11 @@ void ev::redis::subscriptions::Manager::Notify (const std::string& a_key , const
         if ( nullptr == client ) {
             continue;
         }
-        auto callbacks_it = client->callbacks_.find(a_key);
+        auto callbacks_it = client->callbacks_.find(id);
         if ( client->callbacks_.end() == callbacks_it || nullptr == callbacks_it->second.data_ ) {
             continue;
         }
-        EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = callbacks_it->second.data_(a_name, a_message);
+        EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK rv = callbacks_it->second.data_(a_message->channel(), a_message);
         if ( nullptr != rv ) {
             post_notify_callbacks.push_back(rv);
         }
@@ -601,9 +684,10 @@ void ev::redis::subscriptions::Manager::Notify (const std::string& a_key , const
 /**
  * @brief This method will be called when a redis reply was received.
  *
+ * @param a_shard Index of the shard that received the reply.
  * @param a_reply The reply for a redis pub/sub command.
  */
-void ev::redis::subscriptions::Manager::OnREDISReplyReceived (const ::ev::redis::subscriptions::Reply* a_reply)
+void ev::redis::subscriptions::Manager::OnREDISReplyReceived (const size_t a_shard, const ::ev::redis::subscriptions::Reply* a_reply)
 {
     OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
@@ -631,32 +715,55 @@ void ev::redis::subscriptions::Manager::OnREDISReplyReceived (const ::ev::redis:
             break;
         case ::ev::redis::subscriptions::Reply::Kind::Message:
         {
-            if ( a_reply->Pattern().length() > 0 ) {
+            if ( 0 == a_reply->Pattern().length() && 0 == strcmp(a_reply->Channel().c_str(), ::ev::redis::TrackingCache::k_invalidate_channel_) ) {
+                OSALITE_DEBUG_TRACE("ev_subscriptions","[%s] invalidate", a_reply->Channel().c_str());
+                ::ev::redis::TrackingCache::GetInstance().Invalidate(a_reply->value());
+            } else if ( nullptr == a_reply->message() ) {
+                // ... only string payloads are delivered to clients ...
+                OSALITE_DEBUG_TRACE("ev_subscriptions","[%s] non-string payload ignored", a_reply->Channel().c_str());
+            } else if ( a_reply->Pattern().length() > 0 ) {
                 OSALITE_DEBUG_TRACE("ev_subscriptions","[%s] %s says %s",
-                                    a_reply->Pattern().c_str(), a_reply->Channel().c_str(), a_reply->value().String().c_str());
-                Notify(a_reply->Pattern(), a_reply->Channel(), a_reply->value().String(), pattern_to_clients_map_);
+                                    a_reply->Pattern().c_str(), a_reply->Channel().c_str(), a_reply->message()->payload().c_str());
+                Notify(a_reply->Pattern(), a_reply->message(), pattern_to_clients_map_);
             } else {
                 OSALITE_DEBUG_TRACE("ev_subscriptions","[%s] %s says %s",
-                                    a_reply->Channel().c_str(), a_reply->Channel().c_str(), a_reply->value().String().c_str());
-                Notify(a_reply->Channel(), a_reply->Channel(), a_reply->value().String(), channel_to_clients_map_);
+                                    a_reply->Channel().c_str(), a_reply->Channel().c_str(), a_reply->message()->payload().c_str());
+                Notify(a_reply->Channel(), a_reply->message(), channel_to_clients_map_);
             }
         }
             break;
         case ::ev::redis::subscriptions::Reply::Kind::Status:
         {
-            if ( 0 == strcasecmp (a_reply->value().String().c_str(), "PONG") ) {
+            if ( true == a_reply->value().IsInteger() ) {
+                // ... 'CLIENT ID' reply ...
+                OSALITE_DEBUG_TRACE("ev_subscriptions","client id %lld", a_reply->value().Integer());
+                ::ev::redis::TrackingCache::GetInstance().SetRedirectID(a_reply->value().Integer());
+            } else if ( 0 == strcasecmp (a_reply->value().String().c_str(), "PONG") ) {
                 // ... from a connection recovery process ?
-                if ( true == recovery_mode_ ) {
-                    // ... first subscribe channels ...
-                    if ( channel_to_clients_map_.size() > 0 ) {
-                        std::set<std::string> channels_set;
-                        for ( auto it : channel_to_clients_map_ ) {
-                            channels_set.insert(it.first);
+                if ( a_shard < shards_.size() && true == shards_[a_shard].recovery_mode_ ) {
+                    ev::redis::subscriptions::Manager::Shard& shard = shards_[a_shard];
+                    // ... first subscribe channels, only those hashed to this shard, batched by request ...
+                    std::set<std::string> channels_set;
+                    for ( auto it : channel_to_clients_map_ ) {
+                        if ( a_shard == ShardOf(ids_to_names_[it.first]) ) {
+                            channels_set.insert(ids_to_names_[it.first]);
+                        }
+                    }
+                    if ( channels_set.size() > 0 ) {
+                        shard.request_->Subscribe(channels_set);
+                    }
+                    // ... then patterns ...
+                    std::set<std::string> patterns_set;
+                    for ( auto it : pattern_to_clients_map_ ) {
+                        if ( a_shard == ShardOf(ids_to_names_[it.first]) ) {
+                            patterns_set.insert(ids_to_names_[it.first]);
                         }
-                        redis_subscription_->Subscribe(channels_set);
                     }
-                    recovery_mode_     = false;
-                    reconnect_timeout_ = k_min_reconnect_timeout_;
+                    if ( patterns_set.size() > 0 ) {
+                        shard.request_->PSubscribe(patterns_set);
+                    }
+                    shard.recovery_mode_     = false;
+                    shard.reconnect_timeout_ = k_min_reconnect_timeout_;
                 }
             }
             break;
@@ -677,28 +784,49 @@ void ev::redis::subscriptions::Manager::OnREDISReplyReceived (const ::ev::redis:
  */
 bool ev::redis::subscriptions::Manager::OnREDISDisconnected (::ev::redis::subscriptions::Request* a_request)
 {
-    // ...
-    if ( a_request != redis_subscription_ || nullptr == redis_subscription_ ) {
+    // ... pick shard ...
+    const auto shard_it = std::find_if(shards_.begin(), shards_.end(), [a_request](const ev::redis::subscriptions::Manager::Shard& a_shard) {
+        return ( a_shard.request_ == a_request );
+    });
+    if ( nullptr == a_request || shards_.end() == shard_it ) {
         return false;
     }
     
-    recovery_mode_ = true;
+    const size_t idx = static_cast<size_t>(shard_it - shards_.begin());
+    
+    shard_it->recovery_mode_ = true;
     
-    OSALITE_DEBUG_TRACE("ev_subscriptions", "~> REDIS Disconnected...");
+    OSALITE_DEBUG_TRACE("ev_subscriptions", "~> REDIS Disconnected [" SIZET_FMT "]...", idx);
     
-    bridge_->CallOnMainThread([this]() {
+    bridge_->CallOnMainThread([this, idx, a_request]() {
         
         OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
 
-        OSALITE_DEBUG_TRACE("ev_subscriptions", "~> REDIS Disconnected @ MT...");
+        OSALITE_DEBUG_TRACE("ev_subscriptions", "~> REDIS Disconnected [" SIZET_FMT "] @ MT...", idx);
+        
+        // ... shutdown in progress?
+        if ( idx >= shards_.size() || a_request != shards_[idx].request_ ) {
+            return;
+        }
+        
+        ev::redis::subscriptions::Manager::Shard& shard = shards_[idx];
+        
+        // ... invalidations might have been missed and tracking redirection is lost ...
+        const bool tracking = ( true == ::ev::redis::TrackingCache::GetInstance().Enabled() && idx == ShardOf(::ev::redis::TrackingCache::k_invalidate_channel_) );
+        if ( true == tracking ) {
+            ::ev::redis::TrackingCache::GetInstance().SetRedirectID(-1);
+        }
 
-        if ( reconnect_timeout_ >= k_max_reconnect_timeout_ ) {
+        if ( shard.reconnect_timeout_ >= k_max_reconnect_timeout_ ) {
             
             // ... for all maps ...
             std::set<ev::redis::subscriptions::Manager::Client*> clients_to_disconnect;
             for ( auto map : { &channel_to_clients_map_, &pattern_to_clients_map_ } ) {
-                // ... for all names in map ...
+                // ... for all names in map, hashed to this shard ...
                 for ( auto it = map->begin() ; map->end() != it ; ++it ) {
+                    if ( idx != ShardOf(ids_to_names_[it->first]) ) {
+                        continue;
+                    }
                     // ... for all clients ...
                     for ( auto client : *it->second ) {
                         clients_to_disconnect.insert(client);
@@ -712,28 +840,76 @@ bool ev::redis::subscriptions::Manager::OnREDISDisconnected (::ev::redis::subscr
             }
             clients_to_disconnect.clear();
             
-            reconnect_timeout_ = k_min_reconnect_timeout_;
+            shard.reconnect_timeout_ = k_min_reconnect_timeout_;
 
             OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ REDIS Disconnected: disconnect client(s) order issued...");
 
         } else {
             // ...retry ...
             try {
-                OSALITE_DEBUG_TRACE("ev_subscriptions", INT64_FMT " sending control...", reconnect_timeout_);
-                if ( false == redis_subscription_->Ping() ) {
+                OSALITE_DEBUG_TRACE("ev_subscriptions", INT64_FMT " sending control...", shard.reconnect_timeout_);
+                if ( true == tracking ) {
+                    (void) shard.request_->ClientID();
+                }
+                if ( false == shard.request_->Ping() ) {
                     throw ev::Exception("Unable to send a connection control ping to REDIS server!");
                 }
-                OSALITE_DEBUG_TRACE("ev_subscriptions", INT64_FMT " control ping send...", reconnect_timeout_);
+                OSALITE_DEBUG_TRACE("ev_subscriptions", INT64_FMT " control ping send...", shard.reconnect_timeout_);
             } catch (ev::Exception& a_ev_exception) {
                 bridge_->ThrowFatalException(a_ev_exception);
             }
 
-            OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ REDIS Disconnected: timeout in " INT64_FMT, reconnect_timeout_);
+            OSALITE_DEBUG_TRACE("ev_subscriptions", "<~ REDIS Disconnected: timeout in " INT64_FMT, shard.reconnect_timeout_);
 
-            reconnect_timeout_ *= 2;
+            shard.reconnect_timeout_ *= 2;
         }
         
-    }, reconnect_timeout_);
+    }, shard_it->reconnect_timeout_);
     
     return true;
 }
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Pick the shard a channel or pattern is hashed to.
+ *
+ * @param a_name Channel or pattern name, '{...}' hash tags are honored.
+ *
+ * @return Shard index.
+ */
+size_t ev::redis::subscriptions::Manager::ShardOf (const std::string& a_name)
+{
+    return static_cast<size_t>(::ev::redis::Cluster::Slot(a_name.c_str(), a_name.length())) % shards_.size();
+}
+
+/**
+ * @brief Pick the subscription request a channel or pattern is hashed to.
+ *
+ * @param a_name Channel or pattern name.
+ *
+ * @return Subscription request.
+ */
+::ev::redis::subscriptions::Request* ev::redis::subscriptions::Manager::ShardFor (const std::string& a_name)
+{
+    return shards_[ShardOf(a_name)].request_;
+}
+
+/**
+ * @brief Group channels or patterns by shard and perform a command for each shard.
+ *
+ * @param a_names
+ * @param a_callback Function to call with each shard request and it's channels or patterns.
+ */
+void ev::redis::subscriptions::Manager::Dispatch (const std::set<std::string>& a_names, const EV_REDIS_SUBSCRIPTIONS_DISPATCH_CALLBACK& a_callback)
+{
+    std::map<size_t, std::set<std::string>> names;
+    for ( auto name : a_names ) {
+        names[ShardOf(name)].insert(name);
+    }
+    for ( auto it : names ) {
+        a_callback(shards_[it.first].request_, it.second);
+    }
+}
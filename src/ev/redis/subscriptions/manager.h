@@ -27,11 +27,13 @@
 #include "ev/scheduler/scheduler.h"
 
 #include "ev/redis/subscriptions/request.h"
+#include "ev/redis/subscriptions/message.h"
 
 #include <string>
 #include <set>
 #include <vector>
 #include <map>
+#include <unordered_map> // std::unordered_map
 
 namespace ev
 {
@@ -48,6 +50,7 @@ namespace ev
             public: // Data Type(s)
                 
                 typedef ::ev::redis::subscriptions::Request::Status Status;
+                typedef uint32_t                                    NameID;  //!< Interned channel or pattern name.
 
 #ifndef EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK
     #define EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK std::function<void()>
@@ -59,7 +62,7 @@ namespace ev
 #endif
     
 #ifndef EV_REDIS_SUBSCRIPTIONS_DATA_CALLBACK
-    #define EV_REDIS_SUBSCRIPTIONS_DATA_CALLBACK std::function<EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK (const std::string& a_name, const std::string& a_message)>
+    #define EV_REDIS_SUBSCRIPTIONS_DATA_CALLBACK std::function<EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK (const std::string& a_name, const ::ev::redis::subscriptions::MessagePtr& a_message)>
 #endif
                 
                 class Client
@@ -75,7 +78,7 @@ namespace ev
                         EV_REDIS_SUBSCRIPTIONS_DATA_CALLBACK   data_;
                     } Callbacks;
                     
-                    typedef std::map<std::string, Callbacks> CallbacksMap;
+                    typedef std::unordered_map<NameID, Callbacks> CallbacksMap;
                     
                 private: // Data
                     
@@ -105,14 +108,27 @@ namespace ev
 #ifndef EV_REDIS_SUBSCRIPTIONS_PERFORM_CALLBACK
 #define EV_REDIS_SUBSCRIPTIONS_PERFORM_CALLBACK std::function<void(const std::set<std::string>& a_names)>
 #endif
+#ifndef EV_REDIS_SUBSCRIPTIONS_DISPATCH_CALLBACK
+#define EV_REDIS_SUBSCRIPTIONS_DISPATCH_CALLBACK std::function<void(::ev::redis::subscriptions::Request* a_request, const std::set<std::string>& a_names)>
+#endif
+                
+                /**
+                 * @brief A keep alive connection, subscriptions are hashed across shards.
+                 */
+                typedef struct _Shard
+                {
+                    ::ev::redis::subscriptions::Request* request_;           //!< Subscription request, owns a keep alive connection.
+                    bool                                 used_;              //!< True when request ownership was moved to the scheduler.
+                    int64_t                              reconnect_timeout_; //!< Next reconnect attempt delay.
+                    bool                                 recovery_mode_;     //!< True while recovering from a disconnection.
+                } Shard;
+                
+                typedef std::vector<Shard> ShardsVector;
                 
             private: // Static Data
                 
-                static ::ev::redis::subscriptions::Request*   redis_subscription_;
-                static bool                                   redis_subscription_used_;
+                static ShardsVector                           shards_;
                 static ::ev::Bridge*                          bridge_;
-                static int64_t                                reconnect_timeout_;
-                static bool                                   recovery_mode_;
                 
             private: // Static Const Data
                 
@@ -121,10 +137,12 @@ namespace ev
                 
             private: // Data Type(s)
                 
-                typedef std::set<std::string>                 ChannelsSet;
-                typedef std::set<std::string>                 PatternsSet;
-                typedef std::vector<Client*>                  ClientsVector;
-                typedef std::map<std::string, ClientsVector*> SubscriptionsToClientMap;
+                typedef std::set<std::string>                      ChannelsSet;
+                typedef std::set<std::string>                      PatternsSet;
+                typedef std::vector<Client*>                       ClientsVector;
+                typedef std::unordered_map<NameID, ClientsVector*> SubscriptionsToClientMap;
+                typedef std::unordered_map<std::string, NameID>    NamesToIDsMap;
+                typedef std::vector<std::string>                   IDsToNamesVector;
                 
             private: // Data
                 
@@ -132,13 +150,16 @@ namespace ev
                 PatternsSet              default_patterns_set_;
                 SubscriptionsToClientMap channel_to_clients_map_;
                 SubscriptionsToClientMap pattern_to_clients_map_;
+                NamesToIDsMap            names_to_ids_map_;       //!< Interned channel and pattern names, ids are never recycled.
+                IDsToNamesVector         ids_to_names_;           //!< Channel and pattern names, indexed by id.
                 
             public: // Method(s) / Function(s)
                 
                 void Startup  (const ::ev::Loggable::Data& a_loggable_data,
                                ev::Bridge* a_bridge,
                                const std::set<std::string>& a_channels, const std::set<std::string>& a_patterns,
-                               const EV_REDIS_SUBSCRIPTION_TIMEOUT_CONFIG& a_timeout_config);
+                               const EV_REDIS_SUBSCRIPTION_TIMEOUT_CONFIG& a_timeout_config,
+                               const size_t a_connections = 1);
                 void Shutdown ();
                 
             public: // Method(s) / Function(s)
@@ -180,16 +201,24 @@ namespace ev
                                   Client* a_client,
                                   SubscriptionsToClientMap& a_map);
                 
-                void Link       (const std::string& a_name, Client* a_client, SubscriptionsToClientMap& a_map);
-                void Unlink     (const std::string& a_name, Client* a_client, SubscriptionsToClientMap& a_map);
-                void Notify     (const std::string& a_name, const Status& a_status, SubscriptionsToClientMap& a_map);
-                void Notify     (const std::string& a_key,  const std::string& a_name, const std::string& a_message, SubscriptionsToClientMap& a_map);
+                NameID Intern   (const std::string& a_name);
+                bool   Lookup   (const std::string& a_name, NameID& o_id) const;
+                void   Link     (const std::string& a_name, Client* a_client, SubscriptionsToClientMap& a_map);
+                void   Unlink   (const std::string& a_name, Client* a_client, SubscriptionsToClientMap& a_map);
+                void   Notify   (const std::string& a_name, const Status& a_status, SubscriptionsToClientMap& a_map);
+                void   Notify   (const std::string& a_key,  const MessagePtr& a_message, SubscriptionsToClientMap& a_map);
                 
             private: // Method(s) / Function(s)
                 
-                void OnREDISReplyReceived (const ::ev::redis::subscriptions::Reply* a_reply);
+                void OnREDISReplyReceived (const size_t a_shard, const ::ev::redis::subscriptions::Reply* a_reply);
                 bool OnREDISDisconnected  (::ev::redis::subscriptions::Request* a_request);
                 
+            private: // Static Method(s) / Function(s)
+                
+                static size_t                                ShardOf  (const std::string& a_name);
+                static ::ev::redis::subscriptions::Request* ShardFor (const std::string& a_name);
+                static void                                  Dispatch (const std::set<std::string>& a_names, const EV_REDIS_SUBSCRIPTIONS_DISPATCH_CALLBACK& a_callback);
+                
             }; // end of class 'Manager'
             
         } // end of namespace 'subscriptions'
@@ -0,0 +1,107 @@
+/**
+ * @file message.h - REDIS
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_SUBSCRIPTIONS_MESSAGE_H_
+#define NRS_EV_REDIS_SUBSCRIPTIONS_MESSAGE_H_
+
+#include <string>  // std::string
+#include <memory>  // std::shared_ptr
+#include <utility> // std::move
+
+namespace ev
+{
+
+    namespace redis
+    {
+        
+        namespace subscriptions
+        {
+            
+            /**
+             * @brief An immutable message received from a REDIS channel or pattern subscription.
+             *
+             * @remarks Decoded once per reply and shared, by reference count, with all subscribers.
+             */
+            class Message final
+            {
+                
+            private: // Const Data
+                
+                const std::string channel_; //!< Originating channel.
+                const std::string pattern_; //!< Matching pattern, empty if delivered by a channel subscription.
+                const std::string payload_; //!< Message payload.
+                
+            public: // Constructor(s) / Destructor
+                
+                /**
+                 * @brief Default constructor.
+                 *
+                 * @param a_channel
+                 * @param a_pattern
+                 * @param a_payload
+                 */
+                Message (std::string&& a_channel, std::string&& a_pattern, std::string&& a_payload)
+                    : channel_(std::move(a_channel)), pattern_(std::move(a_pattern)), payload_(std::move(a_payload))
+                {
+                    /* empty */
+                }
+                
+            public: // Inline Method(s) / Function(s)
+                
+                const std::string& channel () const;
+                const std::string& pattern () const;
+                const std::string& payload () const;
+                
+            }; // end of class 'Message'
+            
+            typedef std::shared_ptr<const Message> MessagePtr;
+            
+            /**
+             * @return Originating channel.
+             */
+            inline const std::string& Message::channel () const
+            {
+                return channel_;
+            }
+            
+            /**
+             * @return Matching pattern, empty if delivered by a channel subscription.
+             */
+            inline const std::string& Message::pattern () const
+            {
+                return pattern_;
+            }
+            
+            /**
+             * @return Message payload.
+             */
+            inline const std::string& Message::payload () const
+            {
+                return payload_;
+            }
+            
+        } // end of namespace 'subscriptions'
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_SUBSCRIPTIONS_MESSAGE_H_
@@ -136,16 +136,24 @@ ev::redis::subscriptions::Reply::Reply (const ev::Loggable::Data& a_loggable_dat
                 // third element in reply  : is the actual message payload ...
                 //
                 const struct redisReply* payload = a_reply->element[2];
-                validate(payload, REDIS_REPLY_STRING);
                 kind_    = ev::redis::subscriptions::Reply::Kind::Message;
-                value_   = payload->len > 0 ? std::string(payload->str, payload->len) : "";
-                channel_ = channel_or_pattern->len > 0 ? std::string(channel_or_pattern->str, channel_or_pattern->len) : "";
+                // ... client side caching invalidations are delivered as an array of keys, or nil when all keys must be dropped ...
+                if ( nullptr != payload && ( REDIS_REPLY_ARRAY == payload->type || REDIS_REPLY_NIL == payload->type ) ) {
+                    channel_ = channel_or_pattern->len > 0 ? std::string(channel_or_pattern->str, channel_or_pattern->len) : "";
+                    value_   = payload;
+                } else {
+                    validate(payload, REDIS_REPLY_STRING);
+                    // ... decoded once, shared by all subscribers ...
+                    message_ = std::make_shared<const ev::redis::subscriptions::Message>(std::string(channel_or_pattern->str, channel_or_pattern->len),
+                                                                                         std::string(),
+                                                                                         std::string(payload->str, payload->len));
+                }
                 // ... for debug proposes only ...
                 ev::Logger::GetInstance().Log("redis_trace_extended", loggable_data_,
                                               "[%-30s] : a_reply = %p - 'message': %s",
                                               __FUNCTION__,
                                               a_reply,
-                                              value_.String().c_str()
+                                              nullptr != message_ ? message_->payload().c_str() : value_.String().c_str()
                 );
             } else if ( 0 == strcasecmp(kind_str.c_str(), "pmessage") ) {
                 //
@@ -167,16 +175,17 @@ ev::redis::subscriptions::Reply::Reply (const ev::Loggable::Data& a_loggable_dat
                 validate(payload, REDIS_REPLY_STRING);
                 
                 kind_    = ev::redis::subscriptions::Reply::Kind::Message;
-                value_   = payload->len > 0 ? std::string(payload->str, payload->len) : "";
-                pattern_ = channel_or_pattern->len > 0 ? std::string(channel_or_pattern->str, channel_or_pattern->len) : "";
-                channel_ = originating_channel->len > 0 ? std::string(originating_channel->str, originating_channel->len) : "";
+                // ... decoded once, shared by all subscribers ...
+                message_ = std::make_shared<const ev::redis::subscriptions::Message>(std::string(originating_channel->str, originating_channel->len),
+                                                                                     std::string(channel_or_pattern->str, channel_or_pattern->len),
+                                                                                     std::string(payload->str, payload->len));
                 
                 // ... for debug proposes only ...
                 ev::Logger::GetInstance().Log("redis_trace_extended", loggable_data_,
                                               "[%-30s] : a_reply = %p - 'pmessage' %s",
                                               __FUNCTION__,
                                               a_reply,
-                                              value_.String().c_str()
+                                              message_->payload().c_str()
                );
                 
             } else {
@@ -218,6 +227,20 @@ ev::redis::subscriptions::Reply::Reply (const ev::Loggable::Data& a_loggable_dat
             break;
         }
             
+        case REDIS_REPLY_INTEGER: // 3
+        {
+            // ... e.g. 'CLIENT ID' ...
+            kind_  = ev::redis::subscriptions::Reply::Kind::Status;
+            value_ = a_reply->integer;
+            // ... for debug proposes only ...
+            ev::Logger::GetInstance().Log("redis_trace_extended", loggable_data_,
+                                          "[%-30s] : a_reply = %p - 'integer': %lld",
+                                          __FUNCTION__,
+                                          a_reply, a_reply->integer
+            );
+            break;
+        }
+            
         default:
         {
             // ... for debug proposes only ...
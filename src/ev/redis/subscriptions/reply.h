@@ -28,6 +28,7 @@
 #include "ev/loggable.h"
 
 #include "ev/redis/reply.h"
+#include "ev/redis/subscriptions/message.h"
 
 namespace ev
 {
@@ -65,6 +66,7 @@ namespace ev
                 std::string channel_;
                 std::string pattern_;
                 size_t      number_of_subscribed_channels_;
+                MessagePtr  message_;                       //!< Decoded 'message' or 'pmessage' with a string payload, nullptr if none.
                                 
             public: // Constructor(s) / Destructor
                 
@@ -76,6 +78,7 @@ namespace ev
                 const Kind         kind    () const;
                 const std::string& Channel () const;
                 const std::string& Pattern () const;
+                const MessagePtr&  message () const;
                 
             }; // end of class 'Reply'
             
@@ -92,7 +95,7 @@ namespace ev
              */
             inline const std::string& Reply::Channel () const
             {
-                return channel_;
+                return ( nullptr != message_ ? message_->channel() : channel_ );
             }
             
             /**
@@ -100,7 +103,15 @@ namespace ev
              */
             inline const std::string& Reply::Pattern () const
             {
-                return pattern_;
+                return ( nullptr != message_ ? message_->pattern() : pattern_ );
+            }
+            
+            /**
+             * @brief Shared message, nullptr if this reply is not a 'message' or 'pmessage' with a string payload.
+             */
+            inline const MessagePtr& Reply::message () const
+            {
+                return message_;
             }
 
         }; // end of namespace 'subscriptions'
@@ -32,6 +32,8 @@
 
 #include <signal.h>
 
+const size_t ev::redis::subscriptions::Request::k_max_names_per_command_ = 64;
+
 #ifdef __APPLE__
 #pragma mark -
 #endif
@@ -56,6 +58,7 @@ ev::redis::subscriptions::Request::Request (const ::ev::Loggable::Data& a_loggab
     request_ptr_         = nullptr;
     pending_context_ptr_ = nullptr;
     ping_context_        = nullptr;
+    client_id_context_   = nullptr;
 }
 
 /**
@@ -66,15 +69,11 @@ ev::redis::subscriptions::Request::~Request ()
     if ( nullptr != ping_context_ ) {
         delete ping_context_;
     }
+    if ( nullptr != client_id_context_ ) {
+        delete client_id_context_;
+    }
     for ( auto map : { &patterns_, &channels_ } ) {
-        for ( auto it : *map ) {
-            if ( nullptr != it.second ) {
-                for ( auto v_it : *it.second ) {
-                    delete v_it;
-                }
-                delete it.second;
-            }
-        }
+        Release(*map);
     }
 }
 
@@ -344,6 +343,11 @@ void ev::redis::subscriptions::Request::Publish (std::vector<ev::Result *>& a_re
                 
                 // ... if this is the reply for a pending context ...
                 if ( pending_context_ptr_ == context_ptr ) {
+                    // ... batched commands get one reply per channel or pattern ...
+                    if ( context_ptr->replies_ > 1 ) {
+                        context_ptr->replies_--;
+                        break;
+                    }
                     // ...
                     if ( true == release_context ) {
                         delete context_ptr;
@@ -371,14 +375,18 @@ void ev::redis::subscriptions::Request::Publish (std::vector<ev::Result *>& a_re
             }
             case ev::redis::subscriptions::Reply::Kind::Message:
             {
-                // ... message ...
-                const ev::redis::Value& message = reply->value();
-                notify = ( true == message.IsString() && message.String().length() > 0 );
+                // ... message, shared as is with subscribers ...
+                const ev::redis::subscriptions::MessagePtr& message = reply->message();
+                if ( nullptr != message ) {
+                    notify = ( message->payload().length() > 0 );
+                } else {
+                    notify = ( true == reply->value().IsArray() || true == reply->value().IsNil() );
+                }
                 // ... for debug proposes only ...
                 ev::Logger::GetInstance().Log("redis_trace", loggable_data_,
                                               "[%-30s] : \t [MESSAGE] => %s",
                                               __FUNCTION__,
-                                              message.String().c_str()
+                                              nullptr != message ? message->payload().c_str() : reply->value().String().c_str()
                 );
                 break;
             }
@@ -388,7 +396,7 @@ void ev::redis::subscriptions::Request::Publish (std::vector<ev::Result *>& a_re
                 ev::Logger::GetInstance().Log("redis_trace", loggable_data_,
                                               "[%-30s] : \t [STATUS ] => %s",
                                               __FUNCTION__,
-                                              ( pending_context_ptr_ == ping_context_ ? "PING" : "-" )
+                                              ( pending_context_ptr_ == ping_context_ ? "PING" : pending_context_ptr_ == client_id_context_ ? "CLIENT ID" : "-" )
                 );
                 // ... ping  status ? ...
                 if ( pending_context_ptr_ == ping_context_ ) {
@@ -404,6 +412,19 @@ void ev::redis::subscriptions::Request::Publish (std::vector<ev::Result *>& a_re
                     );
                     // ...and reset pending context ...
                     pending_context_ptr_ = nullptr;
+                } else if ( pending_context_ptr_ == client_id_context_ && nullptr != client_id_context_ ) {
+                    // ... notify ...
+                    notify = true;
+                    // ... forget it  ...
+                    delete client_id_context_;
+                    client_id_context_ = nullptr;
+                    // ... for debug proposes only ...
+                    ev::Logger::GetInstance().Log("redis_trace", loggable_data_,
+                                                  "[%-30s] ::: INFO ::: CLIENT ID REPLY ::: INFO :::",
+                                                  __FUNCTION__
+                    );
+                    // ...and reset pending context ...
+                    pending_context_ptr_ = nullptr;
                 }
                 break;
             }
@@ -488,18 +509,15 @@ bool ev::redis::subscriptions::Request::Disconnected ()
         delete ping_context_;
         ping_context_ = nullptr;
     }
+    
+    if ( nullptr != client_id_context_ ) {
+        delete client_id_context_;
+        client_id_context_ = nullptr;
+    }
 
     // ... all channels or patterns must be subscribed again ...
     for ( auto map : { &patterns_, &channels_ } ) {
-        for ( auto it : *map ) {
-            if ( nullptr != it.second ) {
-                for ( auto v_it : *it.second ) {
-                    delete v_it;
-                }
-                delete it.second;
-            }
-        }
-        map->clear();
+        Release(*map);
     }
     
     // ... notify owner?
@@ -670,6 +688,37 @@ bool ev::redis::subscriptions::Request::Ping ()
     return true;
 }
 
+/**
+ * @brief Schedule a 'CLIENT ID' request, it must be the first command sent on a new connection.
+ *
+ * @return True if it's a new schedule, false when it's already scheduled.
+ */
+bool ev::redis::subscriptions::Request::ClientID ()
+{
+    // ... already scheduled ...
+    if ( nullptr != client_id_context_ ) {
+        return false;
+    }
+    
+    client_id_context_ = new ev::redis::subscriptions::Request::Context();
+    client_id_context_->command_ = "CLIENT";
+    client_id_context_->args_    = { "ID" };
+    client_id_context_->status_  = ev::redis::subscriptions::Request::Status::NotSet;
+    pending_.push_back(client_id_context_);
+    
+    // ... commit this command ...
+    commit_callback_(this);
+    
+    // ... for debug proposes only ...
+    ev::Logger::GetInstance().Log("redis_trace", loggable_data_,
+                                  "[%-30s] ::: INFO ::: CLIENT ID SCHEDULED ::: INFO :::",
+                                  __FUNCTION__
+    );
+    
+    // ... we're none ...
+    return true;
+}
+
 #ifdef __APPLE__
 #pragma mark -
 #endif
@@ -815,13 +864,20 @@ void ev::redis::subscriptions::Request::BuildAndTrackCommand (const char* const
 
     LogStatus("\t", 1);
     
-    // ... build and track command ...
+    // ... build and track command(s), up to k_max_names_per_command_ channels or patterns per command ...
+    ev::redis::subscriptions::Request::Context* context = nullptr;
     for ( auto channel_or_pattern_name : a_names ) {
         
-        ev::redis::subscriptions::Request::Context* context = new ev::redis::subscriptions::Request::Context();
-        context->command_ = a_name;
-        context->args_ = {channel_or_pattern_name};
-        context->status_ = a_status;
+        if ( nullptr == context || context->args_.size() >= k_max_names_per_command_ ) {
+            context = new ev::redis::subscriptions::Request::Context();
+            context->command_ = a_name;
+            context->status_  = a_status;
+            context->replies_ = 0;
+            // ... add it to pending stack ...
+            pending_.push_back(context);
+        }
+        context->args_.push_back(channel_or_pattern_name);
+        context->replies_++;
 
         // ... keep track of context ...
         auto it = a_map.find(channel_or_pattern_name);
@@ -841,8 +897,6 @@ void ev::redis::subscriptions::Request::BuildAndTrackCommand (const char* const
                                       channel_or_pattern_name.c_str()
         );
         
-        // ... add it to pending stack ...
-        pending_.push_back(context);
         // ... update status map, only if it's not set yet ...
         a_status_map[channel_or_pattern_name] = a_status;
     }
@@ -948,6 +1002,28 @@ void ev::redis::subscriptions::Request::CleanUpUnsubscribed ()
     }
 }
 
+/**
+ * @brief Release all contexts of a map, a batched context is tracked by more than one channel or pattern.
+ *
+ * @param a_map
+ */
+void ev::redis::subscriptions::Request::Release (ev::redis::subscriptions::Request::ContextMap& a_map)
+{
+    std::set<ev::redis::subscriptions::Request::Context*> contexts;
+    for ( auto it : a_map ) {
+        if ( nullptr != it.second ) {
+            for ( auto v_it : *it.second ) {
+                contexts.insert(v_it);
+            }
+            delete it.second;
+        }
+    }
+    a_map.clear();
+    for ( auto context : contexts ) {
+        delete context;
+    }
+}
+
 /**
  * @brief Log all channels and patterns status.
  *
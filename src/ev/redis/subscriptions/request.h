@@ -24,13 +24,13 @@
 
 #include <string> // std::string
 #include <map>    // std::map
+#include <set>    // std::set
 
 #include "ev/scheduler/subscription.h"
 
 #include "ev/redis/request.h"
 #include "ev/redis/subscriptions/reply.h"
 
-#include <sstream>
 #include <algorithm> // std::replace
 
 namespace ev
@@ -86,6 +86,7 @@ namespace ev
                     std::string              command_;
                     std::vector<std::string> args_;
                     Status                   status_;
+                    size_t                   replies_; //!< Number of replies still expected, one per channel or pattern.
                     
                 public: // Constructor(s) / Destructor
                     
@@ -94,7 +95,8 @@ namespace ev
                      */
                     Context ()
                     {
-                        status_ = Status::NotSet;
+                        status_  = Status::NotSet;
+                        replies_ = 1;
                     }
                     
                     /**
@@ -110,6 +112,10 @@ namespace ev
                 typedef std::map<std::string, std::vector<Context*>*> ContextMap;
                 typedef std::map<std::string, Status>                 POCStatusMap;
                 
+            public: // Static Const Data
+                
+                static const size_t k_max_names_per_command_;
+                
             private: // Callbacks
                 
                 EV_REDIS_REPLY_CALLBACK        reply_callback_;
@@ -124,10 +130,10 @@ namespace ev
                 
                 ContextMap                     channels_;               //!< Subscribed channels.
                 ContextMap                     patterns_;               //!< Subscribed patterns.
-                std::stringstream              tmp_ss_;                 //!< Temporary string stream.
                 std::deque<Context*>           pending_;                //!< Pending commands.
                 Context*                       pending_context_ptr_;    //!< Pointer to the current request context.
                 Context*                       ping_context_;           //!< Ping request context.
+                Context*                       client_id_context_;      //!< 'CLIENT ID' request context.
                 ev::redis::Request*            request_ptr_;            //!< Pointer to the request that wil be kept alive, for subscriptions message exchange.
                 POCStatusMap                   channels_status_map_;     //!<
                 POCStatusMap                   patterns_status_map_;     //!<
@@ -163,6 +169,7 @@ namespace ev
                 bool   IsPUnsubscribedOrPending (const std::string& a_pattern);
                 
                 bool   Ping                     ();
+                bool   ClientID                 ();
                 
             private:
                 
@@ -184,6 +191,7 @@ namespace ev
                                                  ev::redis::subscriptions::Request::Context** o_context,
                                                  bool& o_release_it);
                 void   CleanUpUnsubscribed      ();
+                void   Release                  (ContextMap& a_map);
                 void   LogStatus                (const char* const a_prefix, const int a_step);
                 
                 std::string ActiveRequestPayloadForLogger () const;
@@ -0,0 +1,244 @@
+/**
+ * @file tracking_cache.cc - REDIS Tracking Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ev/redis/tracking_cache.h"
+
+#include "ev/redis/request.h"
+#include "ev/redis/reply.h"
+
+#include "ev/exception.h"
+
+#include <algorithm> // std::max
+
+const char* const                      ev::redis::TrackingCache::k_invalidate_channel_ = "__redis__:invalidate";
+
+size_t                                 ev::redis::TrackingCache::max_entries_ = 0;
+int64_t                                ev::redis::TrackingCache::ttl_ms_      = 0;
+bool                                   ev::redis::TrackingCache::enabled_     = false;
+std::mutex                             ev::redis::TrackingCache::mutex_;
+ev::redis::TrackingCache::EntriesMap   ev::redis::TrackingCache::entries_;
+ev::redis::TrackingCache::LRUList      ev::redis::TrackingCache::lru_;
+ev::redis::TrackingCache::KeysMap      ev::redis::TrackingCache::keys_;
+std::atomic<uint64_t>                  ev::redis::TrackingCache::generation_(0);
+std::atomic<long long>                 ev::redis::TrackingCache::redirect_id_(-1);
+
+/**
+ * @brief One-shot initializer.
+ *
+ * @param a_max_entries Maximum number of cached replies.
+ * @param a_ttl_ms      Entry TTL, in milliseconds, a safety net for lost invalidations.
+ *
+ * @remarks Must be called before \link ev::redis::subscriptions::Manager::Startup \link.
+ */
+void ev::redis::TrackingCache::Startup (const size_t a_max_entries, const int64_t a_ttl_ms)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( true == enabled_ ) {
+        throw ev::Exception("REDIS tracking cache already configured!");
+    }
+    
+    max_entries_ = a_max_entries;
+    ttl_ms_      = std::max(a_ttl_ms, static_cast<int64_t>(0));
+    redirect_id_ = -1;
+    enabled_     = ( max_entries_ > 0 && ttl_ms_ > 0 );
+}
+
+/**
+ * @brief Call this to dealloc previously allocated memory.
+ */
+void ev::redis::TrackingCache::Shutdown ()
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    SetRedirectID(-1);
+    enabled_ = false;
+}
+
+/**
+ * @brief Set the client id of the connection that receives invalidations.
+ *
+ * @param a_id Client id, -1 when connection was lost.
+ *
+ * @remarks All entries are dropped, devices will enable tracking again with the new id.
+ */
+void ev::redis::TrackingCache::SetRedirectID (const long long a_id)
+{
+    redirect_id_ = a_id;
+    Clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Lookup a cached reply.
+ *
+ * @param a_request
+ *
+ * @return A new result, sharing the cached reply tree, or nullptr if not cached or expired.
+ */
+ev::Result* ev::redis::TrackingCache::Get (const ev::redis::Request* a_request)
+{
+    if ( false == enabled_ || -1 == redirect_id_ ) {
+        return nullptr;
+    }
+    
+    ReplyHandle reply;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        const auto it = entries_.find(a_request->Payload());
+        if ( entries_.end() == it ) {
+            return nullptr;
+        }
+        
+        // ... expired?
+        if ( std::chrono::steady_clock::now() >= it->second.expires_at_ ) {
+            Erase(it);
+            return nullptr;
+        }
+        
+        // ... most recently used ...
+        lru_.splice(lru_.begin(), lru_, it->second.lru_it_);
+        
+        reply = it->second.reply_;
+    }
+    
+    ev::Result* result = new ev::Result(ev::Object::Target::Redis);
+    result->AttachDataObject(new ev::redis::Reply(reply));
+    
+    return result;
+}
+
+/**
+ * @brief Cache a reply.
+ *
+ * @param a_request    Cacheable request.
+ * @param a_reply      Reply tree, shared.
+ * @param a_generation Value of \link Generation \link read before command was sent.
+ *
+ * @return True if reply was cached, false otherwise.
+ */
+bool ev::redis::TrackingCache::Set (const ev::redis::Request* a_request, const ev::redis::ReplyHandle& a_reply, const uint64_t a_generation)
+{
+    // ... errors are not cached ...
+    if ( false == enabled_ || false == a_reply.Valid() || true == a_reply.IsError() ) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // ... an invalidation arrived while command was running, reply might be stale ...
+    if ( a_generation != generation_ ) {
+        return false;
+    }
+    
+    // ... replace previous entry, if any ...
+    const auto it = entries_.find(a_request->Payload());
+    if ( entries_.end() != it ) {
+        Erase(it);
+    }
+    
+    lru_.push_front(a_request->Payload());
+    entries_[a_request->Payload()] = {
+        /* reply_      */ a_reply,
+        /* key_        */ a_request->TrackedKey(),
+        /* expires_at_ */ std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms_),
+        /* lru_it_     */ lru_.begin()
+    };
+    keys_[a_request->TrackedKey()].insert(a_request->Payload());
+    
+    // ... evict least recently used entries ...
+    while ( entries_.size() > max_entries_ ) {
+        Erase(entries_.find(lru_.back()));
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Drop all entries that read a set of keys.
+ *
+ * @param a_keys Invalidation message payload, an array of keys or nil when all keys must be dropped.
+ */
+void ev::redis::TrackingCache::Invalidate (const ev::redis::Value& a_keys)
+{
+    if ( false == a_keys.IsArray() ) {
+        Clear();
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    generation_++;
+    
+    for ( size_t idx = 0 ; idx < a_keys.Size() ; ++idx ) {
+        const auto key_it = keys_.find(a_keys[static_cast<int>(idx)].String());
+        if ( keys_.end() == key_it ) {
+            continue;
+        }
+        // ... erase changes key commands ...
+        const std::set<std::string> commands = key_it->second;
+        for ( auto command : commands ) {
+            const auto it = entries_.find(command);
+            if ( entries_.end() != it ) {
+                Erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Drop all entries.
+ */
+void ev::redis::TrackingCache::Clear ()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    generation_++;
+    entries_.clear();
+    lru_.clear();
+    keys_.clear();
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Erase an entry, mutex must be locked.
+ *
+ * @param a_it
+ */
+void ev::redis::TrackingCache::Erase (ev::redis::TrackingCache::EntriesMap::iterator a_it)
+{
+    const auto key_it = keys_.find(a_it->second.key_);
+    if ( keys_.end() != key_it ) {
+        key_it->second.erase(a_it->first);
+        if ( 0 == key_it->second.size() ) {
+            keys_.erase(key_it);
+        }
+    }
+    lru_.erase(a_it->second.lru_it_);
+    entries_.erase(a_it);
+}
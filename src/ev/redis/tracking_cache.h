@@ -0,0 +1,139 @@
+/**
+ * @file tracking_cache.h - REDIS Tracking Cache
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-connectors.
+ *
+ * casper-connectors is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-connectors is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef NRS_EV_REDIS_TRACKING_CACHE_H_
+#define NRS_EV_REDIS_TRACKING_CACHE_H_
+
+#include "osal/osal_singleton.h"
+
+#include "ev/result.h"
+
+#include "ev/redis/value.h"
+#include "ev/redis/reply_handle.h"
+
+#include <string> // std::string
+#include <set>    // std::set
+#include <map>    // std::map
+#include <list>   // std::list
+#include <mutex>  // std::mutex, std::lock_guard
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::steady_clock
+
+namespace ev
+{
+    
+    namespace redis
+    {
+        
+        class Request;
+        
+        /**
+         * @brief An opt-in, size and TTL bounded, LRU cache of REDIS read replies kept coherent by server-assisted client side caching.
+         *
+         * @remarks Hub devices enable 'CLIENT TRACKING' redirected to the subscriptions connection, invalidations
+         *          are received by \link ev::redis::subscriptions::Manager \link on the main thread.
+         *          Lookups and stores are performed by the hub thread, invalidations by the main thread, entries are guarded by a mutex.
+         */
+        class TrackingCache final : public osal::Singleton<TrackingCache>
+        {
+            
+        public: // Static Const Data
+            
+            static const char* const k_invalidate_channel_;
+            
+        private: // Data Type(s)
+            
+            typedef std::list<std::string> LRUList;
+            
+            typedef struct {
+                ReplyHandle                           reply_;      //!< Shared, immutable, reply tree.
+                std::string                           key_;        //!< REDIS key read by the command.
+                std::chrono::steady_clock::time_point expires_at_; //!< When this entry is no longer valid.
+                LRUList::iterator                     lru_it_;     //!< Position in LRU list.
+            } Slot;
+            
+            typedef std::map<std::string, Slot>                  EntriesMap;
+            typedef std::map<std::string, std::set<std::string>> KeysMap;
+            
+        private: // Static Data
+            
+            static size_t                 max_entries_;
+            static int64_t                ttl_ms_;
+            static bool                   enabled_;
+            static std::mutex             mutex_;
+            static EntriesMap             entries_;
+            static LRUList                lru_;
+            static KeysMap                keys_;
+            static std::atomic<uint64_t>  generation_;
+            static std::atomic<long long> redirect_id_;
+            
+        public: // Method(s) / Function(s)
+            
+            void Startup  (const size_t a_max_entries, const int64_t a_ttl_ms);
+            void Shutdown ();
+            
+        public: // Method(s) / Function(s)
+            
+            bool        Enabled       () const;
+            uint64_t    Generation    () const;
+            long long   RedirectID    () const;
+            void        SetRedirectID (const long long a_id);
+            
+            ev::Result* Get           (const Request* a_request);
+            bool        Set           (const Request* a_request, const ReplyHandle& a_reply, const uint64_t a_generation);
+            void        Invalidate    (const Value& a_keys);
+            void        Clear         ();
+            
+        private: // Method(s) / Function(s)
+            
+            void Erase (EntriesMap::iterator a_it);
+            
+        }; // end of class 'TrackingCache'
+        
+        /**
+         * @return True if cache was started, false otherwise.
+         */
+        inline bool TrackingCache::Enabled () const
+        {
+            return enabled_;
+        }
+        
+        /**
+         * @return Invalidations counter, it must be read before a command is sent and passed to \link Set \link.
+         */
+        inline uint64_t TrackingCache::Generation () const
+        {
+            return generation_;
+        }
+        
+        /**
+         * @return Client id of the connection that receives invalidations, -1 if not known yet.
+         */
+        inline long long TrackingCache::RedirectID () const
+        {
+            return redirect_id_;
+        }
+        
+    } // end of namespace 'redis'
+    
+} // end of namespace 'ev'
+
+#endif // NRS_EV_REDIS_TRACKING_CACHE_H_
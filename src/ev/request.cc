@@ -51,3 +51,29 @@ ev::Request::~Request ()
         delete result_;
     }
 }
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Build the request that must be issued if the requester is released while a device is still pinned to it.
+ *
+ * @return A new request, ownership is moved to the caller, or nullptr if none is required.
+ *
+ * @remarks It should use \link Control::Abort \link, so it's dropped if the device is no longer pinned.
+ */
+ev::Request* ev::Request::AbortRequest () const
+{
+    return nullptr;
+}
+
+/**
+ * @brief Look up a locally cached result for this request, it's checked by the hub before a device is picked.
+ *
+ * @return A new result, ownership is moved to the caller, or nullptr if none is cached.
+ */
+ev::Result* ev::Request::CachedResult () const
+{
+    return nullptr;
+}
@@ -50,7 +50,10 @@ namespace ev
         enum class Control : uint8_t
         {
             NotSet,
-            Invalidate
+            Invalidate,
+            Pin,       //!< Execute on the device pinned to the same invoke id, if any, and keep it pinned after execution.
+            Unpin,     //!< Execute on the device pinned to the same invoke id, if any, and return it to the pool after execution.
+            Abort      //!< Execute only on the device pinned to the same invoke id and return it to the pool after execution, dropped if no device is pinned.
         };
         
     public:
@@ -90,6 +93,11 @@ namespace ev
         void SetTimeout      (const long a_ms, std::function<void()> a_callback);
         bool CheckForTimeout (const std::chrono::steady_clock::time_point& a_time_point) const;
 
+    public: // Virtual Method(s) / Function(s)
+        
+        virtual Request* AbortRequest () const;
+        virtual Result*  CachedResult () const;
+
     };
     
     /**
@@ -44,12 +44,18 @@ ev::Bridge*   ev::scheduler::Scheduler::bridge_ptr_ = nullptr;
  * @param a_initialized_callback
  * @param a_device_factory
  * @param a_device_limits
+ * @param a_device_lease   Optional, see \link ev::hub::Hub::Start \link.
+ * @param a_device_release Optional, see \link ev::hub::Hub::Start \link.
+ * @param a_device_lifetime Optional, see \link ev::hub::Hub::Start \link.
  */
 void ev::scheduler::Scheduler::Scheduler::Start (const std::string& a_socket_fn,
                                                  ev::Bridge& a_bridge,
                                                  ev::scheduler::Scheduler::InitializedCallback a_initialized_callback,
                                                  ev::scheduler::Scheduler::DeviceFactoryCallback a_device_factory,
-                                                 ev::scheduler::Scheduler::DeviceLimitsCallback a_device_limits)
+                                                 ev::scheduler::Scheduler::DeviceLimitsCallback a_device_limits,
+                                                 ev::scheduler::Scheduler::DeviceLeaseCallback a_device_lease,
+                                                 ev::scheduler::Scheduler::DeviceReleaseCallback a_device_release,
+                                                 ev::scheduler::Scheduler::DeviceLifetimeCallback a_device_lifetime)
 {
 
     OSALITE_DEBUG_TRACE("ev_scheduler", "~> Start(...)");
@@ -158,7 +164,21 @@ void ev::scheduler::Scheduler::Scheduler::Start (const std::string& a_socket_fn,
                     }
                     
                     const ev::scheduler::Object::Type type = static_cast<ev::scheduler::Object::Type>(a_tag);
-                    if ( ev::scheduler::Object::Type::Subscription != type ) {
+                    if ( ev::scheduler::Object::Type::Task == type ) {
+                        // ... partial results of a task request ...
+                        ev::scheduler::Task* task_object = dynamic_cast<ev::scheduler::Task*>(ids_to_object_map_it->second);
+                        if ( nullptr == task_object ) {
+                            throw ev::Exception("Logic error: expecting task object!");
+                        }
+                        // ... unless it was 'detached' ...
+                        const auto detached_it = std::find_if(detached_.begin(), detached_.end(), [task_object](const ev::scheduler::Object* a_s_object) {
+                            return ( a_s_object == task_object );
+                        });
+                        if ( detached_.end() == detached_it ) {
+                            task_object->Publish(a_results);
+                        }
+                        return;
+                    } else if ( ev::scheduler::Object::Type::Subscription != type ) {
                         return;
                     }
                     
@@ -191,7 +211,10 @@ void ev::scheduler::Scheduler::Scheduler::Start (const std::string& a_socket_fn,
                     }
                 },
                 a_device_factory,
-                a_device_limits
+                a_device_limits,
+                a_device_lease,
+                a_device_release,
+                a_device_lifetime
     );
     
     OSALITE_DEBUG_TRACE("ev_scheduler", "<~ Start(...)");
@@ -365,6 +388,8 @@ void ev::scheduler::Scheduler::KillZombies ()
  */
 void ev::scheduler::Scheduler::ReleaseObject (ev::scheduler::Object* a_object)
 {
+    // ... release any device still pinned to it ...
+    Abort(a_object);
     // ... first check if this object is a 'zombie'
     for ( auto it = zombies_.begin(); zombies_.end() != it ; ++it ) {
         if ( a_object == (*it) ) {
@@ -413,3 +438,32 @@ void ev::scheduler::Scheduler::ReleaseObject (ev::scheduler::Object* a_object)
         delete a_object;
     }
 }
+
+/**
+ * @brief Issue the abort request of a task that is being released while a device is still pinned to it.
+ *
+ * @param a_object
+ *
+ * @remarks The reply is discarded, since the object will no longer be known by it's id.
+ *          If it can't be issued, the pinned device will expire and server will rollback when it's disconnected.
+ *          If the pin was already dropped by the hub, the abort request is dropped too, see \link ev::Request::Control::Abort \link.
+ */
+void ev::scheduler::Scheduler::Abort (ev::scheduler::Object* a_object)
+{
+    if ( ev::scheduler::Object::Type::Task != a_object->type_ ) {
+        return;
+    }
+    
+    ev::Request* request = static_cast<ev::scheduler::Task*>(a_object)->DetachAbortRequest();
+    if ( nullptr == request ) {
+        return;
+    }
+    
+    (void)std::atomic_fetch_add(&pending_callbacks_count_, 1);
+    // <invoke_id>:<mode>:<target>:<tag>:<obj_addr>
+    if ( false == socket_.Send(ev::hub::Hub::k_msg_with_payload_format_,
+                               a_object->UniqueID(), request->mode_, request->target_, a_object->type_, request) ) {
+        (void)std::atomic_fetch_sub(&pending_callbacks_count_, 1);
+        delete request;
+    }
+}
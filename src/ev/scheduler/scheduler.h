@@ -60,11 +60,14 @@ namespace ev
                 }
             };
             
-            typedef hub::Hub::InitializedCallback  InitializedCallback;
-            typedef hub::DeviceFactoryStepCallback DeviceFactoryCallback;
-            typedef hub::DeviceLimitsStepCallback  DeviceLimitsCallback;
-            typedef InitializedCallback            FinalizationCallback;
-            typedef std::function<void()>          TimeoutCallback;
+            typedef hub::Hub::InitializedCallback   InitializedCallback;
+            typedef hub::DeviceFactoryStepCallback  DeviceFactoryCallback;
+            typedef hub::DeviceLimitsStepCallback   DeviceLimitsCallback;
+            typedef hub::DeviceLeaseStepCallback    DeviceLeaseCallback;
+            typedef hub::DeviceReleaseStepCallback  DeviceReleaseCallback;
+            typedef hub::DeviceLifetimeStepCallback DeviceLifetimeCallback;
+            typedef InitializedCallback             FinalizationCallback;
+            typedef std::function<void()>           TimeoutCallback;
 
             
         protected: // Data Type(s)
@@ -95,7 +98,9 @@ namespace ev
         public: // Method(s) / Function(s)
             
             void Start      (const std::string& a_socket_fn,
-                             ev::Bridge& a_bridge, InitializedCallback a_initialized_callback, DeviceFactoryCallback a_device_factory, DeviceLimitsCallback a_device_limits);
+                             ev::Bridge& a_bridge, InitializedCallback a_initialized_callback, DeviceFactoryCallback a_device_factory, DeviceLimitsCallback a_device_limits,
+                             DeviceLeaseCallback a_device_lease = nullptr, DeviceReleaseCallback a_device_release = nullptr,
+                             DeviceLifetimeCallback a_device_lifetime = nullptr);
             void Stop       (FinalizationCallback a_finalization_callback,
                              int a_sig_no);
             void Push       (Client* a_client, scheduler::Object* a_task);
@@ -113,6 +118,7 @@ namespace ev
             
             void KillZombies    ();
             void ReleaseObject  (scheduler::Object* a_object);
+            void Abort          (scheduler::Object* a_object);
             
         }; // end of class 'Scheduler'
         
@@ -39,8 +39,10 @@ ev::scheduler::Task::Task (const EV_TASK_PARAMS& a_callback, const EV_TASK_COMMI
     first_               = a_callback;
     commit_callback_     = a_commit_callback;
     catch_callback_      = nullptr;
+    stream_callback_     = nullptr;
     step_                = -1;
     previous_result_     = nullptr;
+    abort_request_       = nullptr;
 }
 
 /**
@@ -51,11 +53,15 @@ ev::scheduler::Task::~Task ()
     first_           = nullptr;
     commit_callback_ = nullptr;
     catch_callback_  = nullptr;
+    stream_callback_ = nullptr;
     last_            = nullptr;
     sequences_.clear();
     if ( nullptr != previous_result_ ) {
         delete previous_result_;
     }
+    if ( nullptr != abort_request_ ) {
+        delete abort_request_;
+    }
 }
 
 #ifdef __APPLE__
@@ -133,6 +139,15 @@ bool ev::scheduler::Task::Step (ev::Object* a_object, ev::Request** o_request)
     // ... next is a new request?
     if ( nullptr != next && ev::Object::Type::Request == next->type_ ) {
         (*o_request) = static_cast<ev::Request*>(next);
+        // ... track device pinning, to release it if this task is released before unpinning it ...
+        if ( ev::Request::Control::Pin == (*o_request)->control_ ) {
+            if ( nullptr == abort_request_ ) {
+                abort_request_ = (*o_request)->AbortRequest();
+            }
+        } else if ( ev::Request::Control::Unpin == (*o_request)->control_ && nullptr != abort_request_ ) {
+            delete abort_request_;
+            abort_request_ = nullptr;
+        }
         return ( nullptr == (*o_request) );
     }
     
@@ -188,6 +203,17 @@ ev::scheduler::Task* ev::scheduler::Task::Then (const EV_TASK_CALLBACK& a_callba
     return this;
 }
 
+/**
+ * @brief Set a callback for partial results ( e.g. batches of rows of a \link ev::postgresql::StreamRequest \link ).
+ *
+ * @param a_callback Called, in order, for each partial result of the running request, before it's next step.
+ */
+ev::scheduler::Task* ev::scheduler::Task::Stream (const EV_TASK_STREAM_CALLBACK& a_callback)
+{
+    stream_callback_ = a_callback;
+    return this;
+}
+
 /**
  * @brief Set final callbackk
  *
@@ -232,3 +258,45 @@ void ev::scheduler::Task::Catch (const EV_TASK_CATCH_CALLBACK &a_callback)
         }
     }
 }
+
+/**
+ * @brief Deliver partial results of the running request.
+ *
+ * @param a_results Results ownership is NOT moved to this object.
+ *
+ * @remarks If stream callback throws an exception, remaining partial results will be ignored.
+ */
+void ev::scheduler::Task::Publish (std::vector<ev::Result*>& a_results)
+{
+    OSALITE_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
+    
+    if ( nullptr == stream_callback_ ) {
+        return;
+    }
+    
+    const auto report_exception = [this] (const ev::Exception& a_ev_exception) {
+        stream_callback_ = nullptr;
+        if ( nullptr != catch_callback_ ) {
+            catch_callback_(a_ev_exception);
+        }
+    };
+    
+    try {
+        for ( auto result : a_results ) {
+            stream_callback_(result);
+        }
+    } catch (const ev::Exception& a_ev_exception) {
+        report_exception(a_ev_exception);
+    } catch (const std::bad_alloc& a_bad_alloc) {
+        OSALITE_BACKTRACE();
+        report_exception(ev::Exception("C++ Bad Alloc: %s\n", a_bad_alloc.what()));
+    } catch (const std::runtime_error& a_rte) {
+        OSALITE_BACKTRACE();
+        report_exception(ev::Exception("C++ Runtime Error: %s\n", a_rte.what()));
+    } catch (const std::exception& a_std_exception) {
+        report_exception(ev::Exception("C++ Standard Exception: %s\n", a_std_exception.what()));
+    } catch (...) {
+        OSALITE_BACKTRACE();
+        report_exception(ev::Exception(STD_CPP_GENERIC_EXCEPTION_TRACE()));
+    }
+}
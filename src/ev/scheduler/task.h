@@ -62,6 +62,10 @@ namespace ev
 #define EV_TASK_COMMIT_CALLBACK std::function<void(::ev::scheduler::Task* a_task)>
 #endif
             
+#ifndef EV_TASK_STREAM_CALLBACK
+#define EV_TASK_STREAM_CALLBACK std::function<void(const ::ev::Object* a_object)>
+#endif
+            
 #ifndef EV_TASK_STEP_CALLBACK
 #define EV_TASK_STEP_CALLBACK std::function<void(const ::ev::Object* a_object, bool a_completed)>
 #endif
@@ -73,8 +77,10 @@ namespace ev
             std::vector<EV_TASK_CALLBACK> sequences_;       //!< Intermediary callbacks.
             EV_TASK_CATCH_CALLBACK        catch_callback_;  //!< Function to call when an \link ev::Exception \link was caught!
             EV_TASK_COMMIT_CALLBACK       commit_callback_; //!< Mandatory callback, to finalize task setup.
+            EV_TASK_STREAM_CALLBACK       stream_callback_; //!< Optional callback, for partial results of the running request.
             ssize_t                       step_;            //!< Current task step.
             ev::Result*                   previous_result_; //!< The previously collected result, nullptr if none.
+            ev::Request*                  abort_request_;   //!< Request to issue if released while a device is pinned to this task, nullptr if none.
             
         public: // Constructor(s) / Destructor
             
@@ -89,10 +95,28 @@ namespace ev
         public: // Method(s) / Function(s)
             
             Task* Then    (const EV_TASK_CALLBACK& a_callback);
+            Task* Stream  (const EV_TASK_STREAM_CALLBACK& a_callback);
             Task* Finally (const EV_TASK_FINALLY_CALLBACK& a_callback);
             void  Catch   (const EV_TASK_CATCH_CALLBACK& a_callback);
+            void  Publish (std::vector<ev::Result*>& a_results);
+            
+        public: // Inline Method(s) / Function(s)
+            
+            ev::Request* DetachAbortRequest ();
             
         }; // end of class 'Task'
+        
+        /**
+         * @brief Detach the request that must be issued to release a device still pinned to this task, if any.
+         *
+         * @return The request, ownership is moved to the caller, or nullptr if none.
+         */
+        inline ev::Request* Task::DetachAbortRequest ()
+        {
+            ev::Request* request = abort_request_;
+            abort_request_ = nullptr;
+            return request;
+        }
 
     } // end of namespace 'scheduler'
     